@@ -1,13 +1,40 @@
 #include "UIComboBox.h"
+#include <new>
+#include <math.h>
 
 // Constantes pour le style et la clarté du code
 namespace {
     constexpr int TEXT_PADDING_X = 10;
+    constexpr int MAX_TRACKED_ROWS = 32; // Nombre de lignes suivies individuellement par le masque _dirtyRows
+    constexpr int BLIT_STRIP_LINES = 8; // Nombre de lignes de pixels copiées par transfert lors d'un défilement par copie
+    constexpr size_t ITEM_TEXT_BUFFER_SIZE = 128; // Taille du tampon recevant le texte affiché d'un élément (caractère nul compris)
+    constexpr int DRAG_START_THRESHOLD = 8; // Déplacement vertical (pixels) à partir duquel un appui devient un glissement
+    constexpr float FRAME_MS = 16.0f; // Durée de référence d'une image pour l'amortissement de l'inertie
+    constexpr unsigned long MAX_STEP_MS = 50; // Pas de temps maximal intégré en une mise à jour (évite les sauts après une pause)
+    constexpr float VELOCITY_SMOOTHING = 0.6f; // Poids de la vitesse précédente dans la moyenne glissante
+    constexpr float FLING_MIN_VELOCITY = 0.3f; // Vitesse minimale (pixels/ms) au relâchement pour lancer l'inertie
+    constexpr float FLING_STOP_VELOCITY = 0.02f; // Vitesse (pixels/ms) en dessous de laquelle l'inertie s'arrête
+    constexpr float FLING_DECAY_PER_FRAME = 0.95f; // Facteur de conservation de la vitesse par image de 16 ms
+
+    // Retire de la fin d'un texte tronqué un caractère UTF-8 dont il manque des octets.
+    size_t trimIncompleteUtf8(char* text, size_t length) {
+        size_t lead = length;
+        while (lead > 0 && length - lead < 3 && ((uint8_t)text[lead - 1] & 0xC0) == 0x80) lead--;
+        if (lead == 0) return length;
+        uint8_t first = (uint8_t)text[--lead];
+        size_t expected = first >= 0xF0 ? 4 : first >= 0xE0 ? 3 : first >= 0xC0 ? 2 : 1;
+        if (length - lead < expected) {
+            length = lead;
+            text[length] = '\0';
+        }
+        return length;
+    }
 }
 
 UIComboBox::UIComboBox(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String& labelText, const UIComboBoxStyle& style)
     : UITextComponent(u8f, rect, labelText), // Call base constructor
-      _style(style), _collapsedHeight(rect.h),
+      _ownedStyle(new UIComboBoxStyle(style)),
+      _style(_ownedStyle.get()), _collapsedHeight(rect.h),
       _maxVisibleItems(style.maxVisibleItems),
       _scrollBarWidth(style.scrollBarWidth),
       _scrollBarColor(style.scrollBarColor)
@@ -15,28 +42,311 @@ UIComboBox::UIComboBox(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String&
     // No need to create a UILabel anymore
 }
 
+UIComboBox::UIComboBox(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String& labelText, const UIComboBoxStyle* sharedStyle)
+    : UITextComponent(u8f, rect, labelText),
+      _style(sharedStyle), _collapsedHeight(rect.h),
+      _maxVisibleItems(sharedStyle->maxVisibleItems),
+      _scrollBarWidth(sharedStyle->scrollBarWidth),
+      _scrollBarColor(sharedStyle->scrollBarColor)
+{
+}
+
 void UIComboBox::addItem(const String& text, int value) {
-    _items.push_back({text, value});
-    if (_selectedIndex == -1 && !_items.empty()) {
+    _items.add(text.c_str(), text.length(), value);
+    itemsAppended(1);
+}
+
+void UIComboBox::addItem(const char* text, int value) {
+    _items.add(itemTextData(text), itemTextLength(text), value);
+    itemsAppended(1);
+}
+
+void UIComboBox::reserveItems(size_t itemCount, size_t textBytes) {
+    _items.reserve(itemCount, textBytes);
+}
+
+void UIComboBox::addItems(std::initializer_list<UIComboBoxItem> items) {
+    addItems(items.begin(), items.end());
+}
+
+void UIComboBox::addItems(std::vector<UIComboBoxItem>&& items) {
+    addItems(items.begin(), items.end());
+    // Les textes sont désormais dans l'arène : les String d'origine sont libérées immédiatement.
+    std::vector<UIComboBoxItem>().swap(items);
+}
+
+size_t UIComboBox::getItemsMemoryUsage() const {
+    return _items.memoryUsage();
+}
+
+void UIComboBox::itemsAppended(size_t count) {
+    if (_provider != &_items || count == 0) return; // La liste interne n'est pas affichée
+    if (count == 1) {
+        // Un ajout isolé est une insertion en fin de liste : seules les lignes concernées sont redessinées.
+        itemInserted(itemCount() - 1);
+        return;
+    }
+    ViewAnchor anchor = viewAnchor();
+    if (_sortIndex.isActive()) {
+        _sortIndex.itemsAppended(*_provider);
+    }
+    itemListChanged();
+    if (_isExpanded) {
+        // La hauteur et la barre de défilement de la liste peuvent changer.
+        restoreViewAnchor(anchor);
+        updateHeight();
+        invalidate(DIRTY_FULL);
+    }
+    if (_selectedIndex == -1 && itemCount() > 0) {
+        _selectedIndex = 0;
+        invalidate(DIRTY_HEADER_TEXT);
+    }
+}
+
+void UIComboBox::insertItem(int index, const String& text, int value) {
+    index = std::max(0, std::min(index, (int)_items.size()));
+    _items.insert(index, text.c_str(), text.length(), value);
+    if (_provider != &_items) return; // La liste interne n'est pas affichée
+    itemInserted(index);
+}
+
+void UIComboBox::itemInserted(int index) {
+    // L'ordre de tri ne contient pas encore l'élément : il décrit la vue d'avant l'insertion.
+    int previousRows = _sortIndex.isActive() ? (int)_sortIndex.rowCount() : itemCount() - 1;
+    int previousVisibleCount = std::min(previousRows, _maxVisibleItems);
+    bool hadScrollBar = previousRows > _maxVisibleItems;
+
+    if (_selectedIndex == -1) {
         _selectedIndex = 0;
+        invalidate(DIRTY_HEADER_TEXT);
+    } else if (_selectedIndex >= index) {
+        _selectedIndex++; // Même élément, nouvelle position : pas de rappel
+    }
+    if (_sortIndex.isActive()) {
+        _sortIndex.itemInserted(*_provider, index);
+    }
+    // Pendant le filtrage, l'index est mis à jour plutôt que retrié à chaque modification.
+    if (_filterActive) {
+        _prefixIndex.itemInserted(*_provider, index);
+    }
+    itemListChanged(_filterActive);
+
+    if (!_isExpanded) return;
+    if (_filterActive || previousVisibleCount != std::min(listRowCount(), _maxVisibleItems) || hadScrollBar != hasScrollBar()) {
+        // La géométrie ou l'ordre de la vue change : la liste est redessinée entièrement.
+        updateHeight();
+        invalidate(DIRTY_FULL);
+        return;
+    }
+    // Dans une liste triée, l'élément peut ouvrir une section (en-tête juste au-dessus de lui)
+    // ou en couper une en deux (en-tête de la suite juste en dessous).
+    int position = viewPosition(index);
+    int addedRows = listRowCount() - previousRows;
+    int firstAdded = addedRows > 1 ? position - 1 : position;
+    int lastAdded = addedRows > 2 ? position + 1 : position;
+    if (lastAdded < _scrollOffset) {
+        // Insertion au-dessus de la vue : on décale la vue pour garder les mêmes lignes à l'écran.
+        _scrollOffset += addedRows;
+        _drawnScrollOffset += addedRows;
+        invalidate(DIRTY_SCROLLBAR);
+    } else {
+        invalidateRowsFrom(firstAdded);
+        invalidate(DIRTY_SCROLLBAR);
+    }
+}
+
+bool UIComboBox::removeItem(int index) {
+    if (index < 0 || index >= (int)_items.size()) return false;
+    if (_provider != &_items) {
+        _items.remove(index); // La liste interne n'est pas affichée
+        return true;
     }
-    setDirty(true); // La liste a changé, il faut redessiner.
+
+    // La ligne de l'élément dans la vue complète est relevée tant qu'il figure encore dans la liste.
+    int position = _sortIndex.isActive() ? (int)_sortIndex.rowOf(*_provider, index) : index;
+    _items.remove(index);
+    itemRemoved(index, position);
+    return true;
+}
+
+void UIComboBox::itemRemoved(int index, int position) {
+    // L'ordre de tri contient encore l'élément : il décrit la vue d'avant la suppression.
+    int previousRows = _sortIndex.isActive() ? (int)_sortIndex.rowCount() : itemCount() + 1;
+    int previousVisibleCount = std::min(previousRows, _maxVisibleItems);
+    bool hadScrollBar = previousRows > _maxVisibleItems;
+    if (_sortIndex.isActive()) {
+        _sortIndex.itemRemoved(*_provider, index);
+    }
+
+    bool selectionChanged = false;
+    if (_selectedIndex > index) {
+        _selectedIndex--; // Même élément, nouvelle position : pas de rappel
+    } else if (_selectedIndex == index) {
+        // L'élément sélectionné disparaît : la sélection passe à l'élément affiché à sa suite (ou au dernier).
+        _selectedIndex = itemNearRow(position);
+        selectionChanged = true;
+        invalidate(DIRTY_HEADER_TEXT);
+    }
+    if (_filterActive) {
+        _prefixIndex.itemRemoved(index);
+    }
+    itemListChanged(_filterActive);
+
+    if (_isExpanded) {
+        int maxScrollOffset = std::max(0, viewCount() - _maxVisibleItems);
+        // Dans une liste triée, l'en-tête d'une section vidée disparaît avec l'élément, ainsi que celui
+        // de la section suivante si elle rejoint la précédente.
+        int removedRows = previousRows - listRowCount();
+        int firstRemoved = removedRows > 1 ? position - 1 : position;
+        int lastRemoved = removedRows > 2 ? position + 1 : position;
+        if (_filterActive || previousVisibleCount != std::min(listRowCount(), _maxVisibleItems) || hadScrollBar != hasScrollBar()) {
+            if (_scrollOffset >= maxScrollOffset) {
+                _scrollOffset = maxScrollOffset;
+                _scrollPixel = 0;
+            }
+            updateHeight();
+            invalidate(DIRTY_FULL);
+        } else if (lastRemoved < _scrollOffset) {
+            _scrollOffset -= removedRows;
+            _drawnScrollOffset -= removedRows;
+            invalidate(DIRTY_SCROLLBAR);
+        } else if (_scrollOffset > maxScrollOffset) {
+            // Suppression en fin de liste : la vue recule jusqu'à la dernière position possible.
+            _scrollOffset = maxScrollOffset;
+            _scrollPixel = 0;
+            invalidate(DIRTY_SCROLL | DIRTY_SCROLLBAR);
+            invalidateRowsFrom(firstRemoved);
+        } else {
+            invalidateRowsFrom(firstRemoved);
+            invalidate(DIRTY_SCROLLBAR);
+        }
+    }
+
+    if (selectionChanged && _onSelectCallback) {
+        _onSelectCallback(_selectedIndex, getSelectedValue());
+    }
+}
+
+bool UIComboBox::updateItem(int index, const String& text, int value) {
+    if (index < 0 || index >= (int)_items.size()) return false;
+    _items.update(index, text.c_str(), text.length(), value);
+    if (_provider != &_items) return true; // La liste interne n'est pas affichée
+    itemUpdated(index);
+    return true;
+}
+
+void UIComboBox::itemUpdated(int index) {
+    if (_filterActive) {
+        // Le nouveau texte peut faire entrer ou sortir l'élément de la vue filtrée ; la vue complète,
+        // rétablie à la fin du filtrage, reste triée.
+        if (_sortIndex.isActive()) {
+            _sortIndex.itemUpdated(*_provider, index);
+        }
+        _prefixIndex.itemUpdated(*_provider, index);
+        itemListChanged(true);
+        invalidate(DIRTY_LIST);
+    } else if (_sortIndex.isActive()) {
+        // L'élément peut changer de rang, et ouvrir ou refermer une section.
+        int previousRows = listRowCount();
+        _sortIndex.itemUpdated(*_provider, index);
+        itemListChanged();
+        int maxScrollOffset = std::max(0, viewCount() - _maxVisibleItems);
+        if (_scrollOffset > maxScrollOffset) {
+            _scrollOffset = maxScrollOffset;
+            _scrollPixel = 0;
+        }
+        if (std::min(previousRows, _maxVisibleItems) != std::min(listRowCount(), _maxVisibleItems)) {
+            updateHeight();
+            invalidate(DIRTY_FULL);
+        } else {
+            invalidate(DIRTY_LIST);
+        }
+    } else {
+        _valueIndexValid = false;
+        if (_prefixIndex.isBuilt()) {
+            _prefixIndex.clear();
+        }
+        invalidateItem(index);
+    }
+    if (index == _selectedIndex) {
+        invalidate(DIRTY_HEADER_TEXT);
+    }
+}
+
+void UIComboBox::clear() {
+    _items.clear();
+    if (_provider != &_items) return; // La liste interne n'est pas affichée
+    itemsCleared();
+}
+
+void UIComboBox::itemsCleared() {
+    bool hadSelection = _selectedIndex >= 0;
+    if (_sortIndex.isActive()) {
+        _sortIndex.build(*_provider); // Vide l'ordre en conservant sa capacité pour les prochains ajouts
+    }
+    itemListChanged();
+    _selectedIndex = -1;
+    _scrollOffset = 0;
+    _scrollPixel = 0;
+    if (_textCache) {
+        _textCache->clear();
+    }
+    updateHeight();
+    invalidate(DIRTY_FULL);
+    if (hadSelection && _onSelectCallback) {
+        _onSelectCallback(-1, -1);
+    }
+}
+
+int UIComboBox::indexOfValue(int value) const {
+    if (!_valueIndexValid) {
+        // Reconstruction paresseuse après une modification : O(n) une fois, puis O(1) par recherche.
+        _valueIndex.clear();
+        int count = itemCount();
+        _valueIndex.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            _valueIndex.emplace(_provider->getItemValue(i), i); // La première occurrence l'emporte
+        }
+        _valueIndexValid = true;
+    }
+    auto it = _valueIndex.find(value);
+    return it != _valueIndex.end() ? it->second : -1;
+}
+
+bool UIComboBox::setSelectedValue(int value) {
+    int index = indexOfValue(value);
+    if (index < 0) return false;
+    setSelectedIndex(index);
+    return true;
 }
 
 void UIComboBox::setSelectedIndex(int index) {
-    if (index >= 0 && (size_t)index < _items.size()) {
+    if (index >= 0 && index < itemCount()) {
         if (_selectedIndex != index) {
+            int previousIndex = _selectedIndex;
+            int previousScrollPosition = scrollPosition();
             _selectedIndex = index;
-            // Ajuster le scrollOffset pour que l'élément sélectionné soit visible
-            if (_selectedIndex < _scrollOffset) {
-                _scrollOffset = _selectedIndex;
-            } else if (_selectedIndex >= _scrollOffset + _maxVisibleItems) {
-                _scrollOffset = _selectedIndex - _maxVisibleItems + 1;
+            // Ajuster le scrollOffset pour que l'élément sélectionné soit entièrement visible
+            int position = viewPosition(_selectedIndex);
+            if (position < 0) {
+                // Élément masqué par le filtre : le défilement est inchangé.
+            } else if (position < _scrollOffset || (position == _scrollOffset && _scrollPixel > 0)) {
+                _scrollOffset = position;
+                _scrollPixel = 0;
+            } else if (position >= _scrollOffset + _maxVisibleItems) {
+                _scrollOffset = position - _maxVisibleItems + 1;
+                _scrollPixel = 0;
             }
             if (_onSelectCallback) {
                 _onSelectCallback(_selectedIndex, getSelectedValue());
             }
-            setDirty(true);
+            invalidate(DIRTY_HEADER_TEXT);
+            if (scrollPosition() != previousScrollPosition) {
+                invalidate(DIRTY_SCROLL | DIRTY_SCROLLBAR);
+            }
+            // L'ancienne et la nouvelle ligne en surbrillance changent.
+            invalidateItem(previousIndex);
+            invalidateItem(_selectedIndex);
         }
     }
 }
@@ -46,19 +356,224 @@ int UIComboBox::getSelectedIndex() const {
 }
 
 int UIComboBox::getSelectedValue() const {
-    if (_selectedIndex >= 0 && (size_t)_selectedIndex < _items.size()) {
-        return _items[_selectedIndex].value;
+    if (_selectedIndex >= 0 && _selectedIndex < itemCount()) {
+        return _provider->getItemValue(_selectedIndex);
     }
     return -1;
 }
 
 String UIComboBox::getSelectedText() const {
-    if (_selectedIndex >= 0 && (size_t)_selectedIndex < _items.size()) {
-        return _items[_selectedIndex].text;
+    if (_selectedIndex >= 0 && _selectedIndex < itemCount()) {
+        // Le texte est retourné en entier : seul un texte plus long que le tampon d'affichage est alloué.
+        size_t length = _provider->getItemTextLength(_selectedIndex);
+        if (length < ITEM_TEXT_BUFFER_SIZE) {
+            char text[ITEM_TEXT_BUFFER_SIZE];
+            _provider->getItemText(_selectedIndex, text, sizeof(text));
+            return String(text);
+        }
+        std::unique_ptr<char[]> text(new char[length + 1]);
+        _provider->getItemText(_selectedIndex, text.get(), length + 1);
+        return String(text.get());
     }
     return F("No selection"); // Utiliser F() pour stocker la chaîne en Flash
 }
 
+void UIComboBox::setItemProvider(UIComboBoxItemProvider* provider) {
+    _provider = provider ? provider : &_items;
+    _selectedIndex = itemCount() > 0 ? 0 : -1;
+    _scrollOffset = 0;
+    _scrollPixel = 0;
+    notifyItemsChanged();
+}
+
+void UIComboBox::notifyItemsChanged() {
+    int count = itemCount();
+    if (_selectedIndex >= count) {
+        _selectedIndex = count - 1;
+    } else if (_selectedIndex < 0 && count > 0) {
+        _selectedIndex = 0;
+    }
+    if (_sortIndex.isActive()) {
+        _sortIndex.build(*_provider);
+    }
+    itemListChanged();
+    int maxScrollOffset = std::max(0, viewCount() - _maxVisibleItems);
+    _scrollOffset = std::min(_scrollOffset, maxScrollOffset);
+    _scrollPixel = 0;
+    if (_textCache) {
+        _textCache->clear();
+    }
+    updateHeight();
+    invalidate(DIRTY_FULL);
+}
+
+void UIComboBox::setSortOrder(SortKey key, bool descending) {
+    ViewAnchor anchor = viewAnchor();
+    int previousRows = listRowCount();
+    _sortIndex.setSortKey(key, descending);
+    resort(anchor, previousRows);
+}
+
+void UIComboBox::setSortComparator(SortComparator comparator, bool descending) {
+    ViewAnchor anchor = viewAnchor();
+    int previousRows = listRowCount();
+    _sortIndex.setSortKey(comparator ? UIComboBoxSortIndex::SORT_CUSTOM : UIComboBoxSortIndex::SORT_NONE, descending, comparator);
+    resort(anchor, previousRows);
+}
+
+void UIComboBox::setSectionHeaders(bool enable, SectionLabel label) {
+    ViewAnchor anchor = viewAnchor();
+    int previousRows = listRowCount();
+    _sortIndex.setSections(enable, label);
+    resort(anchor, previousRows);
+}
+
+void UIComboBox::resort(const ViewAnchor& anchor, int previousRows) {
+    _sortIndex.build(*_provider);
+    restoreViewAnchor(anchor);
+    if (!_isExpanded) return;
+    // Les index des éléments ne changent pas : la sélection et les libellés mis en cache restent valides.
+    if (std::min(previousRows, _maxVisibleItems) != std::min(listRowCount(), _maxVisibleItems)) {
+        updateHeight();
+        invalidate(DIRTY_FULL);
+    } else {
+        invalidate(DIRTY_LIST);
+    }
+}
+
+UIComboBox::ViewAnchor UIComboBox::viewAnchor() const {
+    ViewAnchor anchor = {-1, 0};
+    if (!_isExpanded || _filterActive) return anchor; // La vue filtrée ne dépend pas du tri
+    int position = viewPosition(_selectedIndex);
+    if (position < _scrollOffset || position >= _scrollOffset + _maxVisibleItems) {
+        // Sélection hors de la vue : le repère est le premier élément affiché.
+        position = _scrollOffset;
+        while (position < viewCount() && viewItem(position) < 0) {
+            position++;
+        }
+        if (position >= viewCount()) return anchor;
+    }
+    anchor.itemIndex = viewItem(position);
+    anchor.slot = position - _scrollOffset;
+    return anchor;
+}
+
+void UIComboBox::restoreViewAnchor(const ViewAnchor& anchor) {
+    int position = viewPosition(anchor.itemIndex);
+    if (position >= 0) {
+        _scrollOffset = position - anchor.slot;
+    }
+    int maxScrollOffset = std::max(0, viewCount() - _maxVisibleItems);
+    if (_scrollOffset >= maxScrollOffset || _scrollOffset < 0) {
+        _scrollOffset = std::max(0, std::min(_scrollOffset, maxScrollOffset));
+        _scrollPixel = 0;
+    }
+}
+
+int UIComboBox::itemNearRow(int row) const {
+    if (!_sortIndex.isActive()) return std::min(row, itemCount() - 1);
+    // Les en-têtes de section sont ignorés.
+    int rows = (int)_sortIndex.rowCount();
+    for (int r = row; r < rows; ++r) {
+        long item = _sortIndex.itemAt(r);
+        if (item >= 0) return (int)item;
+    }
+    for (int r = std::min(row, rows) - 1; r >= 0; --r) {
+        long item = _sortIndex.itemAt(r);
+        if (item >= 0) return (int)item;
+    }
+    return -1;
+}
+
+void UIComboBox::setFilterEnabled(bool enable) {
+    if (_filterEnabled == enable) return;
+    _filterEnabled = enable;
+    _filterLength = 0;
+    _filterText[0] = '\0';
+    if (!enable) {
+        _prefixIndex.clear(); // L'index n'est plus utile hors du mode filtre
+    }
+    applyFilter(false);
+}
+
+bool UIComboBox::isFilterEnabled() const {
+    return _filterEnabled;
+}
+
+void UIComboBox::appendFilterChar(char c) {
+    if (!_filterEnabled || c == '\0' || _filterLength >= MAX_FILTER_LENGTH) return;
+    _filterText[_filterLength++] = c;
+    _filterText[_filterLength] = '\0';
+    // Le nouveau préfixe prolonge l'ancien : la recherche se limite à la plage courante.
+    applyFilter(true);
+}
+
+void UIComboBox::removeFilterChar() {
+    if (!_filterEnabled || _filterLength == 0) return;
+    _filterText[--_filterLength] = '\0';
+    applyFilter(false);
+}
+
+void UIComboBox::setFilterText(const String& text) {
+    if (!_filterEnabled) return;
+    _filterLength = std::min((size_t)text.length(), MAX_FILTER_LENGTH);
+    memcpy(_filterText, text.c_str(), _filterLength);
+    _filterText[_filterLength] = '\0';
+    applyFilter(false);
+}
+
+void UIComboBox::clearFilter() {
+    if (_filterLength == 0) return;
+    _filterLength = 0;
+    _filterText[0] = '\0';
+    applyFilter(false);
+}
+
+String UIComboBox::getFilterText() const {
+    return String(_filterText);
+}
+
+int UIComboBox::getFilteredCount() const {
+    return viewCount();
+}
+
+void UIComboBox::applyFilter(bool narrowing) {
+    if (!_filterEnabled || _filterLength == 0) {
+        _filterActive = false;
+    } else {
+        if (!_prefixIndex.isBuilt()) {
+            _prefixIndex.build(*_provider);
+            narrowing = false;
+        }
+        if (!narrowing || !_filterActive) {
+            _filterFirst = 0;
+            _filterLast = _prefixIndex.size();
+        }
+        _prefixIndex.narrow(*_provider, _filterText, _filterLength, _filterFirst, _filterLast);
+        _filterActive = true;
+    }
+
+    // La vue filtrée repart du début, en gardant l'élément sélectionné visible s'il y figure.
+    _scrollOffset = 0;
+    _scrollPixel = 0;
+    int position = viewPosition(_selectedIndex);
+    if (position >= _maxVisibleItems) {
+        _scrollOffset = position - _maxVisibleItems + 1;
+    }
+    invalidate(DIRTY_HEADER_TEXT | DIRTY_LIST);
+}
+
+void UIComboBox::itemListChanged(bool prefixIndexUpdated) {
+    _valueIndexValid = false;
+    if (_prefixIndex.isBuilt() && !prefixIndexUpdated) {
+        // L'index est reconstruit à la prochaine recherche.
+        _prefixIndex.clear();
+    }
+    if (_filterActive) {
+        applyFilter(false);
+    }
+}
+
 void UIComboBox::setOnSelect(SelectCallback callback) {
     _onSelectCallback = callback;
 }
@@ -67,153 +582,1075 @@ void UIComboBox::setOnCollapse(CollapseCallback callback) {
     _onCollapseCallback = callback;
 }
 
+void UIComboBox::setBlitScrolling(bool enable) {
+    _blitScrolling = enable;
+    if (!enable) {
+        _blitBuffer.reset();
+        _blitBufferPixels = 0;
+    }
+}
+
+void UIComboBox::setTextCacheBudget(size_t budgetBytes) {
+    if (budgetBytes == 0) {
+        _textCache.reset();
+    } else if (_textCache) {
+        _textCache->setBudget(budgetBytes);
+    } else {
+        _textCache.reset(new (std::nothrow) UIComboBoxTextCache(budgetBytes));
+    }
+}
+
+UIComboBoxTextCache::Stats UIComboBox::getTextCacheStats() const {
+    return _textCache ? _textCache->getStats() : UIComboBoxTextCache::Stats();
+}
+
+void UIComboBox::resetTextCacheStats() {
+    if (_textCache) {
+        _textCache->resetStats();
+    }
+}
+
+#if UICOMBOBOX_ENABLE_STATS
+const UIComboBoxStats& UIComboBox::getStats() const {
+    return _stats;
+}
+
+void UIComboBox::resetStats() {
+    _stats.reset();
+}
+
+void UIComboBox::countPrimitive(uint32_t& calls, const TFT_eSPI& gfx, int pixels) {
+    calls++;
+    // Les primitives tracées dans le sprite hors écran atteignent l'écran lors de son transfert.
+    if (&gfx != _sprite.get() && pixels > 0) {
+        _stats.pixelsWritten += pixels;
+    }
+}
+#endif
+
+void UIComboBox::setStyle(const UIComboBoxStyle& style) {
+    if (_ownedStyle) {
+        *_ownedStyle = style;
+    } else {
+        _ownedStyle.reset(new UIComboBoxStyle(style));
+    }
+    _style = _ownedStyle.get();
+    styleChanged();
+}
+
+void UIComboBox::setStyle(const UIComboBoxStyle* sharedStyle) {
+    _style = sharedStyle;
+    _ownedStyle.reset();
+    styleChanged();
+}
+
+void UIComboBox::styleChanged() {
+    _maxVisibleItems = _style->maxVisibleItems;
+    _scrollBarWidth = _style->scrollBarWidth;
+    _scrollBarColor = _style->scrollBarColor;
+    invalidateLayout();
+    // Les libellés rendus avec l'ancien style ne sont plus valides.
+    if (_textCache) {
+        _textCache->clear();
+    }
+    // Conserver l'élément sélectionné visible avec le nouveau nombre de lignes.
+    int maxScrollOffset = std::max(0, viewCount() - _maxVisibleItems);
+    _scrollOffset = std::min(_scrollOffset, maxScrollOffset);
+    int selectedPosition = viewPosition(_selectedIndex);
+    if (selectedPosition >= _scrollOffset + _maxVisibleItems) {
+        _scrollOffset = selectedPosition - _maxVisibleItems + 1;
+    }
+    _scrollPixel = 0;
+    releaseRenderBuffers();
+    updateHeight();
+    invalidate(DIRTY_FULL);
+}
+
+void UIComboBox::setBackgroundRestore(bool enable, size_t maxBytes) {
+    _backgroundRestore = enable;
+    _underlayBudgetBytes = maxBytes;
+    if (!enable) {
+        _underlay.clear();
+        _underlayCapturePending = false;
+        _underlayRestorePending = false;
+    }
+}
+
+UIRect UIComboBox::dropdownListRect() const {
+    const Layout& geometry = layout();
+    return {rect.x, geometry.listTopY, rect.w, geometry.listHeight};
+}
+
+void UIComboBox::setSpriteRendering(bool enable, size_t maxBufferBytes) {
+    _spriteRendering = enable;
+    _spriteBudgetBytes = maxBufferBytes;
+    if (_sprite) {
+        // Le sprite sera recréé à la bonne taille au prochain dessin de la liste.
+        _sprite->deleteSprite();
+        _sprite.reset();
+    }
+}
+
 void UIComboBox::updateHeight() {
     if (_isExpanded) {
         // La hauteur étendue est basée sur le nombre max d'éléments visibles
-        int visibleItemsCount = std::min((int)_items.size(), _maxVisibleItems);
-        rect.h = _collapsedHeight + visibleItemsCount * _style.itemHeight;
+        rect.h = _collapsedHeight + layout().listHeight;
     } else {
         rect.h = _collapsedHeight;
     }
 }
 
+void UIComboBox::invalidate(uint8_t regions) {
+    _dirtyRegions |= regions;
+    setDirty(true);
+}
+
+void UIComboBox::invalidateItem(int index) {
+    if (!_isExpanded) return;
+    int position = viewPosition(index);
+    if (position < 0) return; // Élément masqué par le filtre
+    // Le masque décrit les lignes telles qu'elles sont actuellement à l'écran.
+    int slot = position - _drawnScrollOffset;
+    if (slot < 0 || slot >= rowSlotCount(_drawnScrollPixel)) return; // Ligne hors de la vue
+    if (slot >= MAX_TRACKED_ROWS) {
+        invalidate(DIRTY_ROWS);
+        return;
+    }
+    _dirtyRows |= (1UL << slot);
+    setDirty(true);
+}
+
+int UIComboBox::itemCount() const {
+    return (int)_provider->getItemCount();
+}
+
+size_t UIComboBox::itemText(int index, char* buffer) const {
+    size_t length = _provider->getItemText(index, buffer, ITEM_TEXT_BUFFER_SIZE);
+    // Un texte qui remplit le tampon a pu être coupé au milieu d'un caractère UTF-8.
+    return length == ITEM_TEXT_BUFFER_SIZE - 1 ? trimIncompleteUtf8(buffer, length) : length;
+}
+
+int UIComboBox::listRowCount() const {
+    return _sortIndex.isActive() ? (int)_sortIndex.rowCount() : itemCount();
+}
+
+int UIComboBox::viewCount() const {
+    return _filterActive ? (int)(_filterLast - _filterFirst) : listRowCount();
+}
+
+int UIComboBox::viewItem(int position) const {
+    if (_filterActive) return _prefixIndex.itemAt(_filterFirst + position);
+    return _sortIndex.isActive() ? (int)_sortIndex.itemAt(position) : position;
+}
+
+int UIComboBox::viewPosition(int itemIndex) const {
+    if (itemIndex < 0 || itemIndex >= itemCount()) return -1;
+    if (_filterActive) {
+        long position = _prefixIndex.positionOf(*_provider, itemIndex, _filterFirst, _filterLast);
+        return position < 0 ? -1 : (int)(position - _filterFirst);
+    }
+    return _sortIndex.isActive() ? (int)_sortIndex.rowOf(*_provider, itemIndex) : itemIndex;
+}
+
+void UIComboBox::invalidateRowsFrom(int position) {
+    if (!_isExpanded || position < 0) return;
+    int visibleItemsCount = layout().visibleItemsCount;
+    int firstSlot = std::max(0, position - _drawnScrollOffset);
+    if (firstSlot >= visibleItemsCount) return; // Sous la vue : aucune ligne affichée ne change
+    if (visibleItemsCount > MAX_TRACKED_ROWS) {
+        invalidate(DIRTY_ROWS);
+        return;
+    }
+    // Les lignes à partir de la position modifiée sont décalées.
+    _dirtyRows |= ~((1UL << firstSlot) - 1);
+    setDirty(true);
+}
+
+bool UIComboBox::hasScrollBar() const {
+    return viewCount() > _maxVisibleItems;
+}
+
+int UIComboBox::rowSlotCount(int scrollPixel) const {
+    // Décalée d'une fraction de ligne, la liste laisse apparaître une ligne partielle en bas.
+    return layout().visibleItemsCount + (scrollPixel > 0 ? 1 : 0);
+}
+
+const UIComboBox::Layout& UIComboBox::layout() const {
+    int count = listRowCount();
+    if (_layout.valid && _layout.x == rect.x && _layout.y == rect.y && _layout.w == rect.w && _layout.rowCount == count) {
+        return _layout;
+    }
+    _layout.x = rect.x;
+    _layout.y = rect.y;
+    _layout.w = rect.w;
+    _layout.rowCount = count;
+
+    _layout.visibleItemsCount = std::min(count, _maxVisibleItems);
+    _layout.listTopY = rect.y + _collapsedHeight;
+    _layout.listHeight = _layout.visibleItemsCount * _style->itemHeight;
+    // Un bouton carré à droite de la boîte fermée, la flèche centrée dedans.
+    _layout.textAreaWidth = rect.w - _collapsedHeight;
+    _layout.buttonX = rect.x + _layout.textAreaWidth;
+    _layout.arrowX = _layout.buttonX + (_collapsedHeight - _style->arrowSize * 2) / 2;
+    _layout.arrowY = rect.y + (_collapsedHeight - _style->arrowSize) / 2;
+    _layout.scrollBarX = rect.x + rect.w - _scrollBarWidth;
+
+    // Métriques de police, la police des éléments étant sélectionnée en dernier pour le dessin des lignes.
+    _u8f.setFont(_style->labelStyle.font);
+    _layout.labelY = rect.y - (_u8f.getFontAscent() - _u8f.getFontDescent()) + 12;
+    _layout.labelTop = _layout.labelY - _u8f.getFontAscent();
+    _u8f.setFont(_style->selectedTextStyle.font);
+    _layout.headerTextY = rect.y + (_collapsedHeight + _u8f.getFontAscent() - _u8f.getFontDescent()) / 2;
+    _u8f.setFont(_style->itemTextStyle.font);
+    _layout.itemAscent = _u8f.getFontAscent();
+    _layout.itemDescent = _u8f.getFontDescent();
+    _layout.itemBaseline = (_style->itemHeight + _layout.itemAscent - _layout.itemDescent) / 2;
+    _layout.valid = true;
+    return _layout;
+}
+
+int UIComboBox::scrollPosition() const {
+    return _scrollOffset * _style->itemHeight + _scrollPixel;
+}
+
+int UIComboBox::maxScrollPosition() const {
+    return std::max(0, viewCount() - _maxVisibleItems) * _style->itemHeight;
+}
+
+bool UIComboBox::setScrollPosition(int position) {
+    position = std::max(0, std::min(position, maxScrollPosition()));
+    if (position == scrollPosition()) return false;
+    _scrollOffset = position / _style->itemHeight;
+    _scrollPixel = position % _style->itemHeight;
+    invalidate(DIRTY_SCROLL | DIRTY_SCROLLBAR);
+    return true;
+}
+
+void UIComboBox::setRowClip(int top, int bottom) {
+    _clipTop = top;
+    _clipBottom = bottom;
+}
+
 void UIComboBox::drawInternal(TFT_eSPI& tft, bool force) {
-    // Draw the label manually
-    if (!_text.isEmpty()) {
-        _u8f.setFontMode(1);
-        _u8f.setFont(_style.labelStyle.font);
-        _u8f.setForegroundColor(_style.labelStyle.textColor);
-        // Position the label above the combo box
-        int fontHeight = _u8f.getFontAscent() - _u8f.getFontDescent();
-        int labelY = rect.y - fontHeight + 12;
-        _u8f.setCursor(rect.x, labelY);
-        _u8f.print(_text);
+    UICOMBOBOX_STATS_TIME(_stats.draw);
+    UICOMBOBOX_STATS(force ? _stats.forcedDraws++ : _stats.dirtyDraws++);
+
+    // Une sauvegarde ou une restauration du fond ne se fait jamais à travers une zone de découpe.
+    while (!_drawClipActive && updateUnderlay(tft)) {}
+    // Le travail laissé en attente par drawStep() est repris en une seule fois.
+    uint8_t regions = _dirtyRegions | _stepRegions;
+    uint32_t rows = _dirtyRows | _stepRows;
+    _dirtyRegions = DIRTY_NONE;
+    _dirtyRows = 0;
+    _stepRegions = DIRTY_NONE;
+    _stepRows = 0;
+
+    // Un dessin forcé, ou un setDirty() venu de la classe de base sans région précise,
+    // redessine l'ensemble du composant.
+    if (force || (regions == DIRTY_NONE && rows == 0) || (regions & DIRTY_FULL)) {
+        drawLabel();
+        drawHeader(tft);
+        if (_isExpanded) {
+            drawList(tft);
+        }
+        return;
+    }
+
+    if (regions & DIRTY_HEADER_TEXT) {
+        drawHeaderText(tft, true);
+    }
+    if (regions & DIRTY_ARROW) {
+        drawArrowButton(tft, true);
+    }
+    if (!_isExpanded) return;
+
+    if (regions & DIRTY_LIST) {
+        drawList(tft);
+        return;
+    }
+
+    // Seules les lignes invalidées sont repeintes, le fond et la bordure de la liste restent en place.
+    const Layout& geometry = layout();
+    int visibleItemsCount = geometry.visibleItemsCount;
+    int listTopY = geometry.listTopY;
+    int listHeight = geometry.listHeight;
+    // Bande découverte par un défilement par copie, relative au haut de la liste.
+    int exposedFrom = 0;
+    int exposedTo = 0;
+
+    if ((regions & DIRTY_SCROLL) && !(regions & DIRTY_ROWS)) {
+        int deltaPixels = scrollPosition() - (_drawnScrollOffset * _style->itemHeight + _drawnScrollPixel);
+        bool rowAligned = _scrollPixel == 0 && _drawnScrollPixel == 0;
+        if (_blitScrolling && std::abs(deltaPixels) < listHeight - 2 && visibleItemsCount <= MAX_TRACKED_ROWS
+            && blitLines(tft, deltaPixels)) {
+            // Les lignes déjà dessinées ont été déplacées : seule la bande découverte est rastérisée.
+            if (deltaPixels > 0) {
+                exposedFrom = listHeight - 1 - deltaPixels;
+                exposedTo = listHeight - 1;
+            } else {
+                exposedFrom = 1;
+                exposedTo = 1 - deltaPixels;
+            }
+            if (rows != 0 && rowAligned) {
+                // Les lignes invalidées ont suivi le contenu déplacé.
+                int deltaRows = deltaPixels / _style->itemHeight;
+                rows = deltaRows > 0 ? rows >> deltaRows : rows << -deltaRows;
+            } else if (rows != 0) {
+                regions |= DIRTY_ROWS;
+            }
+        } else {
+            regions |= DIRTY_ROWS;
+        }
+    }
+
+    if (_spriteRendering && (regions & DIRTY_ROWS)) {
+        // Toutes les lignes changent : un seul transfert depuis le tampon évite le scintillement.
+        drawList(tft);
+        return;
+    }
+
+    _u8f.setFontMode(1);
+    _u8f.setFont(_style->itemTextStyle.font);
+    // Les lignes sont limitées à l'intérieur de la liste : la bordure n'est jamais recouverte.
+    setRowClip(listTopY + 1, listTopY + listHeight - 1);
+    int slotCount = rowSlotCount(_scrollPixel);
+    uint32_t drawnRows = 0;
+    for (int slot = 0; slot < slotCount; ++slot) {
+        bool rowDirty = (regions & DIRTY_ROWS) || (slot < MAX_TRACKED_ROWS && (rows & (1UL << slot)));
+        if (rowDirty) {
+            drawItemRow(tft, slot);
+            if (slot < MAX_TRACKED_ROWS) drawnRows |= (1UL << slot);
+        }
+    }
+    if (exposedTo > exposedFrom && !(regions & DIRTY_ROWS)) {
+        // Seule la partie des lignes recoupant la bande découverte est repeinte.
+        setRowClip(listTopY + exposedFrom, listTopY + exposedTo);
+        int firstSlot = (exposedFrom + _scrollPixel) / _style->itemHeight;
+        int lastSlot = std::min(slotCount, (exposedTo + _scrollPixel + _style->itemHeight - 1) / _style->itemHeight);
+        for (int slot = firstSlot; slot < lastSlot; ++slot) {
+            if (!(drawnRows & (1UL << slot))) {
+                drawItemRow(tft, slot);
+            }
+        }
+    }
+    _drawnScrollOffset = _scrollOffset;
+    _drawnScrollPixel = _scrollPixel;
+
+    if ((regions & DIRTY_SCROLLBAR) && hasScrollBar()) {
+        drawScrollBar(tft);
+        // Le fond de la barre recouvre le bord droit de la liste : on retrace la bordure.
+        uint16_t outlineColor = enabled ? _style->outlineColor : TFT_DARKGREY;
+        tft.drawRect(rect.x, listTopY, rect.w, listHeight, outlineColor);
+        UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, 2 * (rect.w + listHeight)));
+    }
+}
+
+bool UIComboBox::updateUnderlay(TFT_eSPI& tft) {
+    if (_underlayRestorePending) {
+        // La liste vient d'être repliée : les pixels qu'elle recouvrait sont recopiés à l'écran.
+        _underlayRestorePending = false;
+        _underlay.restore(tft);
+        return true;
+    }
+    if (_underlayCapturePending && _isExpanded) {
+        // Premier dessin de la liste dépliée : la zone est sauvegardée avant d'être recouverte.
+        _underlayCapturePending = false;
+        _underlay.capture(tft, dropdownListRect(), _underlayBudgetBytes);
+        return true;
+    }
+    return false;
+}
+
+bool UIComboBox::drawStep(TFT_eSPI& tft, uint32_t budgetUs) {
+    UICOMBOBOX_STATS_TIME(_stats.step);
+    UICOMBOBOX_STATS(_stats.stepDraws++);
+    unsigned long startUs = micros();
+    mergeStepWork();
+    // Au moins une unité est dessinée par appel, pour garantir la progression.
+    bool first = true;
+    while (hasPendingDraw()) {
+        if (!first && micros() - startUs >= budgetUs) break;
+        first = false;
+        drawNextUnit(tft);
+    }
+    // Un draw() ultérieur termine le travail restant.
+    bool pending = hasPendingDraw();
+    setDirty(pending);
+    return pending;
+}
+
+bool UIComboBox::hasPendingDraw() const {
+    return _stepRegions != DIRTY_NONE || _stepRows != 0 || _underlayRestorePending || (_underlayCapturePending && _isExpanded);
+}
+
+bool UIComboBox::needsRedraw() const {
+    return _dirtyRegions != DIRTY_NONE || _dirtyRows != 0 || hasPendingDraw();
+}
+
+void UIComboBox::drawClipped(TFT_eSPI& tft, const UIRect& clip) {
+    if (clip.w <= 0 || clip.h <= 0) return;
+    // Hors de la zone, l'écran n'est pas à jour : le dessin forcé ne consomme pas les modifications en attente.
+    uint8_t regions = _dirtyRegions;
+    uint32_t rows = _dirtyRows;
+    uint8_t stepRegions = _stepRegions;
+    uint32_t stepRows = _stepRows;
+    int stepNextSlot = _stepNextSlot;
+    int drawnScrollOffset = _drawnScrollOffset;
+    int drawnScrollPixel = _drawnScrollPixel;
+    bool dirty = isDirty();
+
+    _drawClipActive = true;
+    _drawClip = clip;
+    tft.setViewport(clip.x, clip.y, clip.w, clip.h, false);
+    draw(tft, true);
+    tft.resetViewport();
+    _drawClipActive = false;
+
+    _dirtyRegions = regions;
+    _dirtyRows = rows;
+    _stepRegions = stepRegions;
+    _stepRows = stepRows;
+    _stepNextSlot = stepNextSlot;
+    if (_isExpanded && (drawnScrollOffset != _scrollOffset || drawnScrollPixel != _scrollPixel)) {
+        // La zone montre déjà la nouvelle position, le reste l'ancienne : une copie mélangerait les deux.
+        _dirtyRegions |= DIRTY_ROWS;
+    }
+    _drawnScrollOffset = drawnScrollOffset;
+    _drawnScrollPixel = drawnScrollPixel;
+    setDirty(dirty);
+}
+
+UIRect UIComboBox::getPaintRect() const {
+    if (_text.isEmpty()) return rect;
+    int top = std::min(rect.y, layout().labelTop);
+    return {rect.x, top, rect.w, rect.y + rect.h - top};
+}
+
+bool UIComboBox::getPendingArea(UIComboBoxDirtyRegion& area) const {
+    if (!isDirty()) return true;
+    // Mêmes règles que drawInternal() : le travail laissé par drawStep() est repris avec le reste.
+    // Les zones sont ajoutées sans fusion : une union couvrirait des pixels qui ne seront pas repeints.
+    uint8_t regions = _dirtyRegions | _stepRegions;
+    uint32_t rows = _dirtyRows | _stepRows;
+    // Une zone refusée par une liste pleine n'est pas décrite : l'appelant ne doit alors rien supposer du reste.
+    bool complete = true;
+    if ((regions == DIRTY_NONE && rows == 0) || (regions & DIRTY_FULL)) {
+        return area.append(getPaintRect());
+    }
+
+    const Layout& geometry = layout();
+    if (regions & DIRTY_HEADER_TEXT) {
+        complete &= area.append({rect.x + 1, rect.y + 1, geometry.textAreaWidth - 1, _collapsedHeight - 2});
+    }
+    if (regions & DIRTY_ARROW) {
+        complete &= area.append({geometry.buttonX + 1, rect.y + 1, _collapsedHeight - 2, _collapsedHeight - 2});
+    }
+    if (!_isExpanded) return complete;
+    if (regions & DIRTY_LIST) {
+        return area.append(dropdownListRect()) && complete;
+    }
+
+    int itemTextWidth = rect.w - (hasScrollBar() ? _scrollBarWidth : 0);
+    UIRect interior = {rect.x + 1, geometry.listTopY + 1, itemTextWidth - 2, geometry.listHeight - 2};
+    bool blitScroll = (regions & DIRTY_SCROLL) && !(regions & DIRTY_ROWS) && _blitScrolling;
+    if ((regions & (DIRTY_ROWS | DIRTY_SCROLL)) && !blitScroll) {
+        complete &= area.append(interior);
+    } else if (!blitScroll) {
+        // Un défilement par copie ne rastérise qu'une bande : les lignes déplacées ne sont pas comptées.
+        int slotCount = std::min(rowSlotCount(_scrollPixel), MAX_TRACKED_ROWS);
+        for (int slot = 0; slot < slotCount; ++slot) {
+            if (!(rows & (1UL << slot))) continue;
+            // Les lignes invalidées consécutives forment une seule bande.
+            int last = slot;
+            while (last + 1 < slotCount && (rows & (1UL << (last + 1)))) last++;
+            int top = geometry.listTopY + slot * _style->itemHeight - _scrollPixel;
+            UIRect band = {interior.x, top, interior.w, (last - slot + 1) * _style->itemHeight};
+            complete &= area.append(UIComboBoxDirtyRegion::intersection(band, interior));
+            slot = last;
+        }
     }
+    if ((regions & DIRTY_SCROLLBAR) && hasScrollBar()) {
+        complete &= area.append({geometry.scrollBarX, geometry.listTopY, _scrollBarWidth, geometry.listHeight});
+    }
+    return complete;
+}
 
+void UIComboBox::mergeStepWork() {
+    uint8_t regions = _dirtyRegions;
+    uint32_t rows = _dirtyRows;
+    // Comme dans drawInternal(), un setDirty() venu de la classe de base sans région précise vaut un dessin
+    // complet ; le drapeau laissé levé par drawStep() pour son propre travail en attente n'en est pas un.
+    bool baseInvalidation = isDirty() && !hasPendingDraw();
+    _dirtyRegions = DIRTY_NONE;
+    _dirtyRows = 0;
+    setDirty(false);
+    if (regions == DIRTY_NONE && rows == 0) {
+        if (!baseInvalidation) return;
+        regions = DIRTY_FULL;
+    }
+
+    if (regions & DIRTY_FULL) {
+        // Tout le travail en attente est remplacé par un dessin complet.
+        _stepRegions = DIRTY_FULL;
+        _stepRows = 0;
+        return;
+    }
+    if (regions & (DIRTY_SCROLL | DIRTY_LIST)) {
+        // Les lignes en attente décrivent l'ancienne position : elles sont toutes reprises depuis le haut.
+        regions |= DIRTY_ROWS;
+        _stepNextSlot = 0;
+        _stepRows = 0;
+        rows = 0;
+        _drawnScrollOffset = _scrollOffset;
+        _drawnScrollPixel = _scrollPixel;
+    }
+    _stepRegions |= regions & ~DIRTY_SCROLL;
+    _stepRows |= rows;
+}
+
+void UIComboBox::drawNextUnit(TFT_eSPI& tft) {
+    if (updateUnderlay(tft)) return;
+
+    // Unités par ordre de priorité : boîte fermée, fond de la liste, barre de défilement, puis lignes.
+    if (_stepRegions & DIRTY_FULL) {
+        drawLabel();
+        drawHeader(tft);
+        _stepRegions &= ~(DIRTY_FULL | DIRTY_HEADER_TEXT | DIRTY_ARROW);
+        if (_isExpanded) {
+            _stepRegions |= DIRTY_LIST;
+        }
+        return;
+    }
+    if (_stepRegions & DIRTY_HEADER_TEXT) {
+        drawHeaderText(tft, true);
+        _stepRegions &= ~DIRTY_HEADER_TEXT;
+        return;
+    }
+    if (_stepRegions & DIRTY_ARROW) {
+        drawArrowButton(tft, true);
+        _stepRegions &= ~DIRTY_ARROW;
+        return;
+    }
+    if (!_isExpanded) {
+        // La liste a été repliée entre deux étapes : ses unités en attente sont abandonnées.
+        _stepRegions = DIRTY_NONE;
+        _stepRows = 0;
+        return;
+    }
+
+    const Layout& geometry = layout();
+    int listTopY = geometry.listTopY;
+    int listHeight = geometry.listHeight;
+    uint16_t outlineColor = enabled ? _style->outlineColor : TFT_DARKGREY;
+    if (_stepRegions & DIRTY_LIST) {
+        tft.fillRect(rect.x, listTopY, rect.w, listHeight, _style->backgroundColor);
+        tft.drawRect(rect.x, listTopY, rect.w, listHeight, outlineColor);
+        UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, rect.w * listHeight));
+        UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, 2 * (rect.w + listHeight)));
+        _stepRegions = (_stepRegions & ~DIRTY_LIST) | DIRTY_ROWS | DIRTY_SCROLLBAR;
+        _stepRows = 0;
+        _stepNextSlot = 0;
+        _drawnScrollOffset = _scrollOffset;
+        _drawnScrollPixel = _scrollPixel;
+        return;
+    }
+    if (_stepRegions & DIRTY_SCROLLBAR) {
+        _stepRegions &= ~DIRTY_SCROLLBAR;
+        if (hasScrollBar()) {
+            drawScrollBar(tft);
+            // Le fond de la barre recouvre le bord droit de la liste : on retrace la bordure.
+            tft.drawRect(rect.x, listTopY, rect.w, listHeight, outlineColor);
+            UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, 2 * (rect.w + listHeight)));
+        }
+        return;
+    }
+
+    int slot;
+    int slotCount = rowSlotCount(_scrollPixel);
+    if (_stepRegions & DIRTY_ROWS) {
+        slot = _stepNextSlot++;
+        if (_stepNextSlot >= slotCount) {
+            _stepRegions &= ~DIRTY_ROWS;
+            _stepRows = 0; // Toutes les lignes ont été redessinées
+        }
+    } else if (_stepRows != 0) {
+        slot = __builtin_ctz(_stepRows);
+        _stepRows &= _stepRows - 1;
+    } else {
+        _stepRegions = DIRTY_NONE;
+        return;
+    }
+    if (slot >= slotCount) return;
+    _u8f.setFontMode(1);
+    _u8f.setFont(_style->itemTextStyle.font);
+    setRowClip(listTopY + 1, listTopY + listHeight - 1);
+    drawItemRow(tft, slot);
+}
+
+void UIComboBox::drawLabel() {
+    if (_text.isEmpty()) return;
+    // Position the label above the combo box
+    int labelY = layout().labelY;
+    _u8f.setFontMode(1);
+    _u8f.setFont(_style->labelStyle.font);
+    _u8f.setForegroundColor(_style->labelStyle.textColor);
+    _u8f.setCursor(rect.x, labelY);
+    _u8f.print(_text);
+}
+
+void UIComboBox::drawHeader(TFT_eSPI& tft) {
     // Couleurs basées sur l'état et le style
-    uint16_t mainBgColor = enabled ? _style.backgroundColor : TFT_DARKGREY;
-    uint16_t buttonBgColor = enabled ? _style.buttonColor : TFT_DARKGREY;
-    uint16_t outlineColor = enabled ? _style.outlineColor : TFT_DARKGREY;
-    uint16_t textColor = enabled ? _style.selectedTextStyle.textColor : TFT_LIGHTGREY;
-    uint16_t arrowColor = enabled ? _style.arrowColor : TFT_LIGHTGREY;
+    uint16_t mainBgColor = enabled ? _style->backgroundColor : TFT_DARKGREY;
+    uint16_t buttonBgColor = enabled ? _style->buttonColor : TFT_DARKGREY;
+    uint16_t outlineColor = enabled ? _style->outlineColor : TFT_DARKGREY;
 
     // --- Dimensions pour le style TComboBox ---
+    const Layout& geometry = layout();
     int buttonWidth = _collapsedHeight; // Un bouton carré
-    int textAreaWidth = rect.w - buttonWidth;
-    int buttonX = rect.x + textAreaWidth;
+    int textAreaWidth = geometry.textAreaWidth;
+    int buttonX = geometry.buttonX;
 
     // --- Dessiner la boîte fermée ---
     tft.fillRect(rect.x, rect.y, textAreaWidth, _collapsedHeight, mainBgColor);
     tft.fillRect(buttonX, rect.y, buttonWidth, _collapsedHeight, buttonBgColor);
     tft.drawRect(rect.x, rect.y, rect.w, _collapsedHeight, outlineColor); // Bordure extérieure
     tft.drawFastVLine(buttonX, rect.y + 1, _collapsedHeight - 2, outlineColor); // Séparateur
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, textAreaWidth * _collapsedHeight));
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, buttonWidth * _collapsedHeight));
+    UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, 2 * (rect.w + _collapsedHeight)));
+    UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, _collapsedHeight - 2));
+
+    drawHeaderText(tft, false);
+    drawArrowButton(tft, false);
+}
+
+void UIComboBox::drawHeaderText(TFT_eSPI& tft, bool clearBackground) {
+    uint16_t textColor = enabled ? _style->selectedTextStyle.textColor : TFT_LIGHTGREY;
+    const Layout& geometry = layout();
+
+    if (clearBackground) {
+        // Intérieur de la zone de texte uniquement : la bordure et le séparateur sont conservés.
+        uint16_t mainBgColor = enabled ? _style->backgroundColor : TFT_DARKGREY;
+        int textAreaWidth = geometry.textAreaWidth;
+        tft.fillRect(rect.x + 1, rect.y + 1, textAreaWidth - 1, _collapsedHeight - 2, mainBgColor);
+        UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, (textAreaWidth - 1) * (_collapsedHeight - 2)));
+    }
 
     // --- Dessiner le texte sélectionné avec U8g2 ---
     _u8f.setFontMode(1);
-    _u8f.setFont(_style.selectedTextStyle.font);
+    _u8f.setFont(_style->selectedTextStyle.font);
     _u8f.setForegroundColor(textColor);
-    int16_t textH = _u8f.getFontAscent() - _u8f.getFontDescent();
-    int textY = rect.y + (_collapsedHeight + textH) / 2;
-    _u8f.setCursor(rect.x + TEXT_PADDING_X, textY);
-    _u8f.print(getSelectedText());
+    _u8f.setCursor(rect.x + TEXT_PADDING_X, geometry.headerTextY);
+    if (_filterLength > 0) {
+        // En mode filtre, la boîte affiche la saisie en cours suivie d'un curseur.
+        _u8f.print(_filterText);
+        _u8f.print("_");
+    } else if (_selectedIndex >= 0 && _selectedIndex < itemCount()) {
+        char text[ITEM_TEXT_BUFFER_SIZE];
+        itemText(_selectedIndex, text);
+        _u8f.print(text);
+    } else {
+        _u8f.print(F("No selection"));
+    }
+    UICOMBOBOX_STATS(_stats.textCalls++);
+}
+
+void UIComboBox::drawArrowButton(TFT_eSPI& tft, bool clearBackground) {
+    uint16_t arrowColor = enabled ? _style->arrowColor : TFT_LIGHTGREY;
+    const Layout& geometry = layout();
+    int buttonWidth = _collapsedHeight;
+    int buttonX = geometry.buttonX;
+
+    if (clearBackground) {
+        uint16_t buttonBgColor = enabled ? _style->buttonColor : TFT_DARKGREY;
+        tft.fillRect(buttonX + 1, rect.y + 1, buttonWidth - 2, _collapsedHeight - 2, buttonBgColor);
+        UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, (buttonWidth - 2) * (_collapsedHeight - 2)));
+    }
 
     // --- Dessiner la flèche dans le bouton ---
-    int arrowX = buttonX + (buttonWidth - _style.arrowSize * 2) / 2;
-    int arrowY = rect.y + (_collapsedHeight - _style.arrowSize) / 2;
+    int arrowX = geometry.arrowX;
+    int arrowY = geometry.arrowY;
     if (_isExpanded) {
-        tft.fillTriangle(arrowX, arrowY + _style.arrowSize, arrowX + _style.arrowSize * 2, arrowY + _style.arrowSize, arrowX + _style.arrowSize, arrowY, arrowColor); // Flèche vers le haut
+        tft.fillTriangle(arrowX, arrowY + _style->arrowSize, arrowX + _style->arrowSize * 2, arrowY + _style->arrowSize, arrowX + _style->arrowSize, arrowY, arrowColor); // Flèche vers le haut
     } else {
-        tft.fillTriangle(arrowX, arrowY, arrowX + _style.arrowSize * 2, arrowY, arrowX + _style.arrowSize, arrowY + _style.arrowSize, arrowColor); // Flèche vers le bas
+        tft.fillTriangle(arrowX, arrowY, arrowX + _style->arrowSize * 2, arrowY, arrowX + _style->arrowSize, arrowY + _style->arrowSize, arrowColor); // Flèche vers le bas
     }
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, _style->arrowSize * _style->arrowSize));
+}
 
-    // --- Dessiner la liste si dépliée ---
-    if (_isExpanded) {
-        int listTopY = rect.y + _collapsedHeight;
-        uint16_t listBgColor = _style.backgroundColor;
+void UIComboBox::drawList(TFT_eSPI& tft) {
+    if (_spriteRendering && drawListBuffered(tft)) {
+        return;
+    }
+    renderList(tft, 0, layout().listHeight);
+}
+
+void UIComboBox::renderList(TFT_eSPI& gfx, int fromLine, int toLine) {
+    uint16_t outlineColor = enabled ? _style->outlineColor : TFT_DARKGREY;
+    const Layout& geometry = layout();
+    int listX = rect.x - _renderOffsetX;
+    int listTopY = geometry.listTopY - _renderOffsetY;
+    uint16_t listBgColor = _style->backgroundColor;
+    int listHeight = geometry.listHeight;
+
+    gfx.fillRect(listX, listTopY + fromLine, rect.w, toLine - fromLine, listBgColor);
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, gfx, rect.w * (toLine - fromLine)));
+
+    _u8f.setFontMode(1);
+    _u8f.setFont(_style->itemTextStyle.font);
+    // Seules les lignes recoupant la bande [fromLine, toLine) sont rastérisées, limitées à l'intérieur de la liste.
+    setRowClip(listTopY + std::max(fromLine, 1), listTopY + std::min(toLine, listHeight - 1));
+    int firstSlot = (fromLine + _scrollPixel) / _style->itemHeight;
+    int lastSlot = std::min(rowSlotCount(_scrollPixel), (toLine + _scrollPixel + _style->itemHeight - 1) / _style->itemHeight);
+    for (int slot = firstSlot; slot < lastSlot; ++slot) {
+        drawItemRow(gfx, slot);
+    }
+    _drawnScrollOffset = _scrollOffset;
+    _drawnScrollPixel = _scrollPixel;
 
-        int visibleItemsCount = std::min((int)_items.size(), _maxVisibleItems);
-        int listHeight = visibleItemsCount * _style.itemHeight;
+    // Dessiner la barre de défilement si nécessaire
+    if (hasScrollBar()) {
+        drawScrollBar(gfx);
+    }
+    gfx.drawRect(listX, listTopY, rect.w, listHeight, outlineColor); // Dessiner la bordure en dernier
+    UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, gfx, 2 * (rect.w + listHeight)));
+}
+
+bool UIComboBox::drawListBuffered(TFT_eSPI& tft) {
+    const Layout& geometry = layout();
+    int listTopY = geometry.listTopY;
+    int listHeight = geometry.listHeight;
+    if (listHeight <= 0 || rect.w <= 0) return false;
+
+    // Hauteur de bande permise par le budget mémoire : la liste entière si possible, sinon par bandes.
+    int stripLines = std::min(listHeight, (int)(_spriteBudgetBytes / (rect.w * sizeof(uint16_t))));
+    if (stripLines <= 0) return false;
 
-        // Largeur de la zone de texte des éléments (sans la barre de défilement)
-        int itemTextWidth = rect.w;
-        if (_items.size() > _maxVisibleItems) { // Si une barre de défilement est nécessaire
-            itemTextWidth -= _scrollBarWidth;
+    if (!_sprite) {
+        _sprite.reset(new (std::nothrow) TFT_eSprite(&tft));
+        if (!_sprite) return false;
+    }
+    if (!_sprite->created() || _sprite->width() != rect.w || _sprite->height() > stripLines) {
+        _sprite->deleteSprite();
+        _sprite->setColorDepth(16);
+        // En cas d'échec d'allocation, on réessaie avec des bandes plus petites.
+        while (stripLines > 0 && _sprite->createSprite(rect.w, stripLines) == nullptr) {
+            stripLines /= 2;
         }
+        if (stripLines <= 0) return false; // Repli sur le dessin direct
+    }
+    stripLines = _sprite->height();
 
-        tft.fillRect(rect.x, listTopY, rect.w, listHeight, listBgColor);
+    _u8f.begin(*_sprite);
+    for (int top = 0; top < listHeight; top += stripLines) {
+        int lines = std::min(stripLines, listHeight - top);
+        _renderOffsetX = rect.x;
+        _renderOffsetY = listTopY + top;
+        renderList(*_sprite, top, top + lines);
+        pushSpriteStrip(tft, rect.x, listTopY + top, lines);
+    }
+    _renderOffsetX = 0;
+    _renderOffsetY = 0;
+    _u8f.begin(tft);
+    return true;
+}
 
-        _u8f.setFont(_style.itemTextStyle.font);
+void UIComboBox::pushSpriteStrip(TFT_eSPI& tft, int x, int y, int lines) {
+    // Le tampon du sprite est déjà dans l'ordre d'octets de l'écran.
+    uint16_t* pixels = (uint16_t*)_sprite->getPointer();
+    bool swapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(false);
+    UICOMBOBOX_STATS(countPrimitive(_stats.pushCalls, tft, rect.w * lines));
+#if defined(ESP32_DMA) || defined(RP2040_DMA) || defined(STM32_DMA)
+    if (tft.DMA_Enabled) {
+        // Une seule fenêtre, transférée par DMA (initDMA() doit avoir été appelé par l'application).
+        tft.startWrite();
+        tft.pushImageDMA(x, y, rect.w, lines, pixels);
+        tft.dmaWait();
+        tft.endWrite();
+        tft.setSwapBytes(swapBytes);
+        return;
+    }
+#endif
+    tft.pushImage(x, y, rect.w, lines, pixels);
+    tft.setSwapBytes(swapBytes);
+}
 
-        int startIndex = _scrollOffset;
-        int endIndex = std::min((int)_items.size(), _scrollOffset + _maxVisibleItems);
+void UIComboBox::releaseRenderBuffers() {
+    _blitBuffer.reset();
+    _blitBufferPixels = 0;
+    if (_sprite) {
+        _sprite->deleteSprite();
+        _sprite.reset();
+    }
+}
 
-        for (int i = startIndex; i < endIndex; ++i) {
-            int itemIndex = i; // itemIndex is now just i
+void UIComboBox::drawItemRow(TFT_eSPI& tft, int slot) {
+    int position = _scrollOffset + slot;
 
-            uint16_t itemBgColor = (itemIndex == _selectedIndex) ? _style.highlightColor : listBgColor;
-            uint16_t itemTextColor = (itemIndex == _selectedIndex) ? _style.itemTextStyle.bgColor : _style.itemTextStyle.textColor;
+    const Layout& geometry = layout();
+    int listX = rect.x - _renderOffsetX;
+    int listTopY = geometry.listTopY - _renderOffsetY;
+    // Largeur de la zone de texte des éléments (sans la barre de défilement)
+    int itemTextWidth = rect.w;
+    if (hasScrollBar()) {
+        itemTextWidth -= _scrollBarWidth;
+    }
 
-            int currentItemY = listTopY + (i - startIndex) * _style.itemHeight;
+    // La ligne occupe [rowY, rowY + itemHeight) : une ligne de séparation puis le fond de l'élément.
+    int rowY = listTopY + slot * _style->itemHeight - _scrollPixel;
+    int clipTop = std::max(rowY, _clipTop);
+    int clipBottom = std::min(rowY + _style->itemHeight, _clipBottom);
+    if (clipTop >= clipBottom) return; // Ligne hors de la bande à dessiner
+    if (clipTop == rowY) {
+        tft.drawFastHLine(listX + 1, rowY, itemTextWidth - 2, _style->backgroundColor);
+        UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, itemTextWidth - 2));
+        clipTop++;
+        if (clipTop >= clipBottom) return;
+    }
 
-            tft.fillRect(rect.x + 1, currentItemY + 1, itemTextWidth - 2, _style.itemHeight - 1, itemBgColor);
-            
-            _u8f.setForegroundColor(itemTextColor);
-            int16_t itemTextH = _u8f.getFontAscent() - _u8f.getFontDescent();
-            int itemTextY = currentItemY + (_style.itemHeight + itemTextH) / 2;
-            _u8f.setCursor(rect.x + TEXT_PADDING_X, itemTextY);
-            _u8f.print(_items[itemIndex].text);
+    bool emptyRow = position >= viewCount(); // La vue filtrée compte moins d'éléments que la hauteur de la liste.
+    int itemIndex = emptyRow ? -1 : viewItem(position);
+    bool header = !emptyRow && itemIndex < 0; // En-tête de section d'une liste triée
+    bool selected = !emptyRow && itemIndex == _selectedIndex;
+    uint16_t itemBgColor = header ? _style->sectionHeaderColor : (selected ? _style->highlightColor : _style->backgroundColor);
+    uint16_t itemTextColor = header ? _style->sectionTextColor : (selected ? _style->itemTextStyle.bgColor : _style->itemTextStyle.textColor);
+
+    tft.fillRect(listX + 1, clipTop, itemTextWidth - 2, clipBottom - clipTop, itemBgColor);
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, (itemTextWidth - 2) * (clipBottom - clipTop)));
+    if (emptyRow) return;
+
+    // La police des éléments est sélectionnée par l'appelant, une seule fois pour toutes les lignes.
+    int itemTextY = rowY + geometry.itemBaseline;
+    if (itemTextY - geometry.itemAscent >= clipBottom || itemTextY - geometry.itemDescent <= clipTop) {
+        return; // La bande ne recoupe pas le texte : le fond suffit
+    }
+    char text[ITEM_TEXT_BUFFER_SIZE];
+    if (header) {
+        _sortIndex.headerText(*_provider, position, text, ITEM_TEXT_BUFFER_SIZE);
+    } else {
+        itemText(itemIndex, text);
+    }
+    // La copie des libellés mis en cache n'est pas limitée par la fenêtre d'affichage de l'écran.
+    bool screenClip = _drawClipActive && &tft != _sprite.get();
+    if (_textCache && !screenClip && !header) {
+        int maxTextWidth = itemTextWidth - 1 - TEXT_PADDING_X;
+        if (drawCachedItemText(tft, itemIndex, text, listX + TEXT_PADDING_X, itemTextY, maxTextWidth, itemTextColor, itemBgColor)) {
+            return;
+        }
+    }
+    // Une ligne partiellement visible est découpée par une fenêtre d'affichage de TFT_eSPI.
+    bool clipped = clipTop > rowY + 1 || clipBottom < rowY + _style->itemHeight;
+    if (clipped) {
+        int left = listX + 1;
+        int right = listX + itemTextWidth - 1;
+        if (screenClip) {
+            // La fenêtre de la ligne reste comprise dans la zone de drawClipped().
+            left = std::max(left, _drawClip.x);
+            right = std::min(right, _drawClip.x + _drawClip.w);
+            clipTop = std::max(clipTop, _drawClip.y);
+            clipBottom = std::min(clipBottom, _drawClip.y + _drawClip.h);
+            if (left >= right || clipTop >= clipBottom) return;
         }
+        tft.setViewport(left, clipTop, right - left, clipBottom - clipTop, false);
+    }
+    _u8f.setForegroundColor(itemTextColor);
+    _u8f.setCursor(listX + TEXT_PADDING_X, itemTextY);
+    _u8f.print(text);
+    UICOMBOBOX_STATS(_stats.textCalls++);
+    if (clipped && screenClip) {
+        tft.setViewport(_drawClip.x, _drawClip.y, _drawClip.w, _drawClip.h, false);
+    } else if (clipped) {
+        tft.resetViewport();
+    }
+}
 
-        // Dessiner la barre de défilement si nécessaire
-        if (_items.size() > _maxVisibleItems) {
-            drawScrollBar(tft);
+bool UIComboBox::drawCachedItemText(TFT_eSPI& gfx, int itemIndex, const char* text, int x, int baselineY, int maxWidth, uint16_t fgColor, uint16_t bgColor) {
+    const uint8_t* font = _style->itemTextStyle.font;
+    uint32_t textHash = UIComboBoxTextCache::hashText(text);
+    int ascent = layout().itemAscent;
+
+    const UIComboBoxTextCache::Entry* entry = _textCache->find(itemIndex, font, textHash);
+    if (!entry) {
+        entry = rasterizeItemText(gfx, itemIndex, text, textHash, maxWidth);
+        if (!entry) return false; // Libellé non mis en cache : rendu U8g2 classique
+    }
+    blitTextBitmap(gfx, *entry, x, baselineY - ascent, fgColor, bgColor);
+    UICOMBOBOX_STATS(countPrimitive(_stats.textCalls, gfx, entry->width * std::max(0, std::min(_clipBottom, baselineY - ascent + entry->height) - std::max(_clipTop, baselineY - ascent))));
+    return true;
+}
+
+const UIComboBoxTextCache::Entry* UIComboBox::rasterizeItemText(TFT_eSPI& gfx, int itemIndex, const char* text, uint32_t textHash, int maxWidth) {
+    const uint8_t* font = _style->itemTextStyle.font;
+    const Layout& geometry = layout();
+    int ascent = geometry.itemAscent;
+    int width = std::min((int)_u8f.getUTF8Width(text), maxWidth);
+    int height = ascent - geometry.itemDescent;
+    if (width <= 0 || height <= 0) return nullptr;
+
+    // Rendu du texte dans un sprite 1 bit temporaire, au format attendu par le cache.
+    TFT_eSprite mono(&gfx);
+    mono.setColorDepth(1);
+    if (mono.createSprite(width, height) == nullptr) return nullptr;
+
+    UIComboBoxTextCache::Entry* entry = _textCache->insert(itemIndex, font, textHash, width, height);
+    if (entry) {
+        mono.fillSprite(0);
+        _u8f.begin(mono);
+        _u8f.setFontMode(1);
+        _u8f.setFont(font);
+        _u8f.setForegroundColor(1);
+        _u8f.setCursor(0, ascent);
+        _u8f.print(text);
+        memcpy(entry->bits.get(), mono.getPointer(), entry->byteSize());
+        // Retour à la cible courante, avec l'état de police attendu par les lignes suivantes.
+        _u8f.begin(gfx);
+        _u8f.setFontMode(1);
+        _u8f.setFont(font);
+    }
+    mono.deleteSprite();
+    return entry;
+}
+
+void UIComboBox::blitTextBitmap(TFT_eSPI& gfx, const UIComboBoxTextCache::Entry& entry, int x, int y, uint16_t fgColor, uint16_t bgColor) {
+    int stride = entry.stride();
+    // Seules les lignes du bitmap comprises dans la bande [_clipTop, _clipBottom) sont copiées.
+    int firstRow = std::max(0, _clipTop - y);
+    int lastRow = std::min((int)entry.height, _clipBottom - y);
+    if (firstRow >= lastRow) return;
+    const uint8_t* row = entry.bits.get() + firstRow * stride;
+
+    if (&gfx != _sprite.get()) {
+        // Écran : une seule fenêtre, remplie par plages de pixels de même couleur.
+        gfx.startWrite();
+        gfx.setAddrWindow(x, y + firstRow, entry.width, lastRow - firstRow);
+        for (int py = firstRow; py < lastRow; ++py, row += stride) {
+            int runStart = 0;
+            bool runOn = row[0] & 0x80;
+            for (int px = 1; px <= entry.width; ++px) {
+                bool on = (px < entry.width) && (row[px >> 3] & (0x80 >> (px & 7)));
+                if (px == entry.width || on != runOn) {
+                    gfx.pushBlock(runOn ? fgColor : bgColor, px - runStart);
+                    runStart = px;
+                    runOn = on;
+                }
+            }
+        }
+        gfx.endWrite();
+        return;
+    }
+
+    // Sprite : le fond de la ligne est déjà rempli, seuls les segments allumés sont tracés.
+    for (int py = firstRow; py < lastRow; ++py, row += stride) {
+        int px = 0;
+        while (px < entry.width) {
+            if (!(row[px >> 3] & (0x80 >> (px & 7)))) {
+                ++px;
+                continue;
+            }
+            int runStart = px;
+            while (px < entry.width && (row[px >> 3] & (0x80 >> (px & 7)))) {
+                ++px;
+            }
+            gfx.drawFastHLine(x + runStart, y + py, px - runStart, fgColor);
+        }
+    }
+}
+
+bool UIComboBox::blitLines(TFT_eSPI& tft, int deltaPixels) {
+    if (deltaPixels == 0) return true;
+
+    const Layout& geometry = layout();
+    int itemTextWidth = rect.w;
+    if (hasScrollBar()) {
+        itemTextWidth -= _scrollBarWidth;
+    }
+    // Zone intérieure des lignes : la bordure et la barre de défilement ne sont pas copiées.
+    int copyX = rect.x + 1;
+    int copyW = itemTextWidth - 2;
+    if (copyW <= 0) return false;
+
+    // Tampon d'une bande de lignes, alloué une seule fois et conservé jusqu'au repliement.
+    int stripPixels = copyW * BLIT_STRIP_LINES;
+    if (_blitBufferPixels < stripPixels) {
+        _blitBuffer.reset(new (std::nothrow) uint16_t[stripPixels]);
+        _blitBufferPixels = _blitBuffer ? stripPixels : 0;
+        if (!_blitBuffer) return false; // Mémoire insuffisante : repli sur le rendu complet des lignes
+    }
+
+    // Seules les lignes de pixels intérieures (hors bordures haute et basse) sont déplacées.
+    int interiorTopY = geometry.listTopY + 1;
+    int shiftPixels = std::abs(deltaPixels);
+    int movedLines = geometry.listHeight - 2 - shiftPixels;
+
+    if (deltaPixels > 0) {
+        // Le contenu remonte : copie de haut en bas pour ne pas écraser les lignes source.
+        for (int line = 0; line < movedLines; line += BLIT_STRIP_LINES) {
+            int lines = std::min(BLIT_STRIP_LINES, movedLines - line);
+            tft.readRect(copyX, interiorTopY + shiftPixels + line, copyW, lines, _blitBuffer.get());
+            tft.pushRect(copyX, interiorTopY + line, copyW, lines, _blitBuffer.get());
+            UICOMBOBOX_STATS(countPrimitive(_stats.pushCalls, tft, copyW * lines));
+        }
+    } else {
+        // Le contenu descend : copie de bas en haut.
+        for (int line = movedLines; line > 0; line -= BLIT_STRIP_LINES) {
+            int lines = std::min(BLIT_STRIP_LINES, line);
+            tft.readRect(copyX, interiorTopY + line - lines, copyW, lines, _blitBuffer.get());
+            tft.pushRect(copyX, interiorTopY + shiftPixels + line - lines, copyW, lines, _blitBuffer.get());
+            UICOMBOBOX_STATS(countPrimitive(_stats.pushCalls, tft, copyW * lines));
         }
-        tft.drawRect(rect.x, listTopY, rect.w, listHeight, outlineColor); // Dessiner la bordure en dernier
     }
+    return true;
 }
 
 void UIComboBox::drawScrollBar(TFT_eSPI& tft) {
-    int listTopY = rect.y + _collapsedHeight;
-    int visibleListHeight = std::min((int)_items.size(), _maxVisibleItems) * _style.itemHeight;
+    UICOMBOBOX_STATS_TIME(_stats.scrollBar);
+    const Layout& geometry = layout();
+    int listTopY = geometry.listTopY - _renderOffsetY;
+    int visibleListHeight = geometry.listHeight;
 
-    int scrollBarX = rect.x + rect.w - _scrollBarWidth;
+    int scrollBarX = geometry.scrollBarX - _renderOffsetX;
 
     // Fond de la barre de défilement
-    tft.fillRect(scrollBarX, listTopY, _scrollBarWidth, visibleListHeight, _style.backgroundColor);
-    tft.drawRect(scrollBarX, listTopY, _scrollBarWidth, visibleListHeight, _style.outlineColor);
+    tft.fillRect(scrollBarX, listTopY, _scrollBarWidth, visibleListHeight, _style->backgroundColor);
+    tft.drawRect(scrollBarX, listTopY, _scrollBarWidth, visibleListHeight, _style->outlineColor);
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, _scrollBarWidth * visibleListHeight));
+    UICOMBOBOX_STATS(countPrimitive(_stats.rectCalls, tft, 2 * (_scrollBarWidth + visibleListHeight)));
 
     // Calcul de la taille et de la position du pouce (thumb) de la barre de défilement
-    float itemsRatio = (float)_maxVisibleItems / _items.size();
+    float itemsRatio = (float)_maxVisibleItems / viewCount();
     int thumbHeight = (int)(visibleListHeight * itemsRatio);
     if (thumbHeight < 10) thumbHeight = 10; // Taille minimale du pouce
 
     float scrollRatio;
-    int maxScrollOffset = _items.size() - _maxVisibleItems;
-    if (maxScrollOffset <= 0) { // No scrolling needed or only one "page" of items
+    int maxPosition = maxScrollPosition();
+    if (maxPosition <= 0) { // No scrolling needed or only one "page" of items
         scrollRatio = 0.0f;
     } else {
-        scrollRatio = (float)_scrollOffset / (float)maxScrollOffset;
+        scrollRatio = (float)scrollPosition() / (float)maxPosition;
         // Clamp scrollRatio to ensure it doesn't exceed 1.0 due to precision or rounding
         if (scrollRatio > 1.0f) scrollRatio = 1.0f;
     }
     int thumbY;
-    if (maxScrollOffset <= 0) {
+    if (maxPosition <= 0) {
         thumbY = listTopY; // No scrolling, thumb at top
     } else {
         // Calculate thumb position based on scrollRatio
         thumbY = listTopY + (int)((visibleListHeight - thumbHeight) * scrollRatio);
         
         // Ensure thumb reaches the very bottom when scrolled to max
-        if (_scrollOffset == maxScrollOffset) {
+        if (scrollPosition() == maxPosition) {
             thumbY = listTopY + visibleListHeight - thumbHeight;
         }
     }
 
     tft.fillRect(scrollBarX + 1, thumbY + 1, _scrollBarWidth - 2, thumbHeight - 2, _scrollBarColor);
+    UICOMBOBOX_STATS(countPrimitive(_stats.fillCalls, tft, (_scrollBarWidth - 2) * (thumbHeight - 2)));
 }
 
 void UIComboBox::handlePress(TFT_eSPI& tft, int tx, int ty) {
 	if (!enabled) return;
+	UICOMBOBOX_STATS_TIME(_stats.press);
 
 	// Clic sur l'en-tête pour déplier/replier
 	bool inHeader = (tx >= rect.x && tx <= rect.x + rect.w && ty >= rect.y && ty <= rect.y + _collapsedHeight);
@@ -221,53 +1658,53 @@ void UIComboBox::handlePress(TFT_eSPI& tft, int tx, int ty) {
 		if (_isExpanded) {
 			collapse();
 		} else {
-			_isExpanded = true;
-            // Réinitialiser le scrollOffset lors de l'expansion
-            _scrollOffset = 0;
-			updateHeight();
-			setDirty(true);
+			expand();
 		}
 		return;
 	}
 
 	// Si la liste est dépliée, vérifier un clic sur un item ou la barre de défilement
 	if (_isExpanded) {
-		int listTopY = rect.y + _collapsedHeight;
-        int visibleListHeight = std::min((int)_items.size(), _maxVisibleItems) * _style.itemHeight;
-        int scrollBarX = rect.x + rect.w - _scrollBarWidth;
+        const Layout& geometry = layout();
+        int listTopY = geometry.listTopY;
+        int visibleListHeight = geometry.listHeight;
+        int scrollBarX = geometry.scrollBarX;
 
         // Clic sur la barre de défilement
-        if (_items.size() > _maxVisibleItems && tx >= scrollBarX && tx <= rect.x + rect.w && ty >= listTopY && ty <= listTopY + visibleListHeight) {
+        if (hasScrollBar() && tx >= scrollBarX && tx <= rect.x + rect.w && ty >= listTopY && ty <= listTopY + visibleListHeight) {
             // Calculer la nouvelle position du pouce en fonction du clic
             float clickRatio = (float)(ty - listTopY) / visibleListHeight;
-            int maxScrollOffset = _items.size() - _maxVisibleItems;
+            int maxScrollOffset = viewCount() - _maxVisibleItems;
             
             // Ensure maxScrollOffset is not negative
             if (maxScrollOffset < 0) maxScrollOffset = 0;
 
+            int previousScrollPosition = scrollPosition();
+            _scrollPixel = 0;
             _scrollOffset = (int)(maxScrollOffset * clickRatio);
 
             // S'assurer que _scrollOffset reste dans les limites
             _scrollOffset = std::max(0, std::min(maxScrollOffset, _scrollOffset));
             // Si le clic est dans la dernière moitié de la zone de défilement, s'assurer d'atteindre le maxScrollOffset
-            if (ty >= listTopY + visibleListHeight - _style.itemHeight / 2) {
+            if (ty >= listTopY + visibleListHeight - _style->itemHeight / 2) {
                 _scrollOffset = maxScrollOffset;
             }
 
             // S'assurer que _scrollOffset reste dans les limites
             if (_scrollOffset < 0) _scrollOffset = 0;
             if (_scrollOffset > maxScrollOffset) _scrollOffset = maxScrollOffset;
-            setDirty(true);
+            if (scrollPosition() != previousScrollPosition) {
+                invalidate(DIRTY_SCROLL | DIRTY_SCROLLBAR);
+            }
             return;
         }
 
-		for (int i = 0; i < _maxVisibleItems; ++i) {
-            int itemIndex = _scrollOffset + i;
-            if (itemIndex >= (int)_items.size()) break; // Sécurité
-
-			int itemY = listTopY + i * _style.itemHeight;
-			if (tx >= rect.x && tx <= rect.x + rect.w - (_items.size() > _maxVisibleItems ? _scrollBarWidth : 0) && ty >= itemY && ty <= itemY + _style.itemHeight) {
-				setSelectedIndex(itemIndex); // Sélectionne l'item visible
+        // La ligne touchée se déduit directement de la position verticale et du défilement courant.
+        if (tx >= rect.x && tx <= rect.x + rect.w - (hasScrollBar() ? _scrollBarWidth : 0) && ty >= listTopY && ty < listTopY + visibleListHeight) {
+            int position = _scrollOffset + (ty - listTopY + _scrollPixel) / _style->itemHeight;
+            if (position < viewCount()) {
+                if (viewItem(position) < 0) return; // En-tête de section : la liste reste dépliée
+				setSelectedIndex(viewItem(position)); // Sélectionne l'item visible
 				collapse();          // Et replie la liste
 				return;
 			}
@@ -278,6 +1715,132 @@ void UIComboBox::handlePress(TFT_eSPI& tft, int tx, int ty) {
 	}
 }
 
+void UIComboBox::handleTouch(TFT_eSPI& tft, int tx, int ty, bool pressed) {
+    if (!enabled) return;
+    _touchX = tx;
+    _touchY = ty;
+
+    if (pressed && !_touchPressed) {
+        _touchPressed = true;
+        _touchDownX = tx;
+        _touchDownY = ty;
+        _dragAppliedY = ty;
+        // Un appui pendant l'inertie l'arrête sans sélectionner d'élément.
+        _touchStoppedFling = _flinging;
+        _flinging = false;
+        _velocity = 0.0f;
+        _flingRemainder = 0.0f;
+
+        const Layout& geometry = layout();
+        int listTopY = geometry.listTopY;
+        int visibleListHeight = geometry.listHeight;
+        int scrollBarX = geometry.scrollBarX;
+        bool inList = _isExpanded && tx >= rect.x && tx <= rect.x + rect.w && ty >= listTopY && ty < listTopY + visibleListHeight;
+        if (inList && hasScrollBar() && tx >= scrollBarX) {
+            _touchMode = TOUCH_DRAG_SCROLLBAR;
+            scrollToScrollBarY(ty);
+        } else {
+            _touchMode = inList && hasScrollBar() ? TOUCH_PENDING : TOUCH_TAP;
+        }
+    } else if (!pressed && _touchPressed) {
+        _touchPressed = false;
+        // Le dernier échantillon n'a peut-être pas encore été appliqué par updateScroll().
+        applyTouchMove();
+        if (_touchMode == TOUCH_DRAG_LIST) {
+            _flinging = _kineticScrolling && fabsf(_velocity) >= FLING_MIN_VELOCITY;
+        } else if (_touchMode != TOUCH_DRAG_SCROLLBAR && !_touchStoppedFling) {
+            handlePress(tft, _touchDownX, _touchDownY); // Appui bref : sélection, dépliage ou repliement
+        }
+        _touchMode = TOUCH_IDLE;
+    }
+}
+
+bool UIComboBox::updateScroll(unsigned long nowMs) {
+    unsigned long elapsedMs = std::min(nowMs - _lastScrollUpdateMs, MAX_STEP_MS);
+    _lastScrollUpdateMs = nowMs;
+    if (elapsedMs == 0) elapsedMs = 1;
+    int previousPosition = scrollPosition();
+
+    if (_touchPressed) {
+        // Tous les échantillons reçus depuis la dernière image sont appliqués en une fois.
+        int moved = applyTouchMove();
+        if (_touchMode == TOUCH_DRAG_LIST) {
+            float sample = (float)moved / (float)elapsedMs;
+            _velocity = _velocity * VELOCITY_SMOOTHING + sample * (1.0f - VELOCITY_SMOOTHING);
+        }
+    } else if (_flinging) {
+        _flingRemainder += _velocity * elapsedMs;
+        int step = (int)_flingRemainder;
+        _flingRemainder -= step;
+        setScrollPosition(previousPosition + step);
+        _velocity *= powf(FLING_DECAY_PER_FRAME, elapsedMs / FRAME_MS);
+        bool hitEdge = scrollPosition() != previousPosition + step;
+        if (hitEdge || fabsf(_velocity) < FLING_STOP_VELOCITY) {
+            _flinging = false;
+            _velocity = 0.0f;
+        }
+    }
+    return scrollPosition() != previousPosition;
+}
+
+bool UIComboBox::isScrolling() const {
+    return _flinging || _touchMode == TOUCH_DRAG_LIST || _touchMode == TOUCH_DRAG_SCROLLBAR;
+}
+
+void UIComboBox::setKineticScrolling(bool enable) {
+    _kineticScrolling = enable;
+    if (!enable) {
+        _flinging = false;
+        _velocity = 0.0f;
+    }
+}
+
+int UIComboBox::applyTouchMove() {
+    if (_touchMode == TOUCH_PENDING && std::abs(_touchY - _touchDownY) >= DRAG_START_THRESHOLD) {
+        _touchMode = TOUCH_DRAG_LIST;
+    }
+    if (_touchMode == TOUCH_DRAG_LIST) {
+        // Le contenu suit le doigt : un glissement vers le haut fait avancer la liste.
+        int moved = _dragAppliedY - _touchY;
+        _dragAppliedY = _touchY;
+        int previousPosition = scrollPosition();
+        setScrollPosition(previousPosition + moved);
+        // Seul le déplacement effectif compte : tirer la liste contre une butée ne lance pas d'inertie.
+        return scrollPosition() - previousPosition;
+    }
+    if (_touchMode == TOUCH_DRAG_SCROLLBAR) {
+        scrollToScrollBarY(_touchY);
+    }
+    return 0;
+}
+
+void UIComboBox::scrollToScrollBarY(int ty) {
+    const Layout& geometry = layout();
+    int listTopY = geometry.listTopY;
+    int visibleListHeight = geometry.listHeight;
+    if (visibleListHeight <= 0) return;
+    float ratio = (float)(ty - listTopY) / visibleListHeight;
+    ratio = std::max(0.0f, std::min(1.0f, ratio));
+    setScrollPosition((int)(maxScrollPosition() * ratio + 0.5f));
+}
+
+void UIComboBox::expand() {
+    if (_isExpanded) return;
+    _isExpanded = true;
+    if (_underlayRestorePending) {
+        // Repliée puis dépliée sans dessin intermédiaire : la liste est toujours à l'écran
+        // et la sauvegarde décrit encore la zone qu'elle recouvre.
+        _underlayRestorePending = false;
+    } else if (_backgroundRestore) {
+        _underlayCapturePending = true;
+    }
+    // Réinitialiser le scrollOffset lors de l'expansion
+    _scrollOffset = 0;
+    _scrollPixel = 0;
+    updateHeight();
+    invalidate(DIRTY_FULL);
+}
+
 bool UIComboBox::isExpanded() const {
     return _isExpanded;
 }
@@ -285,18 +1848,35 @@ bool UIComboBox::isExpanded() const {
 void UIComboBox::collapse() {
     if (_isExpanded) {
         // Avant de replier, on mémorise la zone qu'occupait la liste.
-        UIRect dropdownListRect = {
-            rect.x,
-            rect.y + _collapsedHeight,
-            rect.w,
-            (int)(std::min((int)_items.size(), _maxVisibleItems) * _style.itemHeight)
-        };
+        UIRect listRect = dropdownListRect();
+        // La zone est restaurée au prochain dessin si elle a été entièrement sauvegardée.
+        _underlayCapturePending = false;
+        bool restoreUnderlay = _underlay.covers(listRect);
+        if (restoreUnderlay) {
+            _underlayRestorePending = true;
+        } else {
+            _underlay.clear();
+        }
 
         _isExpanded = false;
+        // Un glissement ou une inertie en cours s'arrête avec la liste.
+        _touchMode = TOUCH_IDLE;
+        _flinging = false;
+        _velocity = 0.0f;
+        _scrollPixel = 0;
+        // La saisie du filtre s'arrête avec la liste : la vue complète est rétablie.
+        if (_filterLength > 0) {
+            _filterLength = 0;
+            _filterText[0] = '\0';
+            _filterActive = false;
+        }
         updateHeight();
-        setDirty(true);
-        if (_onCollapseCallback) {
-            _onCollapseCallback(dropdownListRect); // On passe la région à nettoyer
+        // Les tampons de rendu ne sont utiles que liste dépliée.
+        releaseRenderBuffers();
+        // La zone de la liste est rendue à l'application : seul l'en-tête est à repeindre.
+        invalidate(DIRTY_HEADER_TEXT | DIRTY_ARROW);
+        if (_onCollapseCallback && !restoreUnderlay) {
+            _onCollapseCallback(listRect); // On passe la région à nettoyer
         }
     }
 }
\ No newline at end of file
@@ -13,21 +13,21 @@
 #include <UITextComponent.h>
 #include <U8g2_for_TFT_eSPI.h>
 #include "UIComboBoxStyle.h"
+#include "UIComboBoxTextCache.h"
+#include "UIComboBoxItemProvider.h"
+#include "UIComboBoxItemStore.h"
+#include "UIComboBoxPrefixIndex.h"
+#include "UIComboBoxSortIndex.h"
+#include "UIComboBoxStats.h"
+#include "UIComboBoxUnderlay.h"
+#include "UIComboBoxDirtyRegion.h"
 #include <vector>
 #include <functional>
 #include <memory>
+#include <initializer_list>
+#include <iterator>
+#include <unordered_map>
  
-/**
- * @struct UIComboBoxItem
- * @brief Structure représentant un élément individuel dans la liste déroulante (UIComboBox).
- *
- * Chaque élément est composé d'un texte affichable et d'une valeur entière associée.
- */
-struct UIComboBoxItem {
-    String text; /**< Le texte affiché pour cet élément. */
-    int value;   /**< La valeur entière associée à cet élément. */
-};
-
 /**
  * @class UIComboBox
  * @brief Un composant d'interface utilisateur de type liste déroulante (select/combo box).
@@ -58,6 +58,16 @@ public:
      * @param style Le style visuel du ComboBox, défini par UIComboBoxStyle.
      */
     UIComboBox(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String& labelText, const UIComboBoxStyle& style);
+    /**
+     * @brief Constructeur partageant un style existant au lieu de le copier.
+     * Plusieurs composants d'un même thème peuvent ainsi référencer un seul style, par exemple
+     * un `static const UIComboBoxStyle` placé en mémoire flash, sans en garder chacun une copie.
+     * @param u8f Référence à l'objet U8g2_for_TFT_eSPI utilisé pour le rendu du texte.
+     * @param rect La position et les dimensions du composant ComboBox.
+     * @param labelText Le texte de l'étiquette affichée au-dessus du ComboBox.
+     * @param sharedStyle Le style visuel, qui doit rester valide et inchangé pendant toute la vie du composant.
+     */
+    UIComboBox(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String& labelText, const UIComboBoxStyle* sharedStyle);
     /**
      * @brief Destructeur par défaut de la classe UIComboBox.
      */
@@ -69,6 +79,193 @@ public:
      * @param value La valeur entière associée à l'élément.
      */
     void addItem(const String& text, int value);
+    /**
+     * @brief Ajoute un nouvel élément à la liste déroulante à partir d'une chaîne C.
+     * @param text Le texte à afficher pour l'élément, copié dans la liste.
+     * @param value La valeur entière associée à l'élément.
+     */
+    void addItem(const char* text, int value);
+    /**
+     * @brief Réserve la mémoire de la liste interne avant une série d'ajouts.
+     * @param itemCount Nombre total d'éléments attendus.
+     * @param textBytes Nombre total d'octets de texte attendus.
+     */
+    void reserveItems(size_t itemCount, size_t textBytes = 0);
+    /**
+     * @brief Ajoute une série d'éléments en une seule opération.
+     * Le composant n'est invalidé qu'une fois. Pour une plage parcourable plusieurs fois (itérateurs
+     * « forward » ou mieux), la mémoire est aussi réservée une fois pour toute la série ; une plage
+     * à passage unique (lecture d'un flux, par exemple) n'est parcourue qu'une fois, sans réservation.
+     * @param first Itérateur sur le premier élément ; chaque élément expose `text` (String ou const char*) et `value`.
+     * @param last Itérateur suivant le dernier élément.
+     */
+    template <typename InputIt>
+    void addItems(InputIt first, InputIt last);
+    /**
+     * @brief Ajoute une série d'éléments donnée sous forme de liste d'initialisation.
+     * @param items Les éléments à ajouter.
+     */
+    void addItems(std::initializer_list<UIComboBoxItem> items);
+    /**
+     * @brief Ajoute les éléments d'un vecteur dont le composant prend possession.
+     * Les textes sont copiés dans la liste interne puis le vecteur est vidé et sa mémoire libérée.
+     * @param items Le vecteur d'éléments, vide au retour.
+     */
+    void addItems(std::vector<UIComboBoxItem>&& items);
+    /**
+     * @brief Retourne la mémoire occupée par la liste interne des éléments.
+     * @return La taille en octets.
+     */
+    size_t getItemsMemoryUsage() const;
+    /**
+     * @brief Insère un élément à une position donnée de la liste interne.
+     * La sélection reste sur le même élément et seules les lignes décalées sont redessinées.
+     * @param index La position d'insertion, ramenée entre 0 et le nombre d'éléments.
+     * @param text Le texte à afficher pour l'élément.
+     * @param value La valeur entière associée à l'élément.
+     */
+    void insertItem(int index, const String& text, int value);
+    /**
+     * @brief Supprime un élément de la liste interne.
+     * Si l'élément supprimé était sélectionné, la sélection passe à l'élément suivant (ou au dernier)
+     * et le rappel de sélection est déclenché.
+     * @param index L'index de l'élément à supprimer.
+     * @return `true` si l'élément a été supprimé, `false` si l'index est invalide.
+     */
+    bool removeItem(int index);
+    /**
+     * @brief Remplace le texte et la valeur d'un élément de la liste interne.
+     * Seule la ligne de l'élément est redessinée ; la sélection n'est pas modifiée.
+     * @param index L'index de l'élément à modifier.
+     * @param text Le nouveau texte.
+     * @param value La nouvelle valeur.
+     * @return `true` si l'élément a été modifié, `false` si l'index est invalide.
+     */
+    bool updateItem(int index, const String& text, int value);
+    /**
+     * @brief Supprime tous les éléments de la liste interne.
+     * Si un élément était sélectionné, le rappel de sélection est déclenché avec (-1, -1).
+     */
+    void clear();
+    /**
+     * @brief Retourne l'index du premier élément portant une valeur donnée.
+     * S'appuie sur un index valeur → position, reconstruit après chaque modification de la liste.
+     * @param value La valeur recherchée.
+     * @return L'index de l'élément, ou -1 si aucun élément ne porte cette valeur.
+     */
+    int indexOfValue(int value) const;
+    /**
+     * @brief Sélectionne le premier élément portant une valeur donnée.
+     * @param value La valeur de l'élément à sélectionner.
+     * @return `true` si un élément porte cette valeur, `false` sinon.
+     */
+    bool setSelectedValue(int value);
+    /**
+     * @brief Remplace la source des éléments par un fournisseur externe.
+     * Seules les lignes visibles et l'élément sélectionné sont interrogés, ce qui permet d'afficher
+     * de très grandes listes (table en Flash, générateur) sans les charger en RAM.
+     * Les éléments ajoutés par addItem ne sont plus affichés tant qu'un fournisseur externe est actif.
+     * @param provider Le fournisseur, qui doit rester valide tant qu'il est utilisé ;
+     *                 `nullptr` rétablit la liste interne alimentée par addItem.
+     */
+    void setItemProvider(UIComboBoxItemProvider* provider);
+    /**
+     * @brief Signale que le contenu du fournisseur d'éléments a changé (nombre, textes ou valeurs).
+     * La sélection et le défilement sont ramenés dans les limites et le composant est redessiné.
+     */
+    void notifyItemsChanged();
+
+    /**
+     * @brief Nombre maximal de caractères de la saisie du filtre.
+     */
+    static constexpr size_t MAX_FILTER_LENGTH = 32;
+    /**
+     * @brief Active le mode filtre (saisie prédictive).
+     * Les caractères saisis (clavier à l'écran, liaison série, encodeur) restreignent la liste aux
+     * éléments dont le texte commence par la saisie, sans tenir compte de la casse ASCII.
+     * Le filtrage s'appuie sur un index trié construit une fois par liste : chaque frappe est une
+     * recherche dichotomique. La vue filtrée est présentée dans l'ordre alphabétique.
+     * @param enable `true` pour activer le mode filtre, `false` pour le désactiver et libérer l'index.
+     */
+    void setFilterEnabled(bool enable);
+    /**
+     * @brief Indique si le mode filtre est activé.
+     */
+    bool isFilterEnabled() const;
+    /**
+     * @brief Ajoute un caractère à la saisie du filtre et restreint la vue en conséquence.
+     * @param c Le caractère saisi.
+     */
+    void appendFilterChar(char c);
+    /**
+     * @brief Supprime le dernier caractère de la saisie du filtre (retour arrière).
+     */
+    void removeFilterChar();
+    /**
+     * @brief Remplace la saisie du filtre.
+     * @param text Le nouveau texte du filtre, tronqué à MAX_FILTER_LENGTH caractères.
+     */
+    void setFilterText(const String& text);
+    /**
+     * @brief Efface la saisie du filtre et rétablit la liste complète.
+     */
+    void clearFilter();
+    /**
+     * @brief Retourne la saisie courante du filtre.
+     */
+    String getFilterText() const;
+    /**
+     * @brief Retourne le nombre d'éléments de la vue courante (filtrée ou complète).
+     */
+    int getFilteredCount() const;
+    /**
+     * @brief Critère de tri de la liste (voir UIComboBoxSortIndex::SortKey).
+     */
+    using SortKey = UIComboBoxSortIndex::SortKey;
+    /**
+     * @brief Type de comparateur d'un tri personnalisé (voir UIComboBoxSortIndex::Comparator).
+     */
+    using SortComparator = UIComboBoxSortIndex::Comparator;
+    /**
+     * @brief Type de rappel produisant le titre de section d'un élément (voir UIComboBoxSortIndex::SectionLabel).
+     */
+    using SectionLabel = UIComboBoxSortIndex::SectionLabel;
+    /**
+     * @brief Trie l'affichage de la liste par texte ou par valeur.
+     * Le tri porte sur une permutation d'index : les éléments gardent leur index (getSelectedIndex, removeItem…)
+     * et aucun texte n'est déplacé. L'élément sélectionné le reste et, s'il était visible, garde sa ligne à l'écran.
+     * Les ajouts, insertions et modifications suivants sont placés à leur rang par dichotomie, sans nouveau tri ;
+     * chacun reste en O(n) pour décaler la permutation (voir UIComboBoxSortIndex).
+     * La vue filtrée (setFilterEnabled) reste présentée dans l'ordre alphabétique.
+     * @param key Le critère : UIComboBoxSortIndex::SORT_TEXT, SORT_VALUE, ou SORT_NONE pour l'ordre de la liste.
+     * @param descending `true` pour l'ordre décroissant.
+     */
+    void setSortOrder(SortKey key, bool descending = false);
+    /**
+     * @brief Trie l'affichage de la liste avec un comparateur de l'application (voir setSortOrder).
+     * @param comparator Le comparateur, appelé avec des index d'éléments ; `nullptr` rétablit l'ordre de la liste.
+     * @param descending `true` pour inverser l'ordre du comparateur.
+     */
+    void setSortComparator(SortComparator comparator, bool descending = false);
+    /**
+     * @brief Retourne le critère de tri courant.
+     */
+    SortKey getSortKey() const { return _sortIndex.sortKey(); }
+    /**
+     * @brief Indique si l'ordre de tri est décroissant.
+     */
+    bool isSortDescending() const { return _sortIndex.isDescending(); }
+    /**
+     * @brief Découpe la liste triée en sections, chacune précédée d'un en-tête non sélectionnable.
+     * Une section regroupe les éléments consécutifs de même titre. Sans effet tant qu'aucun tri n'est défini.
+     * @param enable `true` pour afficher les en-têtes.
+     * @param label Le rappel produisant le titre de section d'un élément ; par défaut, la première lettre de son texte.
+     */
+    void setSectionHeaders(bool enable, SectionLabel label = nullptr);
+    /**
+     * @brief Retourne le nombre total d'éléments, sans tenir compte du filtre.
+     */
+    int getItemCount() const { return itemCount(); }
     /**
      * @brief Définit l'élément sélectionné par son index.
      * Si l'index est valide, l'élément correspondant est sélectionné et la vue est mise à jour.
@@ -86,7 +283,7 @@ public:
      */
     int getSelectedValue() const;
     /**
-     * @brief Retourne le texte de l'élément actuellement sélectionné.
+     * @brief Retourne le texte de l'élément actuellement sélectionné, en entier quelle que soit sa longueur.
      * @return Le texte de l'élément sélectionné, ou "No selection" si aucun élément n'est sélectionné.
      */
     String getSelectedText() const;
@@ -102,6 +299,79 @@ public:
      */
     void setOnCollapse(CollapseCallback callback);
 
+    /**
+     * @brief Remplace le style visuel du ComboBox et redessine entièrement le composant.
+     * @param style Le nouveau style visuel.
+     */
+    void setStyle(const UIComboBoxStyle& style);
+    /**
+     * @brief Remplace le style visuel par un style partagé, sans le copier, et redessine entièrement le composant.
+     * @param sharedStyle Le nouveau style, qui doit rester valide et inchangé tant qu'il est utilisé.
+     */
+    void setStyle(const UIComboBoxStyle* sharedStyle);
+    /**
+     * @brief Retourne le style visuel courant.
+     */
+    const UIComboBoxStyle& getStyle() const { return *_style; }
+
+    /**
+     * @brief Active le défilement par copie de pixels de la liste dépliée.
+     * Lorsque la liste défile de N lignes, les lignes déjà affichées sont déplacées à l'écran
+     * (readRect/pushRect) et seules les lignes découvertes sont rastérisées avec U8g2.
+     * Nécessite un écran dont la mémoire graphique peut être relue (ligne MISO câblée, ex. ILI9341).
+     * @param enable `true` pour activer la copie, `false` (défaut) pour redessiner toutes les lignes.
+     */
+    void setBlitScrolling(bool enable);
+    /**
+     * @brief Active le rendu de la liste dépliée dans un sprite hors écran.
+     * La liste est composée dans un TFT_eSprite puis envoyée à l'écran en une seule fenêtre
+     * (par DMA si TFT_eSPI le prend en charge et que initDMA() a été appelé), ce qui supprime
+     * le scintillement à l'ouverture et réduit le nombre de transactions SPI.
+     * Si le budget ne permet pas de contenir toute la liste, elle est envoyée par bandes ;
+     * si aucune bande ne peut être allouée, le dessin direct est utilisé.
+     * @param enable `true` pour activer le rendu hors écran.
+     * @param maxBufferBytes Taille maximale du tampon du sprite, en octets (16 bits par pixel).
+     */
+    void setSpriteRendering(bool enable, size_t maxBufferBytes = 16384);
+    /**
+     * @brief Active ou désactive la sauvegarde des pixels recouverts par la liste dépliée.
+     * Au premier dessin de la liste, la zone qu'elle recouvre est relue et compressée ; au repliement,
+     * elle est recopiée à l'écran au dessin suivant et le rappel de repliement n'est pas appelé.
+     * Si la zone ne tient pas dans le budget, le rappel de repliement est appelé comme d'habitude.
+     * Nécessite un écran relisible (ILI9341 avec MISO câblé, par exemple).
+     * @param enable `true` pour activer la sauvegarde.
+     * @param maxBytes Taille maximale des données compressées, en octets.
+     */
+    void setBackgroundRestore(bool enable, size_t maxBytes = 8192);
+
+    /**
+     * @brief Active le cache des libellés pré-rastérisés des éléments.
+     * Chaque texte est rendu une seule fois en bitmap 1 bit, puis les lignes sont redessinées par copie
+     * du bitmap dans la couleur voulue. Les entrées sont invalidées si le texte ou la police change.
+     * @param budgetBytes Nombre maximal d'octets de bitmaps conservés ; 0 désactive et libère le cache.
+     */
+    void setTextCacheBudget(size_t budgetBytes);
+    /**
+     * @brief Retourne les statistiques du cache des libellés (succès, échecs, évictions, occupation).
+     * @return Les statistiques, toutes nulles si le cache est désactivé.
+     */
+    UIComboBoxTextCache::Stats getTextCacheStats() const;
+    /**
+     * @brief Remet à zéro les compteurs du cache des libellés.
+     */
+    void resetTextCacheStats();
+#if UICOMBOBOX_ENABLE_STATS
+    /**
+     * @brief Retourne les compteurs de rendu et d'interaction du composant.
+     * Disponible uniquement si UICOMBOBOX_ENABLE_STATS vaut 1.
+     */
+    const UIComboBoxStats& getStats() const;
+    /**
+     * @brief Remet à zéro les compteurs de rendu et d'interaction.
+     */
+    void resetStats();
+#endif
+
     /**
      * @brief Gère l'événement de pression tactile sur le composant.
      * Cette méthode est surchargée de UIComponent et gère l'expansion/repliement
@@ -111,6 +381,77 @@ public:
      * @param ty Coordonnée Y de la pression tactile.
      */
     void handlePress(TFT_eSPI& tft, int tx, int ty) override;
+    /**
+     * @brief Dessine une partie du travail en attente, dans la limite d'un budget de temps.
+     * Le travail est découpé en unités (boîte fermée, fond de la liste, barre de défilement, une ligne)
+     * dessinées dans cet ordre ; au moins une unité est dessinée par appel. Les modifications reçues
+     * entre deux appels sont fusionnées : un défilement reprend les lignes depuis le haut et un
+     * repliement abandonne les unités de la liste. Peut être combiné avec draw(), qui termine le travail en attente.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param budgetUs Temps maximal à consacrer au dessin, en microsecondes.
+     * @return `true` s'il reste du travail, `false` si l'affichage est à jour.
+     */
+    bool drawStep(TFT_eSPI& tft, uint32_t budgetUs);
+    /**
+     * @brief Indique s'il reste du travail de dessin commencé par drawStep().
+     */
+    bool hasPendingDraw() const;
+    /**
+     * @brief Indique si le composant a des modifications à dessiner, invalidées ou laissées en attente par drawStep().
+     */
+    bool needsRedraw() const;
+    /**
+     * @brief Redessine entièrement le composant, limité à une zone de l'écran.
+     * Sert à réparer la partie d'un composant recouverte puis découverte par un autre (voir UIComboBoxGroup).
+     * Le rendu par libellés mis en cache est désactivé pendant ce dessin, leur copie n'étant pas découpée.
+     * Les modifications en attente ne sont pas consommées : le prochain draw() les dessine toujours.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param clip La zone de l'écran à repeindre.
+     */
+    void drawClipped(TFT_eSPI& tft, const UIRect& clip);
+    /**
+     * @brief Retourne la zone de l'écran où le composant peut dessiner : son rectangle, étendu vers le haut
+     * jusqu'à l'étiquette (supposée pas plus large que le composant).
+     */
+    UIRect getPaintRect() const;
+    /**
+     * @brief Ajoute à une région les zones que le prochain draw(tft, false) repeindra entièrement d'après
+     * l'état du composant : composant complet, intérieur de la zone de texte ou du bouton, lignes invalidées,
+     * barre de défilement. Rien n'est ajouté si le composant n'a rien à dessiner.
+     * Les pixels recopiés depuis l'écran (défilement par copie, restauration du fond) ne sont pas comptés.
+     * Sert à UIComboBoxGroup pour ne pas repeindre deux fois la même zone.
+     * @param area La région à compléter.
+     * @return `false` si la région s'est remplie avant la fin : les zones ajoutées sont exactes, mais incomplètes.
+     */
+    bool getPendingArea(UIComboBoxDirtyRegion& area) const;
+    /**
+     * @brief Transmet un échantillon tactile brut (appui maintenu ou relâché) au composant.
+     * Les déplacements ne sont appliqués qu'au prochain appel de updateScroll(), une fois par image,
+     * quel que soit le nombre d'échantillons reçus entre-temps. Un appui bref se comporte comme
+     * handlePress() ; un glissement vertical sur la liste la fait défiler au pixel près et,
+     * relâché avec assez de vitesse, la laisse défiler par inertie.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param tx Coordonnée X du point de contact.
+     * @param ty Coordonnée Y du point de contact.
+     * @param pressed `true` tant que l'écran est touché, `false` au relâchement.
+     */
+    void handleTouch(TFT_eSPI& tft, int tx, int ty, bool pressed);
+    /**
+     * @brief Applique les échantillons tactiles en attente et fait avancer l'inertie.
+     * À appeler une fois par image, avant draw().
+     * @param nowMs L'instant courant, en millisecondes (millis()).
+     * @return `true` si la position de défilement a changé.
+     */
+    bool updateScroll(unsigned long nowMs);
+    /**
+     * @brief Indique si un glissement ou un défilement par inertie est en cours.
+     */
+    bool isScrolling() const;
+    /**
+     * @brief Active ou désactive le défilement par inertie après un glissement.
+     * @param enable `true` pour laisser la liste poursuivre son mouvement au relâchement (par défaut).
+     */
+    void setKineticScrolling(bool enable);
 
     /**
      * @brief Vérifie si la liste déroulante est actuellement étendue (dépliée).
@@ -118,12 +459,43 @@ public:
      * @return `true` si la liste est dépliée, `false` sinon.
      */
     bool isExpanded() const override;
+    /**
+     * @brief Déplie la liste déroulante si elle est actuellement repliée.
+     */
+    void expand();
     /**
      * @brief Replie la liste déroulante si elle est actuellement étendue.
      * Cette méthode est surchargée de UIComponent.
      */
     void collapse() override;
 
+protected:
+    // Notifications appelées juste après une modification du fournisseur courant, par addItem, insertItem,
+    // removeItem, updateItem et clear, ou par une classe dérivée gérant son propre stockage (UIComboBoxStatic).
+    /**
+     * @brief Signale l'insertion d'un élément. Seules les lignes décalées sont redessinées.
+     * @param index L'index de l'élément inséré.
+     */
+    void itemInserted(int index);
+    /**
+     * @brief Signale la suppression d'un élément. Si l'élément était sélectionné, la sélection passe
+     * à l'élément affiché à sa suite (ou au dernier) et le rappel de sélection est déclenché.
+     * @param index L'index qu'occupait l'élément.
+     * @param position La ligne de l'élément dans la vue complète, relevée avant la suppression
+     *                 (son index si la liste n'est pas triée).
+     */
+    void itemRemoved(int index, int position);
+    /**
+     * @brief Signale le changement du texte ou de la valeur d'un élément. La sélection n'est pas modifiée.
+     * @param index L'index de l'élément.
+     */
+    void itemUpdated(int index);
+    /**
+     * @brief Signale la suppression de tous les éléments. Si un élément était sélectionné,
+     * le rappel de sélection est déclenché avec (-1, -1).
+     */
+    void itemsCleared();
+
 private:
     /**
      * @brief Méthode interne pour dessiner le composant sur l'écran.
@@ -137,21 +509,422 @@ private:
      * @brief Met à jour la hauteur du composant en fonction de son état (replié ou étendu).
      */
     void updateHeight();
+    /**
+     * @brief Sauvegarde ou restaure la zone recouverte par la liste si une opération est en attente.
+     * @param tft Référence à l'objet TFT_eSPI.
+     * @return `true` si une opération a été effectuée.
+     */
+    bool updateUnderlay(TFT_eSPI& tft);
+    /**
+     * @brief Ajoute les régions invalidées depuis la dernière étape au travail de drawStep().
+     */
+    void mergeStepWork();
+    /**
+     * @brief Dessine la prochaine unité de travail de drawStep(), par ordre de priorité.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     */
+    void drawNextUnit(TFT_eSPI& tft);
+
+    /**
+     * @brief Régions du composant pouvant être invalidées indépendamment les unes des autres.
+     * Elles permettent à drawInternal de ne repeindre que ce qui a réellement changé.
+     */
+    enum DirtyRegion : uint8_t {
+        DIRTY_NONE        = 0,
+        DIRTY_HEADER_TEXT = 1 << 0, /**< Texte de l'élément sélectionné dans la boîte fermée. */
+        DIRTY_ARROW       = 1 << 1, /**< Bouton et flèche. */
+        DIRTY_ROWS        = 1 << 2, /**< Toutes les lignes visibles de la liste. */
+        DIRTY_SCROLLBAR   = 1 << 3, /**< Barre de défilement et son pouce. */
+        DIRTY_LIST        = 1 << 4, /**< Liste complète : fond, lignes, barre de défilement et bordure. */
+        DIRTY_SCROLL      = 1 << 5, /**< Le décalage de défilement a changé depuis le dernier dessin. */
+        DIRTY_FULL        = 1 << 7  /**< Composant complet, étiquette comprise. */
+    };
+
+    /**
+     * @brief Marque une ou plusieurs régions comme à redessiner.
+     * @param regions Combinaison de valeurs DirtyRegion.
+     */
+    void invalidate(uint8_t regions);
+    /**
+     * @brief Marque la ligne affichant l'élément donné comme à redessiner, si elle est visible.
+     * @param index L'index de l'élément concerné.
+     */
+    void invalidateItem(int index);
+    /**
+     * @brief Marque comme à redessiner les lignes visibles à partir d'une position de la vue.
+     * @param position La position de la première ligne ayant changé.
+     */
+    void invalidateRowsFrom(int position);
+    /**
+     * @brief Indique si la liste comporte plus d'éléments que le nombre visible.
+     * @return `true` si une barre de défilement est affichée.
+     */
+    bool hasScrollBar() const;
+    /**
+     * @brief Retourne la zone de l'écran occupée par la liste dépliée.
+     */
+    UIRect dropdownListRect() const;
+    /**
+     * @brief Retourne le nombre de lignes (entières ou partielles) occupées par la liste visible.
+     * @param scrollPixel Le décalage en pixels à l'intérieur de la première ligne.
+     */
+    int rowSlotCount(int scrollPixel) const;
+    /**
+     * @struct Layout
+     * @brief Géométrie et métriques de police dérivées du rectangle, du style et du nombre d'éléments.
+     * Recalculées uniquement lorsque l'une de ces données change, au lieu de l'être à chaque dessin et à chaque ligne.
+     */
+    struct Layout {
+        bool valid = false;        /**< Indique si les champs correspondent à l'état courant. */
+        int x = 0;                 /**< Position X du rectangle au moment du calcul. */
+        int y = 0;                 /**< Position Y du rectangle au moment du calcul. */
+        int w = 0;                 /**< Largeur du rectangle au moment du calcul. */
+        int rowCount = 0;          /**< Nombre de lignes de la vue complète (éléments et en-têtes de section) au moment du calcul. */
+        int visibleItemsCount = 0; /**< Nombre de lignes de la liste dépliée. */
+        int listTopY = 0;          /**< Haut de la liste dépliée. */
+        int listHeight = 0;        /**< Hauteur de la liste dépliée. */
+        int buttonX = 0;           /**< Bord gauche du bouton de la boîte fermée. */
+        int textAreaWidth = 0;     /**< Largeur de la zone de texte de la boîte fermée. */
+        int scrollBarX = 0;        /**< Bord gauche de la barre de défilement. */
+        int arrowX = 0;            /**< Coin supérieur gauche de la flèche, en X. */
+        int arrowY = 0;            /**< Coin supérieur gauche de la flèche, en Y. */
+        int labelY = 0;            /**< Ligne de base de l'étiquette. */
+        int labelTop = 0;          /**< Haut du texte de l'étiquette. */
+        int headerTextY = 0;       /**< Ligne de base du texte de la boîte fermée. */
+        int itemAscent = 0;        /**< Hauteur de la police des éléments au-dessus de la ligne de base. */
+        int itemDescent = 0;       /**< Profondeur (négative) de la police des éléments sous la ligne de base. */
+        int itemBaseline = 0;      /**< Ligne de base du texte d'un élément, relative au haut de sa ligne. */
+    };
+    /**
+     * @brief Retourne la géométrie courante, recalculée si le rectangle ou le nombre de lignes a changé
+     * ou si invalidateLayout() a été appelée. Le calcul sélectionne la police des éléments en dernier.
+     */
+    const Layout& layout() const;
+    /**
+     * @brief Force le recalcul de la géométrie au prochain appel de layout().
+     */
+    void invalidateLayout() { _layout.valid = false; }
+    /**
+     * @brief Met à jour l'état dépendant du style après un changement de style.
+     */
+    void styleChanged();
+    /**
+     * @brief Retourne la position de défilement en pixels depuis le haut de la vue.
+     */
+    int scrollPosition() const;
+    /**
+     * @brief Retourne la position de défilement maximale, en pixels.
+     */
+    int maxScrollPosition() const;
+    /**
+     * @brief Fait défiler la liste jusqu'à une position en pixels, bornée à la plage valide.
+     * @param position La nouvelle position, en pixels.
+     * @return `true` si la position a changé.
+     */
+    bool setScrollPosition(int position);
+    /**
+     * @brief Définit la bande verticale [top, bottom), en coordonnées de la cible, hors de laquelle les lignes ne sont pas dessinées.
+     */
+    void setRowClip(int top, int bottom);
+    /**
+     * @brief Applique le dernier échantillon tactile au glissement en cours.
+     * @return Le déplacement appliqué à la position de défilement, en pixels.
+     */
+    int applyTouchMove();
+    /**
+     * @brief Fait défiler la liste proportionnellement à une position verticale sur la barre de défilement.
+     * @param ty La coordonnée Y du point de contact.
+     */
+    void scrollToScrollBarY(int ty);
+    /**
+     * @brief Retourne le nombre d'éléments exposés par le fournisseur courant.
+     */
+    int itemCount() const;
+    /**
+     * @brief Retourne le nombre de lignes de la vue complète : éléments et, si la liste est triée, en-têtes de section.
+     */
+    int listRowCount() const;
+    /**
+     * @brief Met à jour la sélection et l'affichage après l'ajout d'éléments à la liste interne.
+     * @param count Le nombre d'éléments ajoutés en fin de liste.
+     */
+    void itemsAppended(size_t count);
+    /**
+     * @brief Retourne l'élément de la vue complète le plus proche d'une ligne, en cherchant d'abord vers le bas.
+     * @param row La ligne de départ.
+     * @return L'index de l'élément, ou -1 si la liste est vide.
+     */
+    int itemNearRow(int row) const;
+    /**
+     * @struct ViewAnchor
+     * @brief Élément servant de repère pour conserver la position de défilement lorsque l'ordre de la vue change.
+     */
+    struct ViewAnchor {
+        int itemIndex; /**< L'élément repère, -1 si aucun. */
+        int slot;      /**< Sa ligne à l'écran (0 = première ligne affichée). */
+    };
+    /**
+     * @brief Retourne le repère de la vue : l'élément sélectionné s'il est affiché, sinon le premier élément affiché.
+     */
+    ViewAnchor viewAnchor() const;
+    /**
+     * @brief Fait défiler la vue pour replacer le repère à sa ligne, dans les limites du défilement.
+     */
+    void restoreViewAnchor(const ViewAnchor& anchor);
+    /**
+     * @brief Reconstruit l'ordre de tri après un changement de critère ou de sections, en conservant le repère de la vue.
+     * @param anchor Le repère relevé avant le changement.
+     * @param previousRows Le nombre de lignes de la vue complète avant le changement.
+     */
+    void resort(const ViewAnchor& anchor, int previousRows);
+    /**
+     * @brief Invalide les index (valeurs, filtrage) après une modification de la liste et recalcule la vue filtrée.
+     * @param prefixIndexUpdated `true` si l'index de filtrage a déjà été mis à jour élément par élément.
+     */
+    void itemListChanged(bool prefixIndexUpdated = false);
+    /**
+     * @brief Recalcule la plage filtrée à partir de la saisie courante.
+     * @param narrowing `true` si la saisie prolonge la précédente, la recherche se limitant alors à la plage courante.
+     */
+    void applyFilter(bool narrowing);
+    /**
+     * @brief Retourne le nombre d'éléments de la vue affichée (filtrée ou complète).
+     */
+    int viewCount() const;
+    /**
+     * @brief Retourne l'index de l'élément affiché à une position de la vue.
+     * @param position La position dans la vue (0 = premier élément de la vue).
+     */
+    int viewItem(int position) const;
+    /**
+     * @brief Retourne la position d'un élément dans la vue affichée.
+     * @param itemIndex L'index de l'élément.
+     * @return La position dans la vue, ou -1 si l'élément n'y figure pas.
+     */
+    int viewPosition(int itemIndex) const;
+    /**
+     * @brief Accès uniforme au texte d'un élément, qu'il soit fourni en String ou en chaîne C.
+     */
+    static const char* itemTextData(const String& text) { return text.c_str(); }
+    static size_t itemTextLength(const String& text) { return text.length(); }
+    static const char* itemTextData(const char* text) { return text ? text : ""; }
+    static size_t itemTextLength(const char* text) { return text ? strlen(text) : 0; }
+    /**
+     * @brief Réserve la mémoire d'une plage d'éléments parcourable plusieurs fois, avant son ajout par addItems().
+     */
+    template <typename ForwardIt>
+    void reserveRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+    /**
+     * @brief Plage à passage unique : rien n'est réservé, la plage ne pouvant être parcourue qu'une fois.
+     */
+    template <typename InputIt>
+    void reserveRange(InputIt first, InputIt last, std::input_iterator_tag);
+    /**
+     * @brief Copie le texte affiché d'un élément dans un tampon de ITEM_TEXT_BUFFER_SIZE (128) octets.
+     * Un texte plus long, au-delà de la largeur de la liste, est coupé à la fin du dernier caractère
+     * UTF-8 complet ; getSelectedText() retourne le texte entier.
+     * @param index L'index de l'élément.
+     * @param buffer Le tampon de destination.
+     * @return Le nombre d'octets copiés.
+     */
+    size_t itemText(int index, char* buffer) const;
 
-    UIComboBoxStyle _style; /**< Le style visuel actuel du ComboBox. */
-    std::vector<UIComboBoxItem> _items; /**< La liste des éléments disponibles dans le ComboBox. */
+    /**
+     * @brief Dessine l'étiquette au-dessus du composant.
+     */
+    void drawLabel();
+    /**
+     * @brief Dessine la boîte fermée complète : fond, bordure, texte sélectionné et flèche.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     */
+    void drawHeader(TFT_eSPI& tft);
+    /**
+     * @brief Dessine le texte de l'élément sélectionné dans la boîte fermée.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param clearBackground Efface l'intérieur de la zone de texte avant d'écrire.
+     */
+    void drawHeaderText(TFT_eSPI& tft, bool clearBackground);
+    /**
+     * @brief Dessine la flèche du bouton selon l'état déplié/replié.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param clearBackground Efface l'intérieur du bouton avant de tracer la flèche.
+     */
+    void drawArrowButton(TFT_eSPI& tft, bool clearBackground);
+    /**
+     * @brief Dessine la liste dépliée complète : fond, lignes, barre de défilement et bordure.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     */
+    void drawList(TFT_eSPI& tft);
+    /**
+     * @brief Rastérise la bande [fromLine, toLine) de la liste dépliée sur la cible donnée.
+     * Les coordonnées sont décalées de (_renderOffsetX, _renderOffsetY) pour dessiner dans un sprite.
+     * @param gfx La cible du dessin : l'écran ou le sprite hors écran.
+     * @param fromLine Première ligne de pixels de la bande, relative au haut de la liste.
+     * @param toLine Ligne de pixels suivant la dernière ligne de la bande.
+     */
+    void renderList(TFT_eSPI& gfx, int fromLine, int toLine);
+    /**
+     * @brief Dessine la liste dépliée via le sprite hors écran, par bandes si nécessaire.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @return `true` si la liste a été dessinée, `false` si le sprite n'a pas pu être alloué.
+     */
+    bool drawListBuffered(TFT_eSPI& tft);
+    /**
+     * @brief Envoie les premières lignes du sprite à l'écran en une seule fenêtre.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param x Position X de destination.
+     * @param y Position Y de destination.
+     * @param lines Nombre de lignes de pixels à envoyer.
+     */
+    void pushSpriteStrip(TFT_eSPI& tft, int x, int y, int lines);
+    /**
+     * @brief Libère le tampon de copie et le sprite hors écran.
+     */
+    void releaseRenderBuffers();
+    /**
+     * @brief Dessine une ligne visible de la liste (fond et texte), limitée à la bande définie par setRowClip().
+     * La police des éléments doit déjà être sélectionnée.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param slot La position de la ligne dans la liste visible (0 = première ligne affichée).
+     */
+    void drawItemRow(TFT_eSPI& tft, int slot);
+    /**
+     * @brief Déplace à l'écran les lignes de pixels restant visibles après un défilement de deltaPixels pixels.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @param deltaPixels Nombre de pixels défilés (positif : la liste avance, négatif : elle recule).
+     * @return `true` si la copie a été effectuée, `false` si le tampon n'a pas pu être alloué.
+     */
+    bool blitLines(TFT_eSPI& tft, int deltaPixels);
+    /**
+     * @brief Dessine le texte d'un élément à partir du cache des libellés, en le rastérisant au besoin.
+     * @param gfx La cible du dessin : l'écran ou le sprite hors écran.
+     * @param itemIndex L'index de l'élément.
+     * @param text Le texte de l'élément.
+     * @param x Position X du début du texte.
+     * @param baselineY Position Y de la ligne de base du texte.
+     * @param maxWidth Largeur maximale du texte, au-delà de laquelle il est tronqué.
+     * @param fgColor Couleur du texte.
+     * @param bgColor Couleur du fond de la ligne.
+     * @return `true` si le texte a été dessiné, `false` s'il doit être rendu par U8g2.
+     */
+    bool drawCachedItemText(TFT_eSPI& gfx, int itemIndex, const char* text, int x, int baselineY, int maxWidth, uint16_t fgColor, uint16_t bgColor);
+    /**
+     * @brief Rend le texte d'un élément dans un bitmap 1 bit et l'ajoute au cache.
+     * @param gfx La cible courante du rendu U8g2, rétablie après le rendu.
+     * @param itemIndex L'index de l'élément.
+     * @param text Le texte à rendre.
+     * @param textHash L'empreinte du texte.
+     * @param maxWidth Largeur maximale du bitmap.
+     * @return L'entrée créée, ou `nullptr` si le libellé n'a pas pu être mis en cache.
+     */
+    const UIComboBoxTextCache::Entry* rasterizeItemText(TFT_eSPI& gfx, int itemIndex, const char* text, uint32_t textHash, int maxWidth);
+    /**
+     * @brief Copie un libellé mis en cache à l'écran ou dans le sprite.
+     * @param gfx La cible du dessin.
+     * @param entry Le libellé à copier.
+     * @param x Position X du coin supérieur gauche.
+     * @param y Position Y du coin supérieur gauche.
+     * @param fgColor Couleur des pixels allumés.
+     * @param bgColor Couleur des pixels éteints.
+     */
+    void blitTextBitmap(TFT_eSPI& gfx, const UIComboBoxTextCache::Entry& entry, int x, int y, uint16_t fgColor, uint16_t bgColor);
+
+    std::unique_ptr<UIComboBoxStyle> _ownedStyle; /**< Copie du style, nulle lorsque le style est partagé. */
+    const UIComboBoxStyle* _style; /**< Le style visuel actuel du ComboBox (copie possédée ou style partagé). */
+    mutable Layout _layout; /**< La géométrie mise en cache par layout(). */
+    UIComboBoxItemStore _items; /**< La liste interne des éléments, alimentée par addItem. */
+    UIComboBoxItemProvider* _provider = &_items; /**< Le fournisseur d'éléments courant. */
     int _selectedIndex = -1; /**< L'index de l'élément actuellement sélectionné. -1 si aucun. */
     bool _isExpanded = false; /**< Indique si la liste déroulante est actuellement étendue (dépliée). */
 
     int _collapsedHeight; /**< La hauteur du ComboBox lorsqu'il est replié. */
     int _maxVisibleItems; /**< Le nombre maximal d'éléments visibles lorsque la liste est étendue. */
     int _scrollOffset = 0; /**< Le décalage de défilement actuel pour les éléments de la liste. */
+    int _scrollPixel = 0; /**< Décalage en pixels à l'intérieur de la première ligne visible (0 à itemHeight - 1). */
     int _scrollBarWidth; /**< La largeur de la barre de défilement. */
     uint16_t _scrollBarColor; /**< La couleur de la barre de défilement. */
 
+    uint8_t _dirtyRegions = DIRTY_FULL; /**< Régions (DirtyRegion) à redessiner au prochain appel de draw. */
+    uint32_t _dirtyRows = 0; /**< Masque des lignes visibles à redessiner (bit n = n-ième ligne affichée). */
+    int _drawnScrollOffset = 0; /**< Le décalage de défilement correspondant aux lignes actuellement à l'écran. */
+    int _drawnScrollPixel = 0; /**< Le décalage en pixels correspondant aux lignes actuellement à l'écran. */
+    uint8_t _stepRegions = DIRTY_NONE; /**< Régions restant à dessiner par drawStep(). */
+    uint32_t _stepRows = 0; /**< Lignes restant à dessiner par drawStep() (bit n = n-ième ligne affichée). */
+    int _stepNextSlot = 0; /**< Prochaine ligne à dessiner lorsque toutes les lignes sont à reprendre. */
+    int _clipTop = 0; /**< Haut de la bande dans laquelle les lignes sont dessinées. */
+    int _clipBottom = 0; /**< Bas (exclu) de la bande dans laquelle les lignes sont dessinées. */
+    bool _drawClipActive = false; /**< Indique si le dessin en cours est limité à _drawClip (drawClipped()). */
+    UIRect _drawClip = {0, 0, 0, 0}; /**< La zone de l'écran à laquelle le dessin en cours est limité. */
+
+    /**
+     * @brief Interprétation de l'appui tactile en cours.
+     */
+    enum TouchMode : uint8_t {
+        TOUCH_IDLE,           /**< Aucun appui. */
+        TOUCH_TAP,            /**< Appui traité comme un clic au relâchement. */
+        TOUCH_PENDING,        /**< Appui sur la liste, clic ou début de glissement. */
+        TOUCH_DRAG_LIST,      /**< Glissement du contenu de la liste. */
+        TOUCH_DRAG_SCROLLBAR  /**< Glissement sur la barre de défilement. */
+    };
+    uint8_t _touchMode = TOUCH_IDLE; /**< L'interprétation de l'appui en cours (TouchMode). */
+    bool _touchPressed = false; /**< Indique si l'écran est actuellement touché. */
+    bool _touchStoppedFling = false; /**< Indique si l'appui en cours a interrompu une inertie. */
+    int _touchDownX = 0; /**< Coordonnée X du début de l'appui. */
+    int _touchDownY = 0; /**< Coordonnée Y du début de l'appui. */
+    int _touchX = 0; /**< Coordonnée X du dernier échantillon reçu. */
+    int _touchY = 0; /**< Coordonnée Y du dernier échantillon reçu. */
+    int _dragAppliedY = 0; /**< Coordonnée Y du dernier échantillon appliqué au défilement. */
+    bool _kineticScrolling = true; /**< Indique si le défilement par inertie est activé. */
+    bool _flinging = false; /**< Indique si la liste défile par inertie. */
+    float _velocity = 0.0f; /**< Vitesse de défilement, en pixels par milliseconde. */
+    float _flingRemainder = 0.0f; /**< Fraction de pixel accumulée par l'inertie. */
+    unsigned long _lastScrollUpdateMs = 0; /**< Instant du dernier appel de updateScroll(). */
+
+    bool _blitScrolling = false; /**< Indique si le défilement par copie de pixels est activé. */
+    std::unique_ptr<uint16_t[]> _blitBuffer; /**< Tampon d'une bande de lignes utilisé pour la copie. */
+    int _blitBufferPixels = 0; /**< Capacité du tampon de copie, en pixels. */
+
+    bool _spriteRendering = false; /**< Indique si la liste est composée dans un sprite hors écran. */
+    size_t _spriteBudgetBytes = 0; /**< Taille maximale du tampon du sprite, en octets. */
+    std::unique_ptr<TFT_eSprite> _sprite; /**< Le sprite hors écran, conservé tant que la liste est dépliée. */
+    int _renderOffsetX = 0; /**< Décalage X soustrait aux coordonnées lors du rendu dans le sprite. */
+    int _renderOffsetY = 0; /**< Décalage Y soustrait aux coordonnées lors du rendu dans le sprite. */
+
+    bool _backgroundRestore = false; /**< Indique si les pixels recouverts par la liste sont sauvegardés. */
+    size_t _underlayBudgetBytes = 0; /**< Taille maximale de la sauvegarde compressée, en octets. */
+    UIComboBoxUnderlay _underlay; /**< Les pixels recouverts par la liste dépliée. */
+    bool _underlayCapturePending = false; /**< La zone doit être sauvegardée au prochain dessin. */
+    bool _underlayRestorePending = false; /**< La zone doit être restaurée au prochain dessin. */
+
+    std::unique_ptr<UIComboBoxTextCache> _textCache; /**< Le cache des libellés rastérisés, nul si désactivé. */
+
+    bool _filterEnabled = false; /**< Indique si le mode filtre est activé. */
+    bool _filterActive = false; /**< Indique si la vue est actuellement restreinte par une saisie. */
+    char _filterText[MAX_FILTER_LENGTH + 1] = {}; /**< La saisie courante du filtre. */
+    size_t _filterLength = 0; /**< La longueur de la saisie courante. */
+    UIComboBoxPrefixIndex _prefixIndex; /**< L'index trié servant au filtrage par préfixe. */
+    UIComboBoxSortIndex _sortIndex; /**< L'ordre de tri de la vue complète, vide si la liste n'est pas triée. */
+    size_t _filterFirst = 0; /**< Début de la plage filtrée dans l'index trié. */
+    size_t _filterLast = 0; /**< Fin (exclue) de la plage filtrée dans l'index trié. */
+
+    mutable std::unordered_map<int, int> _valueIndex; /**< Index valeur → position du premier élément portant cette valeur. */
+    mutable bool _valueIndexValid = false; /**< Indique si _valueIndex correspond à la liste courante. */
+
     SelectCallback _onSelectCallback = nullptr; /**< La fonction de rappel pour l'événement de sélection. */
     CollapseCallback _onCollapseCallback = nullptr; /**< La fonction de rappel pour l'événement de repliement. */
 
+#if UICOMBOBOX_ENABLE_STATS
+    UIComboBoxStats _stats; /**< Les compteurs de rendu et d'interaction. */
+
+    /**
+     * @brief Compte un appel de primitive et, s'il vise l'écran, les pixels écrits.
+     * @param calls Le compteur d'appels à incrémenter.
+     * @param gfx La cible du dessin (écran ou sprite hors écran).
+     * @param pixels Le nombre de pixels touchés.
+     */
+    void countPrimitive(uint32_t& calls, const TFT_eSPI& gfx, int pixels);
+#endif
+
     /**
      * @brief Dessine la barre de défilement si nécessaire.
      * @param tft Référence à l'objet TFT_eSPI pour le dessin.
@@ -159,4 +932,29 @@ private:
     void drawScrollBar(TFT_eSPI& tft);
 };
 
+template <typename InputIt>
+void UIComboBox::addItems(InputIt first, InputIt last) {
+    reserveRange(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    // Les éléments sont comptés pendant l'ajout : une plage à passage unique n'est parcourue qu'une fois.
+    size_t count = 0;
+    for (; first != last; ++first, ++count) {
+        _items.add(itemTextData(first->text), itemTextLength(first->text), first->value);
+    }
+    itemsAppended(count);
+}
+
+template <typename ForwardIt>
+void UIComboBox::reserveRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+    size_t count = 0;
+    size_t textBytes = 0;
+    for (ForwardIt it = first; it != last; ++it) {
+        ++count;
+        textBytes += itemTextLength(it->text);
+    }
+    _items.reserve(_items.size() + count, _items.textBytes() + textBytes);
+}
+
+template <typename InputIt>
+void UIComboBox::reserveRange(InputIt, InputIt, std::input_iterator_tag) {}
+
 #endif // UICOMBOBOX_H
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "UIComboBoxAsync.h"
+
+#if !defined(ESP32)
+#include <chrono>
+#endif
+
+UIComboBoxAsync::UIComboBoxAsync(UIComboBox& comboBox)
+    : _comboBox(comboBox)
+{
+    publishState();
+}
+
+UIComboBoxAsync::~UIComboBoxAsync() {
+    stop();
+}
+
+bool UIComboBoxAsync::start(TFT_eSPI& tft, uint32_t framePeriodMs, int core, uint32_t stackSize) {
+    if (isRunning()) return false;
+    _tft = &tft;
+    _framePeriodMs = framePeriodMs > 0 ? framePeriodMs : 1;
+    _running.store(true, std::memory_order_release);
+#if defined(ESP32)
+    _taskFinished.store(false, std::memory_order_release);
+    if (xTaskCreatePinnedToCore(taskEntry, "UIComboBox", stackSize, this, 1, &_task, core) != pdPASS) {
+        _task = nullptr;
+        _taskFinished.store(true, std::memory_order_release);
+        _running.store(false, std::memory_order_release);
+        return false;
+    }
+#else
+    (void)core;
+    (void)stackSize;
+    _thread = std::thread(&UIComboBoxAsync::run, this);
+#endif
+    return true;
+}
+
+void UIComboBoxAsync::stop() {
+    if (!isRunning()) return;
+    _running.store(false, std::memory_order_release);
+#if defined(ESP32)
+    // La tâche se supprime elle-même en quittant sa boucle.
+    while (!_taskFinished.load(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+    _task = nullptr;
+#else
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+#endif
+}
+
+#if defined(ESP32)
+void UIComboBoxAsync::taskEntry(void* arg) {
+    UIComboBoxAsync* self = static_cast<UIComboBoxAsync*>(arg);
+    self->run();
+    self->_taskFinished.store(true, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+#endif
+
+void UIComboBoxAsync::run() {
+    while (_running.load(std::memory_order_acquire)) {
+        unsigned long frameStart = millis();
+        renderFrame(*_tft);
+        unsigned long elapsed = millis() - frameStart;
+        uint32_t waitMs = elapsed < _framePeriodMs ? _framePeriodMs - elapsed : 1;
+#if defined(ESP32)
+        vTaskDelay(pdMS_TO_TICKS(waitMs) > 0 ? pdMS_TO_TICKS(waitMs) : 1);
+#else
+        std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+#endif
+    }
+}
+
+void UIComboBoxAsync::renderFrame(TFT_eSPI& tft) {
+    Command command;
+    while (_queue.pop(command)) {
+        apply(tft, command);
+    }
+    _comboBox.updateScroll(millis());
+    _comboBox.draw(tft, false);
+    publishState();
+}
+
+bool UIComboBoxAsync::post(Command::Type type, int a, int b, int c, const char* text) {
+    Command command;
+    command.type = type;
+    command.a = a;
+    command.b = b;
+    command.c = c;
+    command.text[0] = '\0';
+    if (text) {
+        strncpy(command.text, text, TEXT_SIZE - 1);
+        command.text[TEXT_SIZE - 1] = '\0';
+    }
+    if (!_queue.push(command)) {
+        _droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool UIComboBoxAsync::handlePress(int tx, int ty) { return post(Command::PRESS, tx, ty); }
+bool UIComboBoxAsync::handleTouch(int tx, int ty, bool pressed) { return post(Command::TOUCH, tx, ty, pressed); }
+bool UIComboBoxAsync::setSelectedIndex(int index) { return post(Command::SET_SELECTED_INDEX, index); }
+bool UIComboBoxAsync::setSelectedValue(int value) { return post(Command::SET_SELECTED_VALUE, value); }
+bool UIComboBoxAsync::addItem(const char* text, int value) { return post(Command::ADD_ITEM, 0, value, 0, text); }
+bool UIComboBoxAsync::insertItem(int index, const char* text, int value) { return post(Command::INSERT_ITEM, index, value, 0, text); }
+bool UIComboBoxAsync::removeItem(int index) { return post(Command::REMOVE_ITEM, index); }
+bool UIComboBoxAsync::updateItem(int index, const char* text, int value) { return post(Command::UPDATE_ITEM, index, value, 0, text); }
+bool UIComboBoxAsync::clear() { return post(Command::CLEAR); }
+bool UIComboBoxAsync::expand() { return post(Command::EXPAND); }
+bool UIComboBoxAsync::collapse() { return post(Command::COLLAPSE); }
+
+void UIComboBoxAsync::apply(TFT_eSPI& tft, const Command& command) {
+    switch (command.type) {
+        case Command::PRESS:              _comboBox.handlePress(tft, command.a, command.b); break;
+        case Command::TOUCH:              _comboBox.handleTouch(tft, command.a, command.b, command.c != 0); break;
+        case Command::SET_SELECTED_INDEX: _comboBox.setSelectedIndex(command.a); break;
+        case Command::SET_SELECTED_VALUE: _comboBox.setSelectedValue(command.a); break;
+        case Command::ADD_ITEM:           _comboBox.addItem(command.text, command.b); break;
+        case Command::INSERT_ITEM:        _comboBox.insertItem(command.a, String(command.text), command.b); break;
+        case Command::REMOVE_ITEM:        _comboBox.removeItem(command.a); break;
+        case Command::UPDATE_ITEM:        _comboBox.updateItem(command.a, String(command.text), command.b); break;
+        case Command::CLEAR:              _comboBox.clear(); break;
+        case Command::EXPAND:             _comboBox.expand(); break;
+        case Command::COLLAPSE:           _comboBox.collapse(); break;
+    }
+}
+
+void UIComboBoxAsync::publishState() {
+    // Chaque champ est publié en ordre « release » après le numéro impair : un lecteur qui voit
+    // une nouvelle valeur voit donc aussi le numéro modifié, sans barrière mémoire séparée.
+    uint32_t sequence = _stateSequence.load(std::memory_order_relaxed);
+    _stateSequence.store(sequence + 1, std::memory_order_relaxed);
+    _publishedIndex.store(_comboBox.getSelectedIndex(), std::memory_order_release);
+    _publishedValue.store(_comboBox.getSelectedValue(), std::memory_order_release);
+    _publishedCount.store(_comboBox.getItemCount(), std::memory_order_release);
+    _publishedExpanded.store(_comboBox.isExpanded(), std::memory_order_release);
+    _stateSequence.store(sequence + 2, std::memory_order_release);
+}
+
+UIComboBoxAsync::State UIComboBoxAsync::getState() const {
+    State state;
+    uint32_t before, after;
+    do {
+        before = _stateSequence.load(std::memory_order_acquire);
+        state.selectedIndex = _publishedIndex.load(std::memory_order_acquire);
+        state.selectedValue = _publishedValue.load(std::memory_order_acquire);
+        state.itemCount = _publishedCount.load(std::memory_order_acquire);
+        state.expanded = _publishedExpanded.load(std::memory_order_acquire);
+        after = _stateSequence.load(std::memory_order_relaxed);
+    } while (before != after || (before & 1));
+    return state;
+}
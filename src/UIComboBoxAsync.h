@@ -0,0 +1,232 @@
+/**
+ * @file UIComboBoxAsync.h
+ * @brief Pilotage d'un UIComboBox depuis une autre tâche, avec rendu sur une tâche dédiée.
+ *
+ * Ce fichier déclare la classe UIComboBoxAsync. L'application poste ses appels (appuis, sélection,
+ * modification de la liste) dans une file sans verrou ; une tâche de rendu, seule à accéder au
+ * UIComboBox et à l'écran, les applique puis redessine le composant. L'état visible (sélection,
+ * dépliage) est republié après chaque image et peut être lu sans verrou depuis n'importe quelle tâche.
+ *
+ * Sur ESP32, la tâche de rendu est une tâche FreeRTOS épinglée sur un cœur ; sur les autres
+ * plateformes, un std::thread.
+ */
+
+#ifndef UICOMBOBOXASYNC_H
+#define UICOMBOBOXASYNC_H
+
+#include "UIComboBox.h"
+#include "UIComboBoxSpscQueue.h"
+#include <atomic>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+/**
+ * @class UIComboBoxAsync
+ * @brief Adaptateur multitâche d'un UIComboBox : file de commandes et état publié.
+ *
+ * Les méthodes de commande doivent être appelées depuis une seule tâche (le producteur).
+ * Les rappels du UIComboBox (sélection, repliement) sont exécutés sur la tâche de rendu.
+ */
+class UIComboBoxAsync {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 32; /**< Nombre d'emplacements de la file de commandes. */
+    static constexpr size_t TEXT_SIZE = 48;      /**< Taille maximale du texte d'une commande, caractère nul compris. */
+
+    /**
+     * @struct State
+     * @brief Instantané cohérent de l'état du composant, publié par la tâche de rendu.
+     */
+    struct State {
+        int selectedIndex; /**< L'index de l'élément sélectionné, -1 si aucun. */
+        int selectedValue; /**< La valeur de l'élément sélectionné, -1 si aucun. */
+        int itemCount;     /**< Le nombre d'éléments. */
+        bool expanded;     /**< Indique si la liste est dépliée. */
+    };
+
+    /**
+     * @brief Constructeur de la classe UIComboBoxAsync.
+     * @param comboBox Le composant piloté ; il ne doit plus être appelé directement une fois le rendu démarré.
+     */
+    explicit UIComboBoxAsync(UIComboBox& comboBox);
+    /**
+     * @brief Destructeur : arrête la tâche de rendu si elle est active.
+     */
+    ~UIComboBoxAsync();
+
+    UIComboBoxAsync(const UIComboBoxAsync&) = delete;
+    UIComboBoxAsync& operator=(const UIComboBoxAsync&) = delete;
+
+    /**
+     * @brief Démarre la tâche de rendu, qui devient seule propriétaire de l'écran.
+     * @param tft Référence à l'objet TFT_eSPI.
+     * @param framePeriodMs Période d'une image, en millisecondes.
+     * @param core Le cœur sur lequel épingler la tâche (ESP32 uniquement).
+     * @param stackSize Taille de la pile de la tâche, en octets (ESP32 uniquement).
+     * @return `true` si la tâche a été créée.
+     */
+    bool start(TFT_eSPI& tft, uint32_t framePeriodMs = 16, int core = 1, uint32_t stackSize = 8192);
+    /**
+     * @brief Arrête la tâche de rendu et attend sa fin. Les commandes en attente sont abandonnées.
+     */
+    void stop();
+    /**
+     * @brief Indique si la tâche de rendu est active.
+     */
+    bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Poste un appui bref (équivalent de UIComboBox::handlePress).
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool handlePress(int tx, int ty);
+    /**
+     * @brief Poste un échantillon tactile brut (équivalent de UIComboBox::handleTouch).
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool handleTouch(int tx, int ty, bool pressed);
+    /**
+     * @brief Poste un changement de sélection par index.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool setSelectedIndex(int index);
+    /**
+     * @brief Poste un changement de sélection par valeur.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool setSelectedValue(int value);
+    /**
+     * @brief Poste l'ajout d'un élément ; le texte est tronqué à TEXT_SIZE - 1 caractères.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool addItem(const char* text, int value);
+    /**
+     * @brief Poste l'insertion d'un élément ; le texte est tronqué à TEXT_SIZE - 1 caractères.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool insertItem(int index, const char* text, int value);
+    /**
+     * @brief Poste la suppression d'un élément.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool removeItem(int index);
+    /**
+     * @brief Poste la modification d'un élément ; le texte est tronqué à TEXT_SIZE - 1 caractères.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool updateItem(int index, const char* text, int value);
+    /**
+     * @brief Poste la suppression de tous les éléments.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool clear();
+    /**
+     * @brief Poste le dépliage de la liste.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool expand();
+    /**
+     * @brief Poste le repliement de la liste.
+     * @return `true` si la commande a été postée, `false` si la file est pleine.
+     */
+    bool collapse();
+
+    /**
+     * @brief Retourne le dernier état publié, lu sans verrou depuis n'importe quelle tâche.
+     */
+    State getState() const;
+    /**
+     * @brief Retourne l'index de l'élément sélectionné, d'après le dernier état publié.
+     */
+    int getSelectedIndex() const { return getState().selectedIndex; }
+    /**
+     * @brief Retourne la valeur de l'élément sélectionné, d'après le dernier état publié.
+     */
+    int getSelectedValue() const { return getState().selectedValue; }
+    /**
+     * @brief Indique si la liste est dépliée, d'après le dernier état publié.
+     */
+    bool isExpanded() const { return getState().expanded; }
+    /**
+     * @brief Retourne le nombre de commandes refusées parce que la file était pleine.
+     */
+    uint32_t getDroppedCommands() const { return _droppedCommands.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Applique les commandes en attente, fait avancer le défilement, redessine et publie l'état.
+     * Appelée à chaque image par la tâche de rendu ; peut aussi être appelée directement depuis
+     * une boucle coopérative, à la place de start().
+     * @param tft Référence à l'objet TFT_eSPI.
+     */
+    void renderFrame(TFT_eSPI& tft);
+
+private:
+    /**
+     * @struct Command
+     * @brief Un appel posté par le producteur.
+     */
+    struct Command {
+        /**
+         * @brief Les opérations transmissibles.
+         */
+        enum Type : uint8_t {
+            PRESS, TOUCH, SET_SELECTED_INDEX, SET_SELECTED_VALUE,
+            ADD_ITEM, INSERT_ITEM, REMOVE_ITEM, UPDATE_ITEM, CLEAR, EXPAND, COLLAPSE
+        };
+        Type type;            /**< L'opération. */
+        int a;                /**< Premier argument (coordonnée X, index ou valeur). */
+        int b;                /**< Deuxième argument (coordonnée Y ou valeur). */
+        int c;                /**< Troisième argument (état d'appui). */
+        char text[TEXT_SIZE]; /**< Le texte de l'élément, pour les opérations qui en ont un. */
+    };
+
+    /**
+     * @brief Poste une commande, en comptant les refus.
+     */
+    bool post(Command::Type type, int a = 0, int b = 0, int c = 0, const char* text = nullptr);
+    /**
+     * @brief Applique une commande au composant (tâche de rendu).
+     */
+    void apply(TFT_eSPI& tft, const Command& command);
+    /**
+     * @brief Publie l'état courant du composant (tâche de rendu).
+     */
+    void publishState();
+    /**
+     * @brief Boucle de la tâche de rendu.
+     */
+    void run();
+#if defined(ESP32)
+    /**
+     * @brief Point d'entrée de la tâche FreeRTOS.
+     */
+    static void taskEntry(void* arg);
+#endif
+
+    UIComboBox& _comboBox;                                 /**< Le composant piloté. */
+    UIComboBoxSpscQueue<Command, QUEUE_CAPACITY> _queue;   /**< Les commandes en attente. */
+    std::atomic<uint32_t> _droppedCommands{0};             /**< Commandes refusées, file pleine. */
+
+    // État publié selon un verrou de séquence : un numéro impair signale une écriture en cours.
+    std::atomic<uint32_t> _stateSequence{0};               /**< Numéro de séquence de l'état publié. */
+    std::atomic<int> _publishedIndex{-1};                  /**< Index sélectionné publié. */
+    std::atomic<int> _publishedValue{-1};                  /**< Valeur sélectionnée publiée. */
+    std::atomic<int> _publishedCount{0};                   /**< Nombre d'éléments publié. */
+    std::atomic<bool> _publishedExpanded{false};           /**< État déplié publié. */
+
+    TFT_eSPI* _tft = nullptr;                              /**< L'écran, propriété de la tâche de rendu. */
+    uint32_t _framePeriodMs = 16;                          /**< Période d'une image, en millisecondes. */
+    std::atomic<bool> _running{false};                     /**< Demande d'exécution de la tâche de rendu. */
+#if defined(ESP32)
+    TaskHandle_t _task = nullptr;                          /**< La tâche FreeRTOS de rendu. */
+    std::atomic<bool> _taskFinished{true};                 /**< Indique que la tâche a quitté sa boucle. */
+#else
+    std::thread _thread;                                   /**< Le fil de rendu. */
+#endif
+};
+
+#endif // UICOMBOBOXASYNC_H
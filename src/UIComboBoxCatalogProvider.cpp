@@ -0,0 +1,157 @@
+#include "UIComboBoxCatalogProvider.h"
+#include <new>
+
+namespace {
+    constexpr size_t HEADER_SIZE = 20; // Taille de l'en-tête du catalogue, en octets
+    constexpr size_t RECORD_HEADER_SIZE = 5; // Valeur (4 octets) et longueur du texte (1 octet) d'un élément
+    constexpr size_t MAX_BLOCK_BYTES = 0xFFFF; // Taille maximale d'un bloc, les positions des éléments étant codées sur 16 bits
+
+    uint16_t readU16(const uint8_t* bytes) {
+        return (uint16_t)(bytes[0] | (bytes[1] << 8));
+    }
+
+    uint32_t readU32(const uint8_t* bytes) {
+        return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    }
+}
+
+UIComboBoxCatalogProvider::UIComboBoxCatalogProvider(size_t cacheBlocks)
+    : _cacheBlocks(cacheBlocks > 0 ? cacheBlocks : 1)
+{
+}
+
+bool UIComboBoxCatalogProvider::open(fs::File file) {
+    close();
+    if (!file) return false;
+
+    uint8_t header[HEADER_SIZE];
+    if (!file.seek(0) || file.read(header, HEADER_SIZE) != HEADER_SIZE) return false;
+    if (memcmp(header, "UICB", 4) != 0 || readU16(header + 4) != FORMAT_VERSION) return false;
+    uint16_t itemsPerBlock = readU16(header + 6);
+    uint32_t itemCount = readU32(header + 8);
+    uint32_t blockCount = readU32(header + 12);
+    uint32_t indexOffset = readU32(header + 16);
+    // Calculs sur 64 bits : un en-tête corrompu ne doit ni déborder ni annoncer un index plus grand que le fichier.
+    if (itemsPerBlock == 0 || blockCount != ((uint64_t)itemCount + itemsPerBlock - 1) / itemsPerBlock) return false;
+    size_t fileSize = file.size();
+    if ((uint64_t)indexOffset + 4 * ((uint64_t)blockCount + 1) > fileSize) return false;
+
+    // L'index des blocs est lu en une fois : 4 octets par bloc.
+    std::unique_ptr<uint32_t[]> offsets(new (std::nothrow) uint32_t[(size_t)blockCount + 1]);
+    if (!offsets || !file.seek(indexOffset)) return false;
+    size_t maxBlockBytes = 0;
+    for (uint32_t block = 0; block <= blockCount; ++block) {
+        uint8_t entry[4];
+        if (file.read(entry, sizeof(entry)) != sizeof(entry)) return false;
+        offsets[block] = readU32(entry);
+        if (offsets[block] > fileSize) return false;
+        if (block > 0) {
+            if (offsets[block] < offsets[block - 1]) return false;
+            maxBlockBytes = std::max(maxBlockBytes, (size_t)(offsets[block] - offsets[block - 1]));
+        }
+    }
+    if (maxBlockBytes > MAX_BLOCK_BYTES) return false;
+
+    // Les emplacements du cache sont alloués une fois, à la taille du plus grand bloc.
+    std::unique_ptr<CachedBlock[]> cache(new (std::nothrow) CachedBlock[_cacheBlocks]);
+    if (!cache) return false;
+    for (size_t i = 0; i < _cacheBlocks; ++i) {
+        cache[i].data.reset(new (std::nothrow) uint8_t[std::max(maxBlockBytes, (size_t)1)]);
+        cache[i].records.reset(new (std::nothrow) uint16_t[itemsPerBlock]);
+        if (!cache[i].data || !cache[i].records) return false;
+    }
+
+    _file = file;
+    _itemCount = itemCount;
+    _itemsPerBlock = itemsPerBlock;
+    _blockCount = blockCount;
+    _blockOffsets = std::move(offsets);
+    _maxBlockBytes = maxBlockBytes;
+    _cache = std::move(cache);
+    _open = true;
+    return true;
+}
+
+void UIComboBoxCatalogProvider::close() {
+    _file = fs::File();
+    _open = false;
+    _itemCount = 0;
+    _itemsPerBlock = 0;
+    _blockCount = 0;
+    _blockOffsets.reset();
+    _maxBlockBytes = 0;
+    _cache.reset();
+}
+
+size_t UIComboBoxCatalogProvider::getItemText(size_t index, char* buffer, size_t bufferSize) const {
+    if (bufferSize == 0) return 0;
+    buffer[0] = '\0';
+    const uint8_t* item = record(index);
+    if (!item) return 0;
+    size_t length = std::min((size_t)item[4], bufferSize - 1);
+    memcpy(buffer, item + RECORD_HEADER_SIZE, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+int UIComboBoxCatalogProvider::getItemValue(size_t index) const {
+    const uint8_t* item = record(index);
+    return item ? (int32_t)readU32(item) : 0;
+}
+
+size_t UIComboBoxCatalogProvider::getItemTextLength(size_t index) const {
+    const uint8_t* item = record(index);
+    return item ? item[4] : 0;
+}
+
+size_t UIComboBoxCatalogProvider::memoryUsage() const {
+    if (!_open) return 0;
+    return (_blockCount + 1) * sizeof(uint32_t)
+        + _cacheBlocks * (sizeof(CachedBlock) + std::max(_maxBlockBytes, (size_t)1) + _itemsPerBlock * sizeof(uint16_t));
+}
+
+const uint8_t* UIComboBoxCatalogProvider::record(size_t index) const {
+    if (!_open || index >= _itemCount) return nullptr;
+    uint32_t block = index / _itemsPerBlock;
+
+    // Recherche du bloc dans le cache, en repérant au passage l'emplacement le moins récemment utilisé.
+    CachedBlock* victim = &_cache[0];
+    for (size_t i = 0; i < _cacheBlocks; ++i) {
+        CachedBlock& slot = _cache[i];
+        if (slot.block == block) {
+            _stats.hits++;
+            slot.lastUse = ++_useCounter;
+            return slot.data.get() + slot.records[index % _itemsPerBlock];
+        }
+        if (slot.block == UINT32_MAX || (victim->block != UINT32_MAX && slot.lastUse < victim->lastUse)) {
+            victim = &slot;
+        }
+    }
+
+    _stats.misses++;
+    if (!loadBlock(*victim, block)) {
+        _stats.readErrors++;
+        victim->block = UINT32_MAX;
+        return nullptr;
+    }
+    victim->lastUse = ++_useCounter;
+    return victim->data.get() + victim->records[index % _itemsPerBlock];
+}
+
+bool UIComboBoxCatalogProvider::loadBlock(CachedBlock& slot, uint32_t block) const {
+    size_t start = _blockOffsets[block];
+    size_t size = _blockOffsets[block + 1] - start;
+    if (!_file.seek(start) || _file.read(slot.data.get(), size) != size) return false;
+
+    // Les éléments sont stockés bout à bout : on repère le début de chacun.
+    size_t items = std::min((size_t)_itemsPerBlock, _itemCount - (size_t)block * _itemsPerBlock);
+    size_t position = 0;
+    for (size_t i = 0; i < items; ++i) {
+        if (position + RECORD_HEADER_SIZE > size) return false;
+        slot.records[i] = (uint16_t)position;
+        position += RECORD_HEADER_SIZE + slot.data[position + 4];
+        if (position > size) return false;
+    }
+    slot.block = block;
+    return true;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file UIComboBoxCatalogProvider.h
+ * @brief Fournisseur d'éléments lisant un catalogue binaire sur système de fichiers (LittleFS, SPIFFS, SD).
+ *
+ * Ce fichier déclare la classe UIComboBoxCatalogProvider. Le catalogue est découpé en blocs de
+ * quelques dizaines d'éléments ; seul l'index des blocs est chargé à l'ouverture, et les blocs sont
+ * lus à la demande (lignes affichées, élément sélectionné) dans un petit cache LRU. Une liste de
+ * plusieurs milliers d'éléments est ainsi disponible immédiatement au démarrage, pour quelques
+ * kilo-octets de RAM.
+ *
+ * Format du fichier (entiers non signés petit-boutistes, sauf mention contraire), produit par
+ * `tools/build_catalog.py` :
+ * - En-tête de 20 octets : signature `"UICB"`, version (u16, 1), éléments par bloc (u16),
+ *   nombre d'éléments (u32), nombre de blocs (u32), position de l'index des blocs (u32).
+ * - Index des blocs : nombre de blocs + 1 positions (u32), la dernière marquant la fin du dernier bloc.
+ * - Blocs : pour chaque élément, sa valeur (i32), la longueur de son texte en octets (u8),
+ *   puis le texte UTF-8, sans caractère nul.
+ */
+
+#ifndef UICOMBOBOXCATALOGPROVIDER_H
+#define UICOMBOBOXCATALOGPROVIDER_H
+
+#include "UIComboBoxItemProvider.h"
+#include <FS.h>
+#include <memory>
+
+/**
+ * @class UIComboBoxCatalogProvider
+ * @brief Fournisseur paginant un catalogue binaire, avec un cache LRU de blocs.
+ *
+ * Le fichier doit rester ouvert tant que le fournisseur est utilisé. En cas d'erreur de lecture,
+ * l'élément concerné est rendu avec un texte vide et la valeur 0.
+ */
+class UIComboBoxCatalogProvider : public UIComboBoxItemProvider {
+public:
+    static constexpr uint16_t FORMAT_VERSION = 1; /**< Version du format reconnue. */
+
+    /**
+     * @struct Stats
+     * @brief Statistiques d'utilisation du cache de blocs.
+     */
+    struct Stats {
+        uint32_t hits = 0;       /**< Nombre d'accès servis par un bloc déjà en cache. */
+        uint32_t misses = 0;     /**< Nombre de blocs lus dans le fichier. */
+        uint32_t readErrors = 0; /**< Nombre de lectures de bloc échouées. */
+    };
+
+    /**
+     * @brief Constructeur de la classe UIComboBoxCatalogProvider.
+     * @param cacheBlocks Nombre de blocs conservés en RAM (au moins 1).
+     */
+    explicit UIComboBoxCatalogProvider(size_t cacheBlocks = 4);
+
+    /**
+     * @brief Ouvre un catalogue : vérifie l'en-tête, charge l'index des blocs et alloue le cache.
+     * Appelez ensuite UIComboBox::setItemProvider() (ou notifyItemsChanged() si le fournisseur est déjà utilisé).
+     * @param file Le fichier du catalogue, ouvert en lecture.
+     * @return `true` si le catalogue est valide, `false` sinon (le fournisseur est alors vide).
+     */
+    bool open(fs::File file);
+    /**
+     * @brief Ferme le catalogue et libère l'index et le cache.
+     */
+    void close();
+    /**
+     * @brief Indique si un catalogue est ouvert.
+     */
+    bool isOpen() const { return _open; }
+
+    size_t getItemCount() const override { return _itemCount; }
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override;
+    int getItemValue(size_t index) const override;
+    size_t getItemTextLength(size_t index) const override;
+
+    /**
+     * @brief Retourne les statistiques du cache de blocs.
+     */
+    const Stats& getStats() const { return _stats; }
+    /**
+     * @brief Remet à zéro les statistiques du cache de blocs.
+     */
+    void resetStats() { _stats = Stats(); }
+    /**
+     * @brief Retourne la mémoire occupée par l'index et le cache de blocs, en octets.
+     */
+    size_t memoryUsage() const;
+
+private:
+    /**
+     * @struct CachedBlock
+     * @brief Un bloc lu dans le fichier, avec la position de chacun de ses éléments.
+     */
+    struct CachedBlock {
+        uint32_t block = UINT32_MAX;         /**< L'index du bloc chargé, UINT32_MAX si l'emplacement est libre. */
+        uint32_t lastUse = 0;                /**< Horodatage logique du dernier accès (LRU). */
+        std::unique_ptr<uint8_t[]> data;     /**< Le contenu brut du bloc. */
+        std::unique_ptr<uint16_t[]> records; /**< Position de chaque élément dans data. */
+    };
+
+    /**
+     * @brief Retourne l'enregistrement (valeur, longueur, texte) d'un élément, en chargeant son bloc si besoin.
+     * @return Un pointeur dans le cache, ou `nullptr` si l'index est invalide ou la lecture a échoué.
+     */
+    const uint8_t* record(size_t index) const;
+    /**
+     * @brief Lit un bloc dans un emplacement du cache et repère ses éléments.
+     * @return `true` si le bloc a été lu et est cohérent.
+     */
+    bool loadBlock(CachedBlock& slot, uint32_t block) const;
+
+    mutable fs::File _file;                   /**< Le fichier du catalogue. */
+    bool _open = false;                       /**< Indique si un catalogue valide est ouvert. */
+    size_t _itemCount = 0;                    /**< Le nombre d'éléments. */
+    uint16_t _itemsPerBlock = 0;              /**< Le nombre d'éléments par bloc (le dernier bloc peut en compter moins). */
+    uint32_t _blockCount = 0;                 /**< Le nombre de blocs. */
+    std::unique_ptr<uint32_t[]> _blockOffsets; /**< Position de chaque bloc dans le fichier, plus la fin du dernier. */
+    size_t _maxBlockBytes = 0;                /**< Taille du plus grand bloc, en octets. */
+
+    size_t _cacheBlocks;                      /**< Nombre d'emplacements du cache. */
+    mutable std::unique_ptr<CachedBlock[]> _cache; /**< Les emplacements du cache de blocs. */
+    mutable uint32_t _useCounter = 0;         /**< Horloge logique du cache. */
+    mutable Stats _stats;                     /**< Les statistiques du cache. */
+};
+
+#endif // UICOMBOBOXCATALOGPROVIDER_H
@@ -0,0 +1,131 @@
+#include "UIComboBoxDirtyRegion.h"
+#include <algorithm>
+
+namespace {
+    constexpr long MAX_MERGE_WASTE_PERCENT = 25; // Surcoût maximal (en % des pixels des deux zones) accepté pour fusionner
+
+    long area(const UIRect& rect) {
+        return (long)rect.w * rect.h;
+    }
+}
+
+UIRect UIComboBoxDirtyRegion::intersection(const UIRect& a, const UIRect& b) {
+    int left = std::max(a.x, b.x);
+    int top = std::max(a.y, b.y);
+    int right = std::min(a.x + a.w, b.x + b.w);
+    int bottom = std::min(a.y + a.h, b.y + b.h);
+    return {left, top, std::max(0, right - left), std::max(0, bottom - top)};
+}
+
+bool UIComboBoxDirtyRegion::intersects(const UIRect& a, const UIRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+size_t UIComboBoxDirtyRegion::subtract(const UIRect& rect, const UIRect& hole, UIRect pieces[4]) {
+    if (!intersects(rect, hole)) {
+        pieces[0] = rect;
+        return 1;
+    }
+    UIRect inner = intersection(rect, hole);
+    size_t count = 0;
+    if (inner.y > rect.y) {
+        pieces[count++] = {rect.x, rect.y, rect.w, inner.y - rect.y};
+    }
+    if (inner.y + inner.h < rect.y + rect.h) {
+        pieces[count++] = {rect.x, inner.y + inner.h, rect.w, rect.y + rect.h - inner.y - inner.h};
+    }
+    if (inner.x > rect.x) {
+        pieces[count++] = {rect.x, inner.y, inner.x - rect.x, inner.h};
+    }
+    if (inner.x + inner.w < rect.x + rect.w) {
+        pieces[count++] = {inner.x + inner.w, inner.y, rect.x + rect.w - inner.x - inner.w, inner.h};
+    }
+    return count;
+}
+
+UIRect UIComboBoxDirtyRegion::bounds(const UIRect& a, const UIRect& b) {
+    int left = std::min(a.x, b.x);
+    int top = std::min(a.y, b.y);
+    int right = std::max(a.x + a.w, b.x + b.w);
+    int bottom = std::max(a.y + a.h, b.y + b.h);
+    return {left, top, right - left, bottom - top};
+}
+
+long UIComboBoxDirtyRegion::waste(const UIRect& a, const UIRect& b) {
+    return area(bounds(a, b)) - area(a) - area(b) + area(intersection(a, b));
+}
+
+void UIComboBoxDirtyRegion::add(const UIRect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    // Fusion avec la première zone dont l'union coûte peu (une zone contenue ne coûte rien).
+    for (size_t i = 0; i < _count; ++i) {
+        if (waste(_rects[i], rect) * 100 <= MAX_MERGE_WASTE_PERCENT * (area(_rects[i]) + area(rect))) {
+            mergeInto(i, rect);
+            return;
+        }
+    }
+    if (_count < MAX_RECTS) {
+        _rects[_count++] = rect;
+        return;
+    }
+
+    // Liste pleine : on fusionne le couple, nouvelle zone comprise, qui gaspille le moins de pixels.
+    size_t bestA = 0;
+    size_t bestB = MAX_RECTS; // MAX_RECTS désigne la nouvelle zone
+    long bestWaste = waste(_rects[0], rect);
+    for (size_t i = 0; i < _count; ++i) {
+        long w = waste(_rects[i], rect);
+        if (w < bestWaste) {
+            bestWaste = w;
+            bestA = i;
+            bestB = MAX_RECTS;
+        }
+        for (size_t j = i + 1; j < _count; ++j) {
+            w = waste(_rects[i], _rects[j]);
+            if (w < bestWaste) {
+                bestWaste = w;
+                bestA = i;
+                bestB = j;
+            }
+        }
+    }
+    if (bestB == MAX_RECTS) {
+        mergeInto(bestA, rect);
+        return;
+    }
+    // L'union contient _rects[bestB], qui y est absorbé : une place se libère pour la nouvelle zone.
+    UIRect other = _rects[bestB];
+    mergeInto(bestA, other);
+    add(rect);
+}
+
+bool UIComboBoxDirtyRegion::append(const UIRect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return true;
+    if (_count == MAX_RECTS) return false;
+    _rects[_count++] = rect;
+    return true;
+}
+
+void UIComboBoxDirtyRegion::mergeInto(size_t index, const UIRect& rect) {
+    UIRect merged = bounds(_rects[index], rect);
+    removeAt(index);
+    // L'union peut recouvrir d'autres zones, ou suffisamment pour qu'elles y soient fusionnées à leur tour.
+    bool absorbed = true;
+    while (absorbed) {
+        absorbed = false;
+        for (size_t i = 0; i < _count; ++i) {
+            if (waste(merged, _rects[i]) * 100 <= MAX_MERGE_WASTE_PERCENT * (area(merged) + area(_rects[i]))) {
+                merged = bounds(merged, _rects[i]);
+                removeAt(i);
+                absorbed = true;
+                break;
+            }
+        }
+    }
+    _rects[_count++] = merged;
+}
+
+void UIComboBoxDirtyRegion::removeAt(size_t index) {
+    _rects[index] = _rects[--_count];
+}
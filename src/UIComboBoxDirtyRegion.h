@@ -0,0 +1,97 @@
+/**
+ * @file UIComboBoxDirtyRegion.h
+ * @brief Ensemble réduit de rectangles à repeindre.
+ *
+ * Ce fichier déclare la classe UIComboBoxDirtyRegion, qui accumule les zones de l'écran à repeindre
+ * au cours d'une image et les fusionne en un petit nombre de rectangles, afin que chaque zone ne soit
+ * repeinte qu'une fois et que le nombre de passes de dessin reste borné.
+ */
+
+#ifndef UICOMBOBOXDIRTYREGION_H
+#define UICOMBOBOXDIRTYREGION_H
+
+#include <UITypes/UIRect.h>
+#include <stddef.h>
+
+/**
+ * @class UIComboBoxDirtyRegion
+ * @brief Liste bornée de rectangles à repeindre, fusionnés lorsque cela coûte peu.
+ *
+ * Un rectangle ajouté est fusionné avec un rectangle existant si leur union ne recouvre guère plus
+ * de pixels que les deux séparément. Lorsque la liste est pleine, les deux rectangles dont l'union
+ * gaspille le moins de pixels sont fusionnés. Aucune allocation n'est faite.
+ */
+class UIComboBoxDirtyRegion {
+public:
+    static constexpr size_t MAX_RECTS = 8; /**< Nombre maximal de rectangles conservés. */
+
+    /**
+     * @brief Ajoute une zone à repeindre. Les zones vides sont ignorées.
+     * @param rect La zone à ajouter.
+     */
+    void add(const UIRect& rect);
+    /**
+     * @brief Ajoute une zone telle quelle, sans fusion. Les zones vides sont ignorées.
+     * Sert lorsque la liste ne doit contenir aucun pixel de plus que les zones ajoutées.
+     * @param rect La zone à ajouter.
+     * @return `false` si la liste est pleine : la zone n'est pas ajoutée.
+     */
+    bool append(const UIRect& rect);
+    /**
+     * @brief Vide la liste.
+     */
+    void clear() { _count = 0; }
+    /**
+     * @brief Retourne le nombre de rectangles.
+     */
+    size_t size() const { return _count; }
+    /**
+     * @brief Indique si la liste est vide.
+     */
+    bool empty() const { return _count == 0; }
+    /**
+     * @brief Retourne un rectangle de la liste.
+     * @param index L'index du rectangle, inférieur à size().
+     */
+    const UIRect& operator[](size_t index) const { return _rects[index]; }
+
+    /**
+     * @brief Retourne l'intersection de deux rectangles, de largeur ou de hauteur nulle s'ils sont disjoints.
+     */
+    static UIRect intersection(const UIRect& a, const UIRect& b);
+    /**
+     * @brief Indique si deux rectangles se recoupent.
+     */
+    static bool intersects(const UIRect& a, const UIRect& b);
+    /**
+     * @brief Découpe la partie d'un rectangle située hors d'un autre en au plus quatre rectangles disjoints.
+     * @param rect Le rectangle à découper.
+     * @param hole La zone à retirer.
+     * @param pieces Reçoit les morceaux : bandes au-dessus et au-dessous, puis à gauche et à droite.
+     * @return Le nombre de morceaux (0 si hole contient rect, 1 et rect lui-même s'ils sont disjoints).
+     */
+    static size_t subtract(const UIRect& rect, const UIRect& hole, UIRect pieces[4]);
+
+private:
+    /**
+     * @brief Retourne le plus petit rectangle contenant les deux rectangles.
+     */
+    static UIRect bounds(const UIRect& a, const UIRect& b);
+    /**
+     * @brief Retourne le nombre de pixels de l'union de deux rectangles qui n'appartiennent à aucun d'eux (approximation par excès).
+     */
+    static long waste(const UIRect& a, const UIRect& b);
+    /**
+     * @brief Remplace le rectangle d'index `index` par son union avec `rect`, puis fusionne en cascade les rectangles qu'elle recouvre.
+     */
+    void mergeInto(size_t index, const UIRect& rect);
+    /**
+     * @brief Retire le rectangle d'index `index`.
+     */
+    void removeAt(size_t index);
+
+    UIRect _rects[MAX_RECTS]; /**< Les rectangles à repeindre. */
+    size_t _count = 0;        /**< Le nombre de rectangles utilisés. */
+};
+
+#endif // UICOMBOBOXDIRTYREGION_H
@@ -0,0 +1,300 @@
+#include "UIComboBoxGroup.h"
+#include <algorithm>
+
+namespace {
+    constexpr int GRID_CELL_SIZE = 32; // Côté d'une cellule de la grille d'indexation, en pixels
+}
+
+UIComboBoxGroup::~UIComboBoxGroup() {
+    for (UIComboBox* comboBox : _members) {
+        comboBox->setOnCollapse(nullptr);
+    }
+}
+
+bool UIComboBoxGroup::add(UIComboBox& comboBox) {
+    if (indexOf(comboBox) >= 0) return false;
+    _members.push_back(&comboBox);
+    _zOrder.push_back((uint16_t)(_members.size() - 1));
+    _rank.push_back((uint16_t)(_zOrder.size() - 1));
+    // La zone libérée par un repliement est repeinte par le groupe au prochain flush().
+    comboBox.setOnCollapse([this](const UIRect& clearedRect) { _exposed.add(clearedRect); });
+    _indexValid = false;
+    if (comboBox.isExpanded()) {
+        syncExpanded(&comboBox);
+    }
+    return true;
+}
+
+bool UIComboBoxGroup::remove(UIComboBox& comboBox) {
+    int index = indexOf(comboBox);
+    if (index < 0) return false;
+    comboBox.setOnCollapse(nullptr);
+    if (_expanded == &comboBox) _expanded = nullptr;
+    if (_touchTarget == &comboBox) _touchTarget = nullptr;
+
+    _members.erase(_members.begin() + index);
+    _zOrder.erase(_zOrder.begin() + _rank[index]);
+    _rank.resize(_members.size());
+    for (size_t position = 0; position < _zOrder.size(); ++position) {
+        if (_zOrder[position] > index) _zOrder[position]--;
+        _rank[_zOrder[position]] = (uint16_t)position;
+    }
+    _indexValid = false;
+    return true;
+}
+
+void UIComboBoxGroup::raise(UIComboBox& comboBox) {
+    int index = indexOf(comboBox);
+    if (index < 0) return;
+    _zOrder.erase(_zOrder.begin() + _rank[index]);
+    _zOrder.push_back((uint16_t)index);
+    for (size_t position = 0; position < _zOrder.size(); ++position) {
+        _rank[_zOrder[position]] = (uint16_t)position;
+    }
+}
+
+void UIComboBoxGroup::setOnExpose(ExposeCallback callback) {
+    _onExpose = callback;
+}
+
+void UIComboBoxGroup::invalidateArea(const UIRect& area) {
+    _exposed.add(area);
+}
+
+int UIComboBoxGroup::indexOf(const UIComboBox& comboBox) const {
+    for (size_t i = 0; i < _members.size(); ++i) {
+        if (_members[i] == &comboBox) return (int)i;
+    }
+    return -1;
+}
+
+bool UIComboBoxGroup::contains(const UIRect& rect, int x, int y) {
+    return x >= rect.x && x < rect.x + rect.w && y >= rect.y && y < rect.y + rect.h;
+}
+
+void UIComboBoxGroup::syncExpanded(UIComboBox* comboBox) {
+    if (comboBox->isExpanded()) {
+        if (_expanded == comboBox) return;
+        // Une seule liste dépliée à la fois : la précédente est repliée.
+        if (_expanded && _expanded->isExpanded()) {
+            _expanded->collapse();
+        }
+        _expanded = comboBox;
+        raise(*comboBox);
+    } else if (_expanded == comboBox) {
+        _expanded = nullptr;
+    }
+}
+
+void UIComboBoxGroup::rebuildIndex() {
+    _indexValid = true;
+    _cellStart.clear();
+    _cellMembers.clear();
+    _gridCols = 0;
+    _gridRows = 0;
+    _indexedRects.clear();
+    if (_members.empty()) return;
+    for (UIComboBox* comboBox : _members) {
+        _indexedRects.push_back(comboBox->getRect());
+    }
+
+    // La grille couvre le plus petit rectangle contenant tous les composants.
+    int left = _members[0]->getRect().x;
+    int top = _members[0]->getRect().y;
+    int right = left;
+    int bottom = top;
+    for (UIComboBox* comboBox : _members) {
+        const UIRect& rect = comboBox->getRect();
+        left = std::min(left, rect.x);
+        top = std::min(top, rect.y);
+        right = std::max(right, rect.x + rect.w);
+        bottom = std::max(bottom, rect.y + rect.h);
+    }
+    _gridX = left;
+    _gridY = top;
+    _gridCols = std::max(1, (right - left + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+    _gridRows = std::max(1, (bottom - top + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+
+    // Deux passes : nombre de composants par cellule, puis remplissage des listes contiguës.
+    _cellStart.assign(_gridCols * _gridRows + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < _members.size(); ++i) {
+            const UIRect& rect = _members[i]->getRect();
+            if (rect.w <= 0 || rect.h <= 0) continue;
+            int col0 = (rect.x - _gridX) / GRID_CELL_SIZE;
+            int row0 = (rect.y - _gridY) / GRID_CELL_SIZE;
+            int col1 = (rect.x + rect.w - 1 - _gridX) / GRID_CELL_SIZE;
+            int row1 = (rect.y + rect.h - 1 - _gridY) / GRID_CELL_SIZE;
+            for (int row = row0; row <= row1; ++row) {
+                for (int col = col0; col <= col1; ++col) {
+                    int cell = row * _gridCols + col;
+                    if (pass == 0) {
+                        _cellStart[cell + 1]++;
+                    } else {
+                        _cellMembers[_cellStart[cell]++] = (uint16_t)i;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (size_t cell = 1; cell < _cellStart.size(); ++cell) {
+                _cellStart[cell] += _cellStart[cell - 1];
+            }
+            _cellMembers.resize(_cellStart.back());
+        } else {
+            // Le remplissage a avancé chaque début jusqu'au début de la cellule suivante.
+            for (size_t cell = _cellStart.size() - 1; cell > 0; --cell) {
+                _cellStart[cell] = _cellStart[cell - 1];
+            }
+            _cellStart[0] = 0;
+        }
+    }
+}
+
+void UIComboBoxGroup::repair(TFT_eSPI& tft, UIComboBox& comboBox, const UIRect& clip,
+                             const UIComboBoxDirtyRegion& skip, size_t from) {
+    for (size_t i = from; i < skip.size(); ++i) {
+        if (UIComboBoxDirtyRegion::intersects(clip, skip[i])) {
+            // Les morceaux, compris dans clip, ne recoupent aucune des zones précédentes.
+            UIRect pieces[4];
+            size_t count = UIComboBoxDirtyRegion::subtract(clip, skip[i], pieces);
+            for (size_t piece = 0; piece < count; ++piece) {
+                repair(tft, comboBox, pieces[piece], skip, i + 1);
+            }
+            return;
+        }
+    }
+    comboBox.drawClipped(tft, clip);
+}
+
+bool UIComboBoxGroup::indexStale() const {
+    for (size_t i = 0; i < _members.size(); ++i) {
+        // La liste dépliée est testée à part dans hitTest().
+        if (_members[i] == _expanded) continue;
+        const UIRect& rect = _members[i]->getRect();
+        if (rect.w <= 0 || rect.h <= 0) continue;
+        // Un composant resté dans son rectangle indexé est toujours trouvé dans ses cellules.
+        UIRect inside = UIComboBoxDirtyRegion::intersection(rect, _indexedRects[i]);
+        if (inside.w != rect.w || inside.h != rect.h) return true;
+    }
+    return false;
+}
+
+UIComboBox* UIComboBoxGroup::hitTest(int x, int y) {
+    // La liste dépliée, au premier plan, déborde de la zone indexée pour son composant.
+    if (_expanded && contains(_expanded->getRect(), x, y)) {
+        return _expanded;
+    }
+    if (!_indexValid || indexStale()) {
+        rebuildIndex();
+    }
+    if (x < _gridX || y < _gridY) return nullptr;
+    int col = (x - _gridX) / GRID_CELL_SIZE;
+    int row = (y - _gridY) / GRID_CELL_SIZE;
+    if (col >= _gridCols || row >= _gridRows) return nullptr;
+
+    // Seuls les composants recoupant la cellule sont testés ; le plus haut l'emporte.
+    int cell = row * _gridCols + col;
+    UIComboBox* hit = nullptr;
+    int hitRank = -1;
+    for (int entry = _cellStart[cell]; entry < _cellStart[cell + 1]; ++entry) {
+        int index = _cellMembers[entry];
+        if (_rank[index] > hitRank && contains(_members[index]->getRect(), x, y)) {
+            hit = _members[index];
+            hitRank = _rank[index];
+        }
+    }
+    return hit;
+}
+
+void UIComboBoxGroup::handlePress(TFT_eSPI& tft, int tx, int ty) {
+    if (_expanded && !contains(_expanded->getRect(), tx, ty)) {
+        // Appui à côté de la liste dépliée : elle est repliée, l'appui n'est pas transmis.
+        _expanded->collapse();
+        _expanded = nullptr;
+        return;
+    }
+    UIComboBox* target = hitTest(tx, ty);
+    if (!target) return;
+    target->handlePress(tft, tx, ty);
+    syncExpanded(target);
+}
+
+void UIComboBoxGroup::handleTouch(TFT_eSPI& tft, int tx, int ty, bool pressed) {
+    if (pressed && !_touchActive) {
+        _touchActive = true;
+        if (_expanded && !contains(_expanded->getRect(), tx, ty)) {
+            _expanded->collapse();
+            _expanded = nullptr;
+            _touchTarget = nullptr;
+            return;
+        }
+        _touchTarget = hitTest(tx, ty);
+    }
+    if (!pressed) {
+        _touchActive = false;
+    }
+    if (!_touchTarget) return;
+
+    UIComboBox* target = _touchTarget;
+    target->handleTouch(tft, tx, ty, pressed);
+    if (!pressed) {
+        _touchTarget = nullptr;
+        syncExpanded(target);
+    }
+}
+
+bool UIComboBoxGroup::updateScroll(unsigned long nowMs) {
+    return _expanded && _expanded->updateScroll(nowMs);
+}
+
+void UIComboBoxGroup::flush(TFT_eSPI& tft) {
+    // Un dépliage ou un repliement demandé directement par l'application est pris en compte ici.
+    for (UIComboBox* comboBox : _members) {
+        if (comboBox->isExpanded() != (comboBox == _expanded)) {
+            syncExpanded(comboBox);
+        }
+    }
+
+    // Composants modifiés, du bas vers le haut : chacun est repeint là où un composant
+    // situé en dessous vient d'être redessiné.
+    // Seules les zones réellement repeintes par draw() comptent comme dommage, et elles n'ont pas à être
+    // réparées ensuite dans le composant qui vient de les repeindre par-dessus les précédents.
+    UIComboBoxDirtyRegion damaged;
+    for (uint16_t index : _zOrder) {
+        UIComboBox* comboBox = _members[index];
+        UIComboBoxDirtyRegion pending;
+        bool complete = comboBox->getPendingArea(pending);
+        comboBox->draw(tft, false);
+        UIRect rect = comboBox->getPaintRect();
+        for (size_t i = 0; i < damaged.size(); ++i) {
+            if (UIComboBoxDirtyRegion::intersects(rect, damaged[i])) {
+                repair(tft, *comboBox, UIComboBoxDirtyRegion::intersection(rect, damaged[i]), pending, 0);
+            }
+        }
+        // Zones incomplètes : les zones connues suffisent à éviter une réparation inutile,
+        // mais tout le composant compte comme dommage pour ceux qui sont au-dessus.
+        if (!complete) {
+            pending.clear();
+            pending.append(rect);
+        }
+        for (size_t i = 0; i < pending.size(); ++i) {
+            damaged.add(pending[i]);
+        }
+    }
+
+    // Zones découvertes : fond de l'application, puis composants qui les recoupent, du bas vers le haut.
+    for (size_t i = 0; i < _exposed.size(); ++i) {
+        const UIRect& area = _exposed[i];
+        if (_onExpose) {
+            _onExpose(area);
+        }
+        for (uint16_t index : _zOrder) {
+            UIRect rect = _members[index]->getPaintRect();
+            if (UIComboBoxDirtyRegion::intersects(rect, area)) {
+                _members[index]->drawClipped(tft, UIComboBoxDirtyRegion::intersection(rect, area));
+            }
+        }
+    }
+    _exposed.clear();
+}
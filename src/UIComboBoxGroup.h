@@ -0,0 +1,171 @@
+/**
+ * @file UIComboBoxGroup.h
+ * @brief Gestion d'un formulaire de plusieurs UIComboBox : ordre d'empilement, routage tactile et dessin groupé.
+ *
+ * Ce fichier déclare la classe UIComboBoxGroup. Le groupe garde l'ordre d'empilement des composants
+ * (la liste dépliée passe au premier plan), ne laisse qu'une liste dépliée à la fois, route les appuis
+ * grâce à une grille d'indexation spatiale et dessine tout le formulaire en une passe par image :
+ * les composants recouverts par un composant redessiné, ou découverts par le repliement d'une liste,
+ * ne sont repeints que dans la zone concernée.
+ */
+
+#ifndef UICOMBOBOXGROUP_H
+#define UICOMBOBOXGROUP_H
+
+#include "UIComboBox.h"
+#include "UIComboBoxDirtyRegion.h"
+#include <vector>
+#include <functional>
+
+/**
+ * @class UIComboBoxGroup
+ * @brief Ensemble de UIComboBox partageant l'écran, dessinés et touchés comme un seul formulaire.
+ *
+ * Le groupe ne possède pas les composants : ils doivent rester valides tant qu'ils en font partie.
+ * Il remplace leur rappel de repliement (setOnCollapse) par le sien ; l'application est prévenue par
+ * setOnExpose() des zones dont elle doit redessiner le fond, avant que le groupe y repeigne les composants.
+ * La restauration du fond (UIComboBox::setBackgroundRestore) est inutile dans un groupe et déconseillée :
+ * un composant modifié sous une liste dépliée rendrait la sauvegarde périmée.
+ */
+class UIComboBoxGroup {
+public:
+    /**
+     * @brief Type de rappel demandant à l'application de redessiner le fond d'une zone découverte.
+     * @param area La zone découverte, que les composants du groupe repeindront ensuite.
+     */
+    using ExposeCallback = std::function<void(const UIRect& area)>;
+
+    UIComboBoxGroup() = default;
+    /**
+     * @brief Destructeur : rend leur rappel de repliement aux composants restants.
+     */
+    ~UIComboBoxGroup();
+
+    UIComboBoxGroup(const UIComboBoxGroup&) = delete;
+    UIComboBoxGroup& operator=(const UIComboBoxGroup&) = delete;
+
+    /**
+     * @brief Ajoute un composant au premier plan du groupe.
+     * Le composant peut ensuite être déplacé ou redimensionné : à chaque hitTest(), les rectangles des
+     * composants sont comparés à ceux de la grille d'indexation (O(n)), qui est reconstruite si l'un
+     * d'eux en est sorti.
+     * @param comboBox Le composant à ajouter.
+     * @return `false` si le composant fait déjà partie du groupe.
+     */
+    bool add(UIComboBox& comboBox);
+    /**
+     * @brief Retire un composant du groupe, sans le redessiner.
+     * @param comboBox Le composant à retirer.
+     * @return `false` si le composant ne fait pas partie du groupe.
+     */
+    bool remove(UIComboBox& comboBox);
+    /**
+     * @brief Place un composant au premier plan.
+     * @param comboBox Le composant à placer au premier plan.
+     */
+    void raise(UIComboBox& comboBox);
+    /**
+     * @brief Retourne le nombre de composants du groupe.
+     */
+    size_t size() const { return _members.size(); }
+    /**
+     * @brief Définit le rappel demandant à l'application de redessiner le fond d'une zone découverte.
+     * @param callback La fonction à appeler.
+     */
+    void setOnExpose(ExposeCallback callback);
+    /**
+     * @brief Force la reconstruction de la grille d'indexation au prochain hitTest().
+     * Inutile après un déplacement, détecté par hitTest() ; permet de resserrer la grille après un rétrécissement.
+     */
+    void invalidateIndex() { _indexValid = false; }
+    /**
+     * @brief Demande de repeindre une zone au prochain flush() : fond de l'application (setOnExpose) puis composants.
+     * @param area La zone à repeindre.
+     */
+    void invalidateArea(const UIRect& area);
+
+    /**
+     * @brief Retourne le composant le plus haut dans l'ordre d'empilement contenant un point.
+     * @return Le composant touché, ou `nullptr`.
+     */
+    UIComboBox* hitTest(int x, int y);
+    /**
+     * @brief Transmet un appui bref au composant touché. Un appui hors de la liste dépliée la replie.
+     * @param tft Référence à l'objet TFT_eSPI.
+     * @param tx La coordonnée X de l'appui.
+     * @param ty La coordonnée Y de l'appui.
+     */
+    void handlePress(TFT_eSPI& tft, int tx, int ty);
+    /**
+     * @brief Transmet un échantillon tactile brut au composant touché au début de l'appui, jusqu'au relâchement.
+     * Un appui commençant hors de la liste dépliée la replie et n'est transmis à aucun composant.
+     * @param tft Référence à l'objet TFT_eSPI.
+     * @param tx La coordonnée X du point de contact.
+     * @param ty La coordonnée Y du point de contact.
+     * @param pressed `true` tant que l'écran est touché.
+     */
+    void handleTouch(TFT_eSPI& tft, int tx, int ty, bool pressed);
+    /**
+     * @brief Fait avancer le défilement de la liste dépliée (voir UIComboBox::updateScroll).
+     * @param nowMs L'instant courant, en millisecondes.
+     * @return `true` si la position de défilement a changé.
+     */
+    bool updateScroll(unsigned long nowMs);
+    /**
+     * @brief Dessine en une passe tout ce qui a changé depuis l'image précédente.
+     * Les composants modifiés sont redessinés du bas vers le haut ; les zones qu'un composant vient de
+     * repeindre (UIComboBox::getPendingArea) sont réparées dans les composants empilés au-dessus, hors
+     * des zones que ceux-ci repeignent eux-mêmes, puis les zones découvertes par un repliement
+     * sont confiées à l'application (setOnExpose) et repeintes dans les composants qui les recoupent.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     */
+    void flush(TFT_eSPI& tft);
+
+private:
+    /**
+     * @brief Retourne l'index d'un composant dans _members, ou -1.
+     */
+    int indexOf(const UIComboBox& comboBox) const;
+    /**
+     * @brief Prend en compte le dépliage ou le repliement d'un composant : une seule liste dépliée, au premier plan.
+     */
+    void syncExpanded(UIComboBox* comboBox);
+    /**
+     * @brief Reconstruit la grille d'indexation spatiale à partir des rectangles courants.
+     */
+    void rebuildIndex();
+    /**
+     * @brief Indique si un composant, hors liste dépliée, est sorti du rectangle sous lequel il est indexé.
+     */
+    bool indexStale() const;
+    /**
+     * @brief Repeint une zone d'un composant, privée des zones skip[from..] qu'il vient de repeindre lui-même.
+     */
+    void repair(TFT_eSPI& tft, UIComboBox& comboBox, const UIRect& clip, const UIComboBoxDirtyRegion& skip, size_t from);
+    /**
+     * @brief Indique si un point appartient à un rectangle.
+     */
+    static bool contains(const UIRect& rect, int x, int y);
+
+    std::vector<UIComboBox*> _members;   /**< Les composants, dans l'ordre d'ajout. */
+    std::vector<uint16_t> _zOrder;       /**< Index dans _members, du bas vers le haut de l'empilement. */
+    std::vector<uint16_t> _rank;         /**< Position de chaque composant dans _zOrder. */
+
+    bool _indexValid = false;            /**< Indique si la grille correspond aux composants et à leurs rectangles. */
+    int _gridX = 0;                      /**< Origine X de la grille. */
+    int _gridY = 0;                      /**< Origine Y de la grille. */
+    int _gridCols = 0;                   /**< Nombre de colonnes de la grille. */
+    int _gridRows = 0;                   /**< Nombre de lignes de la grille. */
+    std::vector<uint16_t> _cellStart;    /**< Début de la liste de chaque cellule dans _cellMembers (une entrée de plus que de cellules). */
+    std::vector<uint16_t> _cellMembers;  /**< Index dans _members des composants recoupant chaque cellule, cellule par cellule. */
+    std::vector<UIRect> _indexedRects;   /**< Rectangle de chaque composant lors de la construction de la grille. */
+
+    UIComboBox* _expanded = nullptr;     /**< Le composant dont la liste est dépliée, s'il y en a un. */
+    UIComboBox* _touchTarget = nullptr;  /**< Le composant recevant l'appui tactile en cours. */
+    bool _touchActive = false;           /**< Indique si un appui tactile est en cours. */
+
+    UIComboBoxDirtyRegion _exposed;      /**< Zones découvertes à repeindre au prochain flush(). */
+    ExposeCallback _onExpose = nullptr;  /**< Le rappel de redessin du fond des zones découvertes. */
+};
+
+#endif // UICOMBOBOXGROUP_H
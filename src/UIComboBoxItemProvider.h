@@ -0,0 +1,204 @@
+/**
+ * @file UIComboBoxItemProvider.h
+ * @brief Sources de données des éléments de la liste déroulante (UIComboBox).
+ *
+ * Ce fichier définit l'interface UIComboBoxItemProvider, par laquelle le UIComboBox interroge
+ * uniquement les éléments dont il a besoin (lignes visibles, élément sélectionné), ainsi que
+ * les fournisseurs intégrés : vecteur en RAM, table constante en mémoire Flash (PROGMEM)
+ * et fonction génératrice.
+ */
+
+#ifndef UICOMBOBOXITEMPROVIDER_H
+#define UICOMBOBOXITEMPROVIDER_H
+
+#include <Arduino.h>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <memory>
+
+/**
+ * @struct UIComboBoxItem
+ * @brief Structure représentant un élément individuel dans la liste déroulante (UIComboBox).
+ *
+ * Chaque élément est composé d'un texte affichable et d'une valeur entière associée.
+ */
+struct UIComboBoxItem {
+    String text; /**< Le texte affiché pour cet élément. */
+    int value;   /**< La valeur entière associée à cet élément. */
+};
+
+/**
+ * @class UIComboBoxItemProvider
+ * @brief Interface d'accès aux éléments d'une liste déroulante.
+ *
+ * Le texte est copié dans un tampon fourni par l'appelant, ce qui permet de servir des listes
+ * stockées en Flash ou calculées à la volée sans allocation sur le tas.
+ */
+class UIComboBoxItemProvider {
+public:
+    virtual ~UIComboBoxItemProvider() = default;
+
+    /**
+     * @brief Retourne le nombre d'éléments de la liste.
+     */
+    virtual size_t getItemCount() const = 0;
+    /**
+     * @brief Copie le texte d'un élément dans le tampon fourni, terminé par un caractère nul.
+     * @param index L'index (base zéro) de l'élément.
+     * @param buffer Le tampon de destination.
+     * @param bufferSize La taille du tampon, caractère nul compris.
+     * @return Le nombre de caractères copiés, sans le caractère nul.
+     */
+    virtual size_t getItemText(size_t index, char* buffer, size_t bufferSize) const = 0;
+    /**
+     * @brief Retourne la valeur entière associée à un élément.
+     * @param index L'index (base zéro) de l'élément.
+     */
+    virtual int getItemValue(size_t index) const = 0;
+    /**
+     * @brief Retourne la longueur du texte d'un élément, en octets, sans le caractère nul.
+     * Par défaut, le texte est relu dans des tampons de taille croissante jusqu'à ce qu'il y tienne ;
+     * les fournisseurs qui connaissent la longueur la retournent directement.
+     * @param index L'index (base zéro) de l'élément.
+     */
+    virtual size_t getItemTextLength(size_t index) const {
+        char probe[64];
+        size_t length = getItemText(index, probe, sizeof(probe));
+        // Un tampon rempli jusqu'au dernier octet a peut-être tronqué le texte.
+        for (size_t size = 2 * sizeof(probe); length == size / 2 - 1; size *= 2) {
+            std::unique_ptr<char[]> buffer(new char[size]);
+            length = getItemText(index, buffer.get(), size);
+        }
+        return length;
+    }
+};
+
+/**
+ * @class UIComboBoxVectorProvider
+ * @brief Fournisseur exposant un `std::vector<UIComboBoxItem>` appartenant à l'application.
+ */
+class UIComboBoxVectorProvider : public UIComboBoxItemProvider {
+public:
+    /**
+     * @brief Constructeur de la classe UIComboBoxVectorProvider.
+     * @param items Le vecteur d'éléments, qui doit rester valide tant que le fournisseur est utilisé.
+     */
+    explicit UIComboBoxVectorProvider(const std::vector<UIComboBoxItem>& items) : _items(items) {}
+
+    size_t getItemCount() const override { return _items.size(); }
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override {
+        if (bufferSize == 0) return 0;
+        size_t length = std::min((size_t)_items[index].text.length(), bufferSize - 1);
+        memcpy(buffer, _items[index].text.c_str(), length);
+        buffer[length] = '\0';
+        return length;
+    }
+    int getItemValue(size_t index) const override { return _items[index].value; }
+    size_t getItemTextLength(size_t index) const override { return _items[index].text.length(); }
+
+private:
+    const std::vector<UIComboBoxItem>& _items; /**< Le vecteur exposé. */
+};
+
+/**
+ * @struct UIComboBoxProgmemItem
+ * @brief Élément d'une table constante stockée en mémoire Flash.
+ *
+ * La table et les chaînes pointées doivent être déclarées avec PROGMEM, par exemple :
+ * @code
+ * const char partA[] PROGMEM = "Résistance 10k";
+ * const UIComboBoxProgmemItem catalogue[] PROGMEM = { {partA, 1001}, ... };
+ * @endcode
+ */
+struct UIComboBoxProgmemItem {
+    const char* text; /**< Pointeur vers le texte, en mémoire Flash. */
+    int value;        /**< La valeur entière associée à cet élément. */
+};
+
+/**
+ * @class UIComboBoxProgmemProvider
+ * @brief Fournisseur lisant une table UIComboBoxProgmemItem résidant en mémoire Flash.
+ */
+class UIComboBoxProgmemProvider : public UIComboBoxItemProvider {
+public:
+    /**
+     * @brief Constructeur de la classe UIComboBoxProgmemProvider.
+     * @param table La table d'éléments, en mémoire Flash.
+     * @param count Le nombre d'éléments de la table.
+     */
+    UIComboBoxProgmemProvider(const UIComboBoxProgmemItem* table, size_t count) : _table(table), _count(count) {}
+
+    size_t getItemCount() const override { return _count; }
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override {
+        if (bufferSize == 0) return 0;
+        const char* text;
+        memcpy_P(&text, &_table[index].text, sizeof(text));
+        strncpy_P(buffer, text, bufferSize - 1);
+        buffer[bufferSize - 1] = '\0';
+        return strlen(buffer);
+    }
+    int getItemValue(size_t index) const override {
+        int value;
+        memcpy_P(&value, &_table[index].value, sizeof(value));
+        return value;
+    }
+    size_t getItemTextLength(size_t index) const override {
+        const char* text;
+        memcpy_P(&text, &_table[index].text, sizeof(text));
+        return strlen_P(text);
+    }
+
+private:
+    const UIComboBoxProgmemItem* _table; /**< La table d'éléments, en mémoire Flash. */
+    size_t _count;                       /**< Le nombre d'éléments de la table. */
+};
+
+/**
+ * @class UIComboBoxGeneratorProvider
+ * @brief Fournisseur dont les éléments sont calculés à la demande par des fonctions de rappel.
+ */
+class UIComboBoxGeneratorProvider : public UIComboBoxItemProvider {
+public:
+    /**
+     * @brief Type de rappel produisant le texte d'un élément (mêmes conventions que getItemText).
+     */
+    using TextGenerator = std::function<size_t(size_t index, char* buffer, size_t bufferSize)>;
+    /**
+     * @brief Type de rappel produisant la valeur d'un élément.
+     */
+    using ValueGenerator = std::function<int(size_t index)>;
+
+    /**
+     * @brief Constructeur de la classe UIComboBoxGeneratorProvider.
+     * @param count Le nombre d'éléments générés.
+     * @param textGenerator Le rappel produisant le texte d'un élément.
+     * @param valueGenerator Le rappel produisant la valeur d'un élément ; si absent, la valeur est l'index.
+     */
+    UIComboBoxGeneratorProvider(size_t count, TextGenerator textGenerator, ValueGenerator valueGenerator = nullptr)
+        : _count(count), _textGenerator(textGenerator), _valueGenerator(valueGenerator) {}
+
+    /**
+     * @brief Modifie le nombre d'éléments générés.
+     * Appelez ensuite UIComboBox::notifyItemsChanged() pour mettre l'affichage à jour.
+     * @param count Le nouveau nombre d'éléments.
+     */
+    void setItemCount(size_t count) { _count = count; }
+
+    size_t getItemCount() const override { return _count; }
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override {
+        if (bufferSize == 0) return 0;
+        buffer[0] = '\0';
+        return _textGenerator ? _textGenerator(index, buffer, bufferSize) : 0;
+    }
+    int getItemValue(size_t index) const override {
+        return _valueGenerator ? _valueGenerator(index) : (int)index;
+    }
+
+private:
+    size_t _count;                  /**< Le nombre d'éléments générés. */
+    TextGenerator _textGenerator;   /**< Le rappel produisant le texte. */
+    ValueGenerator _valueGenerator; /**< Le rappel produisant la valeur. */
+};
+
+#endif // UICOMBOBOXITEMPROVIDER_H
@@ -0,0 +1,101 @@
+#include "UIComboBoxItemStore.h"
+
+namespace {
+    constexpr size_t MAX_TEXT_LENGTH = 0xFFFF; // Longueur maximale d'un texte, limitée par Record::length
+
+    // Ramène la longueur d'un texte à MAX_TEXT_LENGTH, en coupant avant le caractère UTF-8 qui dépasserait.
+    size_t clampTextLength(const char* text, size_t length) {
+        if (length <= MAX_TEXT_LENGTH) return length;
+        length = MAX_TEXT_LENGTH;
+        // L'octet suivant la coupure ne doit pas être la suite d'un caractère commencé avant elle.
+        while (length > 0 && ((uint8_t)text[length] & 0xC0) == 0x80) length--;
+        return length;
+    }
+}
+
+void UIComboBoxItemStore::reserve(size_t itemCount, size_t textBytes) {
+    _records.reserve(itemCount);
+    // Chaque texte est suivi de son caractère nul.
+    _arena.reserve(textBytes + itemCount);
+}
+
+void UIComboBoxItemStore::add(const char* text, size_t length, int value) {
+    length = clampTextLength(text, length);
+    uint32_t offset = appendText(text, length);
+    _records.push_back({offset, (uint16_t)length, value});
+}
+
+void UIComboBoxItemStore::insert(size_t index, const char* text, size_t length, int value) {
+    length = clampTextLength(text, length);
+    uint32_t offset = appendText(text, length);
+    _records.insert(_records.begin() + std::min(index, _records.size()), {offset, (uint16_t)length, value});
+}
+
+void UIComboBoxItemStore::remove(size_t index) {
+    _garbageBytes += _records[index].length + 1;
+    _records.erase(_records.begin() + index);
+    compactIfNeeded();
+}
+
+void UIComboBoxItemStore::update(size_t index, const char* text, size_t length, int value) {
+    length = clampTextLength(text, length);
+    Record& record = _records[index];
+    record.value = value;
+    if (length <= record.length) {
+        // Réécriture sur place : la fin de l'ancien texte devient inutilisée.
+        memmove(&_arena[record.offset], text, length);
+        _arena[record.offset + length] = '\0';
+        _garbageBytes += record.length - length;
+        record.length = length;
+    } else {
+        _garbageBytes += record.length + 1;
+        // appendText peut réallouer l'arène : le texte source ne doit pas y résider.
+        uint32_t offset = appendText(text, length);
+        _records[index].offset = offset;
+        _records[index].length = length;
+    }
+    compactIfNeeded();
+}
+
+void UIComboBoxItemStore::clear() {
+    _arena.clear();
+    _records.clear();
+    _garbageBytes = 0;
+}
+
+void UIComboBoxItemStore::shrinkToFit() {
+    _arena.shrink_to_fit();
+    _records.shrink_to_fit();
+}
+
+uint32_t UIComboBoxItemStore::appendText(const char* text, size_t length) {
+    uint32_t offset = _arena.size();
+    _arena.insert(_arena.end(), text, text + length);
+    _arena.push_back('\0');
+    return offset;
+}
+
+void UIComboBoxItemStore::compactIfNeeded() {
+    if (_garbageBytes == 0 || _garbageBytes * 2 < _arena.size()) return;
+    std::vector<char> compacted;
+    compacted.reserve(_arena.size() - _garbageBytes);
+    for (Record& record : _records) {
+        uint32_t offset = compacted.size();
+        compacted.insert(compacted.end(), &_arena[record.offset], &_arena[record.offset] + record.length + 1);
+        record.offset = offset;
+    }
+    _arena.swap(compacted);
+    _garbageBytes = 0;
+}
+
+size_t UIComboBoxItemStore::memoryUsage() const {
+    return _arena.capacity() + _records.capacity() * sizeof(Record);
+}
+
+size_t UIComboBoxItemStore::getItemText(size_t index, char* buffer, size_t bufferSize) const {
+    if (bufferSize == 0) return 0;
+    size_t length = std::min((size_t)_records[index].length, bufferSize - 1);
+    memcpy(buffer, textAt(index), length);
+    buffer[length] = '\0';
+    return length;
+}
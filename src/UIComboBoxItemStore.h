@@ -0,0 +1,134 @@
+/**
+ * @file UIComboBoxItemStore.h
+ * @brief Stockage compact des éléments de la liste déroulante (UIComboBox).
+ *
+ * Ce fichier déclare la classe UIComboBoxItemStore, qui range tous les textes dans une seule
+ * zone contiguë (arène) et les valeurs dans des enregistrements de taille fixe, au lieu d'un
+ * objet String alloué sur le tas par élément.
+ */
+
+#ifndef UICOMBOBOXITEMSTORE_H
+#define UICOMBOBOXITEMSTORE_H
+
+#include "UIComboBoxItemProvider.h"
+
+/**
+ * @class UIComboBoxItemStore
+ * @brief Liste d'éléments stockée dans une arène de caractères et un tableau d'enregistrements.
+ *
+ * Chaque texte est conservé dans l'arène, terminé par un caractère nul. Avec reserve(), la
+ * construction d'une liste ne demande que deux allocations, quel que soit le nombre d'éléments.
+ * Les textes supprimés ou remplacés laissent des octets inutilisés dans l'arène ; elle est
+ * compactée lorsque ceux-ci dépassent la moitié de sa taille.
+ *
+ * Un texte est limité à 65 535 octets : au-delà, il est tronqué à la dernière limite de caractère
+ * UTF-8 qui précède, de sorte qu'aucun caractère n'est coupé.
+ */
+class UIComboBoxItemStore : public UIComboBoxItemProvider {
+public:
+    /**
+     * @brief Réserve la mémoire nécessaire pour des ajouts à venir.
+     * @param itemCount Nombre total d'éléments attendus.
+     * @param textBytes Nombre total d'octets de texte attendus (sans les caractères nuls).
+     */
+    void reserve(size_t itemCount, size_t textBytes);
+    /**
+     * @brief Ajoute un élément à la fin de la liste.
+     * @param text Le texte de l'élément.
+     * @param length La longueur du texte, en octets ; ramenée à 65 535 sans couper de caractère UTF-8.
+     * @param value La valeur entière associée à l'élément.
+     */
+    void add(const char* text, size_t length, int value);
+    /**
+     * @brief Insère un élément à une position donnée.
+     * @param index La position d'insertion, entre 0 et size().
+     * @param text Le texte de l'élément.
+     * @param length La longueur du texte, en octets ; ramenée à 65 535 sans couper de caractère UTF-8.
+     * @param value La valeur entière associée à l'élément.
+     */
+    void insert(size_t index, const char* text, size_t length, int value);
+    /**
+     * @brief Supprime l'élément à une position donnée.
+     * @param index La position de l'élément, inférieure à size().
+     */
+    void remove(size_t index);
+    /**
+     * @brief Remplace le texte et la valeur d'un élément.
+     * Un texte plus court que l'ancien est réécrit sur place, sinon il est ajouté en fin d'arène.
+     * @param index La position de l'élément, inférieure à size().
+     * @param text Le nouveau texte.
+     * @param length La longueur du nouveau texte, en octets ; ramenée à 65 535 sans couper de caractère UTF-8.
+     * @param value La nouvelle valeur.
+     */
+    void update(size_t index, const char* text, size_t length, int value);
+    /**
+     * @brief Supprime tous les éléments en conservant la mémoire réservée.
+     */
+    void clear();
+    /**
+     * @brief Libère la capacité inutilisée de l'arène et des enregistrements.
+     */
+    void shrinkToFit();
+
+    /**
+     * @brief Retourne le nombre d'éléments stockés.
+     */
+    size_t size() const { return _records.size(); }
+    /**
+     * @brief Retourne le texte d'un élément, terminé par un caractère nul.
+     * Le pointeur reste valide jusqu'à la prochaine modification de la liste.
+     * @param index L'index de l'élément.
+     */
+    const char* textAt(size_t index) const { return _arena.data() + _records[index].offset; }
+    /**
+     * @brief Retourne la longueur du texte d'un élément, en octets.
+     * @param index L'index de l'élément.
+     */
+    size_t textLengthAt(size_t index) const { return _records[index].length; }
+    /**
+     * @brief Retourne le nombre total d'octets de texte stockés (sans les caractères nuls).
+     */
+    size_t textBytes() const { return _arena.size() - _garbageBytes - _records.size(); }
+    /**
+     * @brief Retourne la valeur d'un élément.
+     * @param index L'index de l'élément.
+     */
+    int valueAt(size_t index) const { return _records[index].value; }
+    /**
+     * @brief Retourne la mémoire occupée par la liste (capacités de l'arène et des enregistrements).
+     * @return La taille en octets.
+     */
+    size_t memoryUsage() const;
+
+    size_t getItemCount() const override { return _records.size(); }
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override;
+    int getItemValue(size_t index) const override { return _records[index].value; }
+    size_t getItemTextLength(size_t index) const override { return _records[index].length; }
+
+private:
+    /**
+     * @brief Ajoute un texte en fin d'arène.
+     * @return La position du texte dans l'arène.
+     */
+    uint32_t appendText(const char* text, size_t length);
+    /**
+     * @brief Compacte l'arène si les octets inutilisés dépassent la moitié de sa taille.
+     */
+    void compactIfNeeded();
+
+    /**
+     * @struct Record
+     * @brief Enregistrement de taille fixe décrivant un élément.
+     */
+    struct Record {
+        uint32_t offset; /**< Position du texte dans l'arène. */
+        uint16_t length; /**< Longueur du texte, sans le caractère nul. */
+        int value;       /**< La valeur entière associée à l'élément. */
+    };
+
+    std::vector<char> _arena;     /**< Les textes de tous les éléments, mis bout à bout. */
+    std::vector<Record> _records; /**< Un enregistrement par élément. */
+    size_t _garbageBytes = 0;     /**< Octets de l'arène qui n'appartiennent plus à aucun élément. */
+};
+
+#endif // UICOMBOBOXITEMSTORE_H
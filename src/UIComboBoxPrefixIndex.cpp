@@ -0,0 +1,122 @@
+#include "UIComboBoxPrefixIndex.h"
+#include <ctype.h>
+
+namespace {
+    constexpr size_t KEY_BUFFER_SIZE = 64; // Taille du tampon recevant le texte d'un élément lors des comparaisons
+}
+
+void UIComboBoxPrefixIndex::build(const UIComboBoxItemProvider& provider) {
+    size_t count = provider.getItemCount();
+    _order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        _order[i] = i;
+    }
+    std::sort(_order.begin(), _order.end(), [&provider](uint32_t a, uint32_t b) {
+        char textA[KEY_BUFFER_SIZE];
+        char textB[KEY_BUFFER_SIZE];
+        provider.getItemText(a, textA, sizeof(textA));
+        provider.getItemText(b, textB, sizeof(textB));
+        int cmp = compareFolded(textA, textB, KEY_BUFFER_SIZE);
+        return cmp < 0 || (cmp == 0 && a < b);
+    });
+    _built = true;
+}
+
+void UIComboBoxPrefixIndex::clear() {
+    std::vector<uint32_t>().swap(_order);
+    _built = false;
+}
+
+void UIComboBoxPrefixIndex::itemInserted(const UIComboBoxItemProvider& provider, size_t itemIndex) {
+    if (itemIndex < _order.size()) {
+        // Insertion au milieu de la liste : les éléments suivants ont avancé d'un rang.
+        for (uint32_t& entry : _order) {
+            if (entry >= itemIndex) entry++;
+        }
+    }
+    insertEntry(provider, itemIndex);
+}
+
+void UIComboBoxPrefixIndex::itemRemoved(size_t itemIndex) {
+    // L'élément n'existe plus : sa position est cherchée en parcourant l'ordre, qui est de toute façon renuméroté.
+    size_t position = _order.size();
+    for (size_t i = 0; i < _order.size(); ++i) {
+        if (_order[i] == itemIndex) {
+            position = i;
+        } else if (_order[i] > itemIndex) {
+            _order[i]--;
+        }
+    }
+    if (position < _order.size()) {
+        _order.erase(_order.begin() + position);
+    }
+}
+
+void UIComboBoxPrefixIndex::itemUpdated(const UIComboBoxItemProvider& provider, size_t itemIndex) {
+    // L'ancien texte n'est plus disponible : la position est cherchée en parcourant l'ordre.
+    auto it = std::find(_order.begin(), _order.end(), (uint32_t)itemIndex);
+    if (it == _order.end()) return;
+    _order.erase(it);
+    insertEntry(provider, itemIndex);
+}
+
+void UIComboBoxPrefixIndex::insertEntry(const UIComboBoxItemProvider& provider, uint32_t itemIndex) {
+    char key[KEY_BUFFER_SIZE];
+    provider.getItemText(itemIndex, key, sizeof(key));
+    size_t position = lowerBound(provider, key, itemIndex, 0, _order.size());
+    _order.insert(_order.begin() + position, itemIndex);
+}
+
+size_t UIComboBoxPrefixIndex::lowerBound(const UIComboBoxItemProvider& provider, const char* key, uint32_t itemIndex, size_t first, size_t last) const {
+    char text[KEY_BUFFER_SIZE];
+    size_t low = first, high = last;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        provider.getItemText(_order[middle], text, sizeof(text));
+        int cmp = compareFolded(text, key, KEY_BUFFER_SIZE);
+        if (cmp < 0 || (cmp == 0 && _order[middle] < itemIndex)) low = middle + 1; else high = middle;
+    }
+    return low;
+}
+
+void UIComboBoxPrefixIndex::narrow(const UIComboBoxItemProvider& provider, const char* prefix, size_t prefixLength, size_t& first, size_t& last) const {
+    char text[KEY_BUFFER_SIZE];
+    auto comparePrefix = [&](size_t position) {
+        provider.getItemText(_order[position], text, sizeof(text));
+        return compareFolded(text, prefix, prefixLength);
+    };
+
+    // Premier élément dont le préfixe n'est pas inférieur au préfixe recherché.
+    size_t low = first, high = last;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (comparePrefix(middle) < 0) low = middle + 1; else high = middle;
+    }
+    size_t rangeStart = low;
+
+    // Premier élément dont le préfixe est supérieur au préfixe recherché.
+    high = last;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (comparePrefix(middle) <= 0) low = middle + 1; else high = middle;
+    }
+    first = rangeStart;
+    last = low;
+}
+
+long UIComboBoxPrefixIndex::positionOf(const UIComboBoxItemProvider& provider, int itemIndex, size_t first, size_t last) const {
+    if (itemIndex < 0 || (size_t)itemIndex >= provider.getItemCount()) return -1;
+    char key[KEY_BUFFER_SIZE];
+    provider.getItemText(itemIndex, key, sizeof(key));
+    size_t low = lowerBound(provider, key, itemIndex, first, last);
+    return (low < last && _order[low] == (uint32_t)itemIndex) ? (long)low : -1;
+}
+
+int UIComboBoxPrefixIndex::compareFolded(const char* a, const char* b, size_t maxLength) {
+    for (size_t i = 0; i < maxLength; ++i) {
+        int ca = tolower((unsigned char)a[i]);
+        int cb = tolower((unsigned char)b[i]);
+        if (ca != cb || ca == 0) return ca - cb;
+    }
+    return 0;
+}
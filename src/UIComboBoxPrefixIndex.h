@@ -0,0 +1,111 @@
+/**
+ * @file UIComboBoxPrefixIndex.h
+ * @brief Index trié des éléments pour le filtrage par préfixe de la liste déroulante.
+ *
+ * Ce fichier déclare la classe UIComboBoxPrefixIndex, une permutation des index d'éléments
+ * triée selon leur texte (sans tenir compte de la casse ASCII). Les éléments commençant par
+ * un préfixe donné y forment une plage contiguë, trouvée par recherche dichotomique.
+ */
+
+#ifndef UICOMBOBOXPREFIXINDEX_H
+#define UICOMBOBOXPREFIXINDEX_H
+
+#include "UIComboBoxItemProvider.h"
+
+/**
+ * @class UIComboBoxPrefixIndex
+ * @brief Permutation triée des éléments permettant de restreindre une vue par préfixe en O(log n).
+ *
+ * L'ordre est celui du texte replié en minuscules, les ex aequo étant départagés par leur index,
+ * ce qui rend la position de chaque élément unique et retrouvable par dichotomie.
+ */
+class UIComboBoxPrefixIndex {
+public:
+    /**
+     * @brief Construit l'index à partir de tous les éléments du fournisseur.
+     * @param provider Le fournisseur d'éléments.
+     */
+    void build(const UIComboBoxItemProvider& provider);
+    /**
+     * @brief Libère l'index ; il devra être reconstruit avant utilisation.
+     */
+    void clear();
+    /**
+     * @brief Place un élément inséré dans la liste à l'index donné (les éléments suivants ayant été décalés).
+     * O(n) pour renuméroter et décaler l'ordre, mais seulement O(log n) lectures de texte.
+     * @param provider Le fournisseur d'éléments, contenant déjà le nouvel élément.
+     * @param itemIndex L'index du nouvel élément.
+     */
+    void itemInserted(const UIComboBoxItemProvider& provider, size_t itemIndex);
+    /**
+     * @brief Retire un élément supprimé de la liste (les éléments suivants ayant été décalés). O(n), sans lecture de texte.
+     * @param itemIndex L'index qu'occupait l'élément.
+     */
+    void itemRemoved(size_t itemIndex);
+    /**
+     * @brief Replace un élément dont le texte a changé. O(n), et O(log n) lectures de texte.
+     * @param provider Le fournisseur d'éléments.
+     * @param itemIndex L'index de l'élément.
+     */
+    void itemUpdated(const UIComboBoxItemProvider& provider, size_t itemIndex);
+    /**
+     * @brief Indique si l'index a été construit depuis la dernière modification de la liste.
+     */
+    bool isBuilt() const { return _built; }
+    /**
+     * @brief Retourne le nombre d'éléments indexés.
+     */
+    size_t size() const { return _order.size(); }
+    /**
+     * @brief Retourne l'index de l'élément à une position de l'ordre trié.
+     * @param position La position dans l'ordre trié.
+     */
+    int itemAt(size_t position) const { return (int)_order[position]; }
+
+    /**
+     * @brief Restreint la plage [first, last) aux éléments dont le texte commence par le préfixe.
+     * La plage d'entrée doit déjà ne contenir que des éléments partageant les caractères
+     * précédents du préfixe, ce qui permet un filtrage incrémental à chaque frappe.
+     * @param provider Le fournisseur d'éléments.
+     * @param prefix Le préfixe recherché.
+     * @param prefixLength La longueur du préfixe.
+     * @param first Début de la plage, mis à jour.
+     * @param last Fin de la plage (exclue), mise à jour.
+     */
+    void narrow(const UIComboBoxItemProvider& provider, const char* prefix, size_t prefixLength, size_t& first, size_t& last) const;
+    /**
+     * @brief Retrouve la position d'un élément dans la plage [first, last) de l'ordre trié.
+     * @param provider Le fournisseur d'éléments.
+     * @param itemIndex L'index de l'élément recherché.
+     * @param first Début de la plage.
+     * @param last Fin de la plage (exclue).
+     * @return La position de l'élément, ou -1 s'il n'est pas dans la plage.
+     */
+    long positionOf(const UIComboBoxItemProvider& provider, int itemIndex, size_t first, size_t last) const;
+
+    /**
+     * @brief Compare deux textes sans tenir compte de la casse ASCII, sur au plus maxLength caractères.
+     * @return Un entier négatif, nul ou positif, comme strcmp.
+     */
+    static int compareFolded(const char* a, const char* b, size_t maxLength);
+
+private:
+    /**
+     * @brief Retourne la première position de [first, last) qui ne précède pas l'élément (texte replié, puis index).
+     * @param provider Le fournisseur d'éléments.
+     * @param key Le texte de l'élément.
+     * @param itemIndex L'index de l'élément.
+     * @param first Début de la plage.
+     * @param last Fin de la plage (exclue).
+     */
+    size_t lowerBound(const UIComboBoxItemProvider& provider, const char* key, uint32_t itemIndex, size_t first, size_t last) const;
+    /**
+     * @brief Insère un élément à sa place dans l'ordre trié.
+     */
+    void insertEntry(const UIComboBoxItemProvider& provider, uint32_t itemIndex);
+
+    std::vector<uint32_t> _order; /**< Les index d'éléments, dans l'ordre trié. */
+    bool _built = false;          /**< Indique si l'ordre correspond à la liste courante. */
+};
+
+#endif // UICOMBOBOXPREFIXINDEX_H
@@ -0,0 +1,259 @@
+#include "UIComboBoxSortIndex.h"
+#include "UIComboBoxPrefixIndex.h"
+#include <ctype.h>
+
+namespace {
+    constexpr size_t KEY_BUFFER_SIZE = 64; // Taille du tampon recevant le texte d'un élément lors des comparaisons
+    constexpr size_t SECTION_LABEL_SIZE = 32; // Taille du tampon recevant un titre de section lors des comparaisons
+    constexpr size_t INCREMENTAL_APPEND_RATIO = 8; // Au-delà d'un ajout pour 8 éléments indexés, un tri complet est plus rapide
+}
+
+void UIComboBoxSortIndex::setSortKey(SortKey key, bool descending, Comparator comparator) {
+    _key = key;
+    _descending = descending;
+    _comparator = comparator;
+    if (key == SORT_NONE) {
+        clear();
+    }
+}
+
+void UIComboBoxSortIndex::setSections(bool enable, SectionLabel label) {
+    _sections = enable;
+    _sectionLabel = label;
+    if (!enable) {
+        std::vector<uint32_t>().swap(_sectionStarts);
+    }
+}
+
+void UIComboBoxSortIndex::build(const UIComboBoxItemProvider& provider) {
+    if (_key == SORT_NONE) return;
+    size_t count = provider.getItemCount();
+    _order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        _order[i] = i;
+    }
+    std::sort(_order.begin(), _order.end(), [this, &provider](uint32_t a, uint32_t b) {
+        return compare(provider, a, b) < 0;
+    });
+    rebuildSections(provider);
+}
+
+void UIComboBoxSortIndex::clear() {
+    std::vector<uint32_t>().swap(_order);
+    std::vector<uint32_t>().swap(_sectionStarts);
+}
+
+void UIComboBoxSortIndex::itemInserted(const UIComboBoxItemProvider& provider, size_t itemIndex) {
+    if (itemIndex < _order.size()) {
+        // Insertion au milieu de la liste : les éléments suivants ont avancé d'un rang.
+        for (uint32_t& entry : _order) {
+            if (entry >= itemIndex) entry++;
+        }
+    }
+    insertEntry(provider, itemIndex);
+}
+
+void UIComboBoxSortIndex::itemsAppended(const UIComboBoxItemProvider& provider) {
+    size_t count = provider.getItemCount();
+    if (count <= _order.size()) return;
+    if ((count - _order.size()) * INCREMENTAL_APPEND_RATIO > _order.size()) {
+        build(provider);
+        return;
+    }
+    for (size_t itemIndex = _order.size(); itemIndex < count; ++itemIndex) {
+        insertEntry(provider, itemIndex);
+    }
+}
+
+void UIComboBoxSortIndex::itemRemoved(const UIComboBoxItemProvider& provider, size_t itemIndex) {
+    // L'élément n'existe plus : sa position est cherchée en parcourant l'ordre, qui est de toute façon renuméroté.
+    size_t position = _order.size();
+    for (size_t i = 0; i < _order.size(); ++i) {
+        if (_order[i] == itemIndex) {
+            position = i;
+        } else if (_order[i] > itemIndex) {
+            _order[i]--;
+        }
+    }
+    if (position < _order.size()) {
+        eraseEntry(provider, position);
+    }
+}
+
+void UIComboBoxSortIndex::itemUpdated(const UIComboBoxItemProvider& provider, size_t itemIndex) {
+    // L'ancienne clé n'est plus disponible : la position est cherchée en parcourant l'ordre.
+    auto it = std::find(_order.begin(), _order.end(), (uint32_t)itemIndex);
+    if (it == _order.end()) return;
+    eraseEntry(provider, it - _order.begin());
+    insertEntry(provider, itemIndex);
+}
+
+long UIComboBoxSortIndex::itemAt(size_t row) const {
+    if (_sectionStarts.empty()) return (long)_order[row];
+    size_t headers = headersUpTo(row);
+    // L'en-tête de la section k occupe la ligne _sectionStarts[k] + k.
+    if (_sectionStarts[headers - 1] + headers - 1 == row) return -1;
+    return (long)_order[row - headers];
+}
+
+long UIComboBoxSortIndex::rowOf(const UIComboBoxItemProvider& provider, size_t itemIndex) const {
+    if (itemIndex >= _order.size()) return -1;
+    size_t position = lowerBound(provider, itemIndex);
+    if (position >= _order.size() || _order[position] != itemIndex) return -1;
+    size_t headers = std::upper_bound(_sectionStarts.begin(), _sectionStarts.end(), (uint32_t)position) - _sectionStarts.begin();
+    return (long)(position + headers);
+}
+
+size_t UIComboBoxSortIndex::headerText(const UIComboBoxItemProvider& provider, size_t row, char* buffer, size_t bufferSize) const {
+    if (bufferSize == 0) return 0;
+    buffer[0] = '\0';
+    size_t headers = headersUpTo(row);
+    if (headers == 0) return 0;
+    return sectionLabel(provider, _order[_sectionStarts[headers - 1]], buffer, bufferSize);
+}
+
+size_t UIComboBoxSortIndex::memoryUsage() const {
+    return (_order.capacity() + _sectionStarts.capacity()) * sizeof(uint32_t);
+}
+
+int UIComboBoxSortIndex::compare(const UIComboBoxItemProvider& provider, uint32_t a, uint32_t b) const {
+    char textB[KEY_BUFFER_SIZE];
+    int valueB = 0;
+    readKey(provider, b, textB, valueB);
+    return compareToKey(provider, a, b, textB, valueB);
+}
+
+void UIComboBoxSortIndex::readKey(const UIComboBoxItemProvider& provider, uint32_t itemIndex, char* text, int& value) const {
+    text[0] = '\0';
+    if (_key == SORT_TEXT) {
+        provider.getItemText(itemIndex, text, KEY_BUFFER_SIZE);
+    } else if (_key == SORT_VALUE) {
+        value = provider.getItemValue(itemIndex);
+    }
+}
+
+int UIComboBoxSortIndex::compareToKey(const UIComboBoxItemProvider& provider, uint32_t a, uint32_t b, const char* textB, int valueB) const {
+    int cmp = 0;
+    if (_key == SORT_TEXT) {
+        char textA[KEY_BUFFER_SIZE];
+        provider.getItemText(a, textA, sizeof(textA));
+        cmp = UIComboBoxPrefixIndex::compareFolded(textA, textB, KEY_BUFFER_SIZE);
+    } else if (_key == SORT_VALUE) {
+        int valueA = provider.getItemValue(a);
+        cmp = valueA < valueB ? -1 : (valueA > valueB ? 1 : 0);
+    } else if (_key == SORT_CUSTOM && _comparator) {
+        cmp = _comparator(provider, a, b);
+    }
+    if (_descending) cmp = -cmp;
+    if (cmp != 0) return cmp;
+    // Les ex aequo gardent l'ordre de la liste, quel que soit le sens du tri.
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+size_t UIComboBoxSortIndex::lowerBound(const UIComboBoxItemProvider& provider, uint32_t itemIndex) const {
+    // La clé de l'élément cherché est lue une fois ; chaque pas ne lit que celle de l'élément du milieu.
+    char key[KEY_BUFFER_SIZE];
+    int value = 0;
+    readKey(provider, itemIndex, key, value);
+    size_t low = 0, high = _order.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (compareToKey(provider, _order[middle], itemIndex, key, value) < 0) low = middle + 1; else high = middle;
+    }
+    return low;
+}
+
+void UIComboBoxSortIndex::insertEntry(const UIComboBoxItemProvider& provider, uint32_t itemIndex) {
+    size_t position = lowerBound(provider, itemIndex);
+    _order.insert(_order.begin() + position, itemIndex);
+    if (!_sections) return;
+    // Les sections suivantes reculent d'une position ; seules les deux positions autour de l'insertion peuvent changer de statut.
+    auto it = std::lower_bound(_sectionStarts.begin(), _sectionStarts.end(), (uint32_t)position);
+    for (; it != _sectionStarts.end(); ++it) {
+        ++*it;
+    }
+    updateSectionStart(provider, position);
+    if (position + 1 < _order.size()) {
+        updateSectionStart(provider, position + 1);
+    }
+}
+
+void UIComboBoxSortIndex::eraseEntry(const UIComboBoxItemProvider& provider, size_t position) {
+    _order.erase(_order.begin() + position);
+    if (!_sections) return;
+    auto it = std::lower_bound(_sectionStarts.begin(), _sectionStarts.end(), (uint32_t)position);
+    if (it != _sectionStarts.end() && *it == position) {
+        it = _sectionStarts.erase(it);
+    }
+    for (; it != _sectionStarts.end(); ++it) {
+        --*it;
+    }
+    // L'élément qui suivait occupe désormais la position libérée, avec un nouveau prédécesseur.
+    if (position < _order.size()) {
+        updateSectionStart(provider, position);
+    }
+}
+
+size_t UIComboBoxSortIndex::headersUpTo(size_t row) const {
+    size_t low = 0, high = _sectionStarts.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (_sectionStarts[middle] + middle <= row) low = middle + 1; else high = middle;
+    }
+    return low;
+}
+
+size_t UIComboBoxSortIndex::sectionLabel(const UIComboBoxItemProvider& provider, size_t itemIndex, char* buffer, size_t bufferSize) const {
+    if (_sectionLabel) {
+        buffer[0] = '\0';
+        return _sectionLabel(provider, itemIndex, buffer, bufferSize);
+    }
+    char text[KEY_BUFFER_SIZE];
+    size_t length = provider.getItemText(itemIndex, text, sizeof(text));
+    // Premier caractère UTF-8 : l'octet de tête et ses octets de continuation.
+    size_t charLength = length > 0 ? 1 : 0;
+    while (charLength < length && ((uint8_t)text[charLength] & 0xC0) == 0x80) {
+        charLength++;
+    }
+    charLength = std::min(charLength, bufferSize - 1);
+    memcpy(buffer, text, charLength);
+    buffer[charLength] = '\0';
+    if (charLength == 1) {
+        buffer[0] = toupper((unsigned char)buffer[0]);
+    }
+    return charLength;
+}
+
+bool UIComboBoxSortIndex::sameSection(const UIComboBoxItemProvider& provider, size_t positionA, size_t positionB) const {
+    char labelA[SECTION_LABEL_SIZE];
+    char labelB[SECTION_LABEL_SIZE];
+    sectionLabel(provider, _order[positionA], labelA, sizeof(labelA));
+    sectionLabel(provider, _order[positionB], labelB, sizeof(labelB));
+    return strcmp(labelA, labelB) == 0;
+}
+
+void UIComboBoxSortIndex::updateSectionStart(const UIComboBoxItemProvider& provider, size_t position) {
+    bool startsSection = position == 0 || !sameSection(provider, position - 1, position);
+    auto it = std::lower_bound(_sectionStarts.begin(), _sectionStarts.end(), (uint32_t)position);
+    bool listed = it != _sectionStarts.end() && *it == position;
+    if (startsSection && !listed) {
+        _sectionStarts.insert(it, (uint32_t)position);
+    } else if (!startsSection && listed) {
+        _sectionStarts.erase(it);
+    }
+}
+
+void UIComboBoxSortIndex::rebuildSections(const UIComboBoxItemProvider& provider) {
+    _sectionStarts.clear();
+    if (!_sections) return;
+    char labels[2][SECTION_LABEL_SIZE];
+    char* previous = labels[0];
+    char* current = labels[1];
+    for (size_t position = 0; position < _order.size(); ++position) {
+        sectionLabel(provider, _order[position], current, SECTION_LABEL_SIZE);
+        if (position == 0 || strcmp(previous, current) != 0) {
+            _sectionStarts.push_back(position);
+        }
+        std::swap(previous, current);
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file UIComboBoxSpscQueue.h
+ * @brief File circulaire sans verrou à un producteur et un consommateur.
+ *
+ * Ce fichier définit le modèle UIComboBoxSpscQueue, utilisé par UIComboBoxAsync pour transmettre
+ * les commandes de la tâche applicative à la tâche de rendu sans section critique ni allocation.
+ */
+
+#ifndef UICOMBOBOXSPSCQUEUE_H
+#define UICOMBOBOXSPSCQUEUE_H
+
+#include <atomic>
+#include <stddef.h>
+
+/**
+ * @class UIComboBoxSpscQueue
+ * @brief File de capacité fixe, sûre pour exactement un producteur et un consommateur.
+ *
+ * Le producteur n'écrit que l'index de fin et le consommateur que l'index de début ; chacun
+ * publie ses écritures par une mémorisation en ordre « release » lue en ordre « acquire » par l'autre.
+ * @tparam T Le type des éléments, copiable.
+ * @tparam Capacity Le nombre d'emplacements, puissance de deux (Capacity - 1 éléments au plus).
+ */
+template <typename T, size_t Capacity>
+class UIComboBoxSpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "La capacité doit être une puissance de deux");
+
+public:
+    /**
+     * @brief Ajoute un élément en fin de file (côté producteur uniquement).
+     * @param item L'élément à ajouter.
+     * @return `true` si l'élément a été ajouté, `false` si la file est pleine.
+     */
+    bool push(const T& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) & (Capacity - 1);
+        if (next == _head.load(std::memory_order_acquire)) return false;
+        _slots[tail] = item;
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+    /**
+     * @brief Retire l'élément en tête de file (côté consommateur uniquement).
+     * @param item Reçoit l'élément retiré.
+     * @return `true` si un élément a été retiré, `false` si la file est vide.
+     */
+    bool pop(T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) return false;
+        item = _slots[head];
+        _head.store((head + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+    /**
+     * @brief Indique si la file est vide, vu du consommateur.
+     */
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T _slots[Capacity];              /**< Les emplacements de la file. */
+    std::atomic<size_t> _head{0};    /**< Prochain emplacement à lire, écrit par le consommateur. */
+    std::atomic<size_t> _tail{0};    /**< Prochain emplacement à écrire, écrit par le producteur. */
+};
+
+#endif // UICOMBOBOXSPSCQUEUE_H
@@ -0,0 +1,391 @@
+/**
+ * @file UIComboBoxStatic.h
+ * @brief Variante du UIComboBox à capacité fixe, sans allocation sur le tas une fois construite.
+ *
+ * Ce fichier définit les modèles UIComboBoxStaticStore, une liste d'éléments stockée dans des
+ * tableaux de taille fixe, et UIComboBoxStatic, un UIComboBox qui l'affiche. Les capacités sont
+ * des paramètres du modèle, vérifiés à la compilation ; le composant peut ainsi être déclaré
+ * statiquement, pour les applications qui s'interdisent toute allocation après le démarrage.
+ */
+
+#ifndef UICOMBOBOXSTATIC_H
+#define UICOMBOBOXSTATIC_H
+
+#include "UIComboBox.h"
+
+/**
+ * @struct UIComboBoxStaticItem
+ * @brief Élément d'une table constante ajoutée par UIComboBoxStatic::addItems().
+ */
+struct UIComboBoxStaticItem {
+    const char* text; /**< Le texte de l'élément, copié dans le composant. */
+    int value;        /**< La valeur entière associée à cet élément. */
+};
+
+/**
+ * @class UIComboBoxStaticStore
+ * @brief Liste d'éléments de capacité fixe, textes et enregistrements compris dans l'objet.
+ *
+ * Les textes sont rangés bout à bout, sans caractère nul, dans une zone de MaxTextBytes octets
+ * maintenue compacte : un texte supprimé ou remplacé est aussitôt récupéré.
+ * @tparam MaxItems Le nombre maximal d'éléments.
+ * @tparam MaxTextBytes Le nombre maximal d'octets de texte, tous éléments confondus.
+ */
+template <size_t MaxItems, size_t MaxTextBytes>
+class UIComboBoxStaticStore : public UIComboBoxItemProvider {
+    static_assert(MaxItems > 0 && MaxItems <= 0xFFFF, "Le nombre d'éléments doit être compris entre 1 et 65535");
+    static_assert(MaxTextBytes > 0 && MaxTextBytes <= 0xFFFF, "La zone de texte doit compter entre 1 et 65535 octets");
+
+public:
+    /**
+     * @brief Ajoute un élément à la fin de la liste.
+     * @param text Le texte de l'élément.
+     * @param value La valeur entière associée à l'élément.
+     * @return `false` si la liste ou la zone de texte est pleine.
+     */
+    bool add(const char* text, int value) { return insert(_count, text, value); }
+    /**
+     * @brief Insère un élément à une position donnée.
+     * @param index La position d'insertion, ramenée à size() au plus.
+     * @param text Le texte de l'élément.
+     * @param value La valeur entière associée à l'élément.
+     * @return `false` si la liste ou la zone de texte est pleine.
+     */
+    bool insert(size_t index, const char* text, int value) {
+        size_t length = text ? strlen(text) : 0;
+        if (_count >= MaxItems || length > MaxTextBytes - _textBytes) return false;
+        index = std::min(index, _count);
+        memmove(&_records[index + 1], &_records[index], (_count - index) * sizeof(Record));
+        _records[index] = {(uint16_t)_textBytes, (uint16_t)length, value};
+        memcpy(_arena + _textBytes, text, length);
+        _textBytes += length;
+        _count++;
+        return true;
+    }
+    /**
+     * @brief Supprime l'élément à une position donnée.
+     * @param index La position de l'élément, inférieure à size().
+     */
+    void remove(size_t index) {
+        releaseText(index);
+        memmove(&_records[index], &_records[index + 1], (_count - index - 1) * sizeof(Record));
+        _count--;
+    }
+    /**
+     * @brief Remplace le texte et la valeur d'un élément.
+     * @param index La position de l'élément, inférieure à size().
+     * @param text Le nouveau texte, qui ne doit pas provenir de la liste elle-même.
+     * @param value La nouvelle valeur.
+     * @return `false` si le nouveau texte ne tient pas dans la zone de texte ; l'élément est alors inchangé.
+     */
+    bool update(size_t index, const char* text, int value) {
+        size_t length = text ? strlen(text) : 0;
+        if (length > MaxTextBytes - _textBytes + _records[index].length) return false;
+        releaseText(index);
+        _records[index] = {(uint16_t)_textBytes, (uint16_t)length, value};
+        memcpy(_arena + _textBytes, text, length);
+        _textBytes += length;
+        return true;
+    }
+    /**
+     * @brief Supprime tous les éléments.
+     */
+    void clear() {
+        _count = 0;
+        _textBytes = 0;
+    }
+
+    /**
+     * @brief Retourne le nombre d'éléments stockés.
+     */
+    size_t size() const { return _count; }
+    /**
+     * @brief Retourne le nombre d'octets de la zone de texte encore disponibles.
+     */
+    size_t freeTextBytes() const { return MaxTextBytes - _textBytes; }
+    /**
+     * @brief Retourne la valeur d'un élément.
+     * @param index L'index de l'élément.
+     */
+    int valueAt(size_t index) const { return _records[index].value; }
+
+    size_t getItemCount() const override { return _count; }
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override {
+        if (bufferSize == 0) return 0;
+        size_t length = std::min((size_t)_records[index].length, bufferSize - 1);
+        memcpy(buffer, _arena + _records[index].offset, length);
+        buffer[length] = '\0';
+        return length;
+    }
+    int getItemValue(size_t index) const override { return _records[index].value; }
+    size_t getItemTextLength(size_t index) const override { return _records[index].length; }
+
+private:
+    /**
+     * @brief Retire le texte d'un élément de la zone de texte en y ramenant les textes suivants.
+     */
+    void releaseText(size_t index) {
+        size_t offset = _records[index].offset;
+        size_t length = _records[index].length;
+        memmove(_arena + offset, _arena + offset + length, _textBytes - offset - length);
+        for (size_t i = 0; i < _count; ++i) {
+            if (_records[i].offset > offset) _records[i].offset -= length;
+        }
+        _records[index].length = 0;
+        _textBytes -= length;
+    }
+
+    /**
+     * @struct Record
+     * @brief Enregistrement de taille fixe décrivant un élément.
+     */
+    struct Record {
+        uint16_t offset; /**< Position du texte dans la zone de texte. */
+        uint16_t length; /**< Longueur du texte, en octets. */
+        int value;       /**< La valeur entière associée à l'élément. */
+    };
+
+    char _arena[MaxTextBytes];  /**< Les textes de tous les éléments, mis bout à bout. */
+    Record _records[MaxItems];  /**< Un enregistrement par élément. */
+    size_t _count = 0;          /**< Le nombre d'éléments. */
+    size_t _textBytes = 0;      /**< Le nombre d'octets de texte utilisés. */
+};
+
+/**
+ * @class UIComboBoxStatic
+ * @brief UIComboBox de capacité fixe dont les éléments et les rappels n'allouent pas de mémoire.
+ *
+ * Le dessin et le comportement tactile sont ceux du UIComboBox, dont il hérite ; seule la
+ * construction alloue (copie de l'étiquette par UITextComponent). Les rappels sont une fonction
+ * et un pointeur de contexte, transmis au UIComboBox par des références (std::ref) que std::function
+ * conserve sans allocation. Les fonctions du UIComboBox susceptibles d'allouer (liste interne,
+ * fournisseur externe, filtre, tri, style copié, cache des libellés, sprite, copie de lignes,
+ * sauvegarde du fond, texte sélectionné en String) sont masquées ; les appeler par une référence
+ * UIComboBox lève la garantie. Rattaché à un UIComboBoxGroup, le composant reçoit le rappel de
+ * repliement du groupe à la place du sien.
+ * @tparam MaxItems Le nombre maximal d'éléments.
+ * @tparam MaxTextBytes Le nombre maximal d'octets de texte, tous éléments confondus.
+ */
+template <size_t MaxItems, size_t MaxTextBytes>
+class UIComboBoxStatic : public UIComboBox {
+public:
+    /**
+     * @brief Type de fonction appelée lorsqu'un élément est sélectionné.
+     * @param context Le pointeur de contexte fourni à setOnSelect().
+     * @param selectedIndex L'index de l'élément sélectionné, -1 si la liste a été vidée.
+     * @param selectedValue La valeur de l'élément sélectionné, -1 si la liste a été vidée.
+     */
+    using SelectFunction = void (*)(void* context, int selectedIndex, int selectedValue);
+    /**
+     * @brief Type de fonction appelée lorsque la liste déroulante se replie.
+     * @param context Le pointeur de contexte fourni à setOnCollapse().
+     * @param clearedRect La zone libérée par la liste, à redessiner par l'application.
+     */
+    using CollapseFunction = void (*)(void* context, const UIRect& clearedRect);
+
+    /**
+     * @brief Constructeur de la classe UIComboBoxStatic.
+     * @param u8f Référence à l'objet U8g2_for_TFT_eSPI utilisé pour le rendu du texte.
+     * @param rect La position et les dimensions du composant ComboBox.
+     * @param labelText Le texte de l'étiquette affichée au-dessus du ComboBox.
+     * @param sharedStyle Le style visuel, partagé et non copié : il doit rester valide pendant toute la vie du composant.
+     */
+    UIComboBoxStatic(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String& labelText, const UIComboBoxStyle* sharedStyle)
+        : UIComboBox(u8f, rect, labelText, sharedStyle)
+    {
+        setItemProvider(&_store);
+        UIComboBox::setOnSelect(std::ref(_selectHook));
+        UIComboBox::setOnCollapse(std::ref(_collapseHook));
+    }
+
+    UIComboBoxStatic(const UIComboBoxStatic&) = delete;
+    UIComboBoxStatic& operator=(const UIComboBoxStatic&) = delete;
+
+    /**
+     * @brief Retourne le nombre maximal d'éléments.
+     */
+    static constexpr size_t capacity() { return MaxItems; }
+    /**
+     * @brief Retourne le nombre d'octets de texte encore disponibles.
+     */
+    size_t getFreeTextBytes() const { return _store.freeTextBytes(); }
+
+    /**
+     * @brief Ajoute un nouvel élément à la liste déroulante.
+     * @param text Le texte à afficher pour l'élément, copié dans le composant.
+     * @param value La valeur entière associée à l'élément.
+     * @return `false` si la capacité est atteinte ; la liste est alors inchangée.
+     */
+    bool addItem(const char* text, int value) {
+        if (!_store.add(text, value)) return false;
+        itemInserted(_store.size() - 1);
+        return true;
+    }
+    /**
+     * @brief Ajoute les éléments d'une table, dont la taille est vérifiée à la compilation.
+     * @param items La table d'éléments.
+     * @return `false` si la zone de texte ou la capacité restante ne suffit pas ; les éléments qui tenaient sont ajoutés.
+     */
+    template <size_t N>
+    bool addItems(const UIComboBoxStaticItem (&items)[N]) {
+        static_assert(N <= MaxItems, "La table compte plus d'éléments que la capacité du composant");
+        for (const UIComboBoxStaticItem& item : items) {
+            if (!addItem(item.text, item.value)) return false;
+        }
+        return true;
+    }
+    /**
+     * @brief Insère un élément à une position donnée.
+     * La sélection reste sur le même élément et seules les lignes décalées sont redessinées.
+     * @param index La position d'insertion, ramenée entre 0 et le nombre d'éléments.
+     * @param text Le texte à afficher pour l'élément.
+     * @param value La valeur entière associée à l'élément.
+     * @return `false` si la capacité est atteinte.
+     */
+    bool insertItem(int index, const char* text, int value) {
+        index = std::max(0, std::min(index, (int)_store.size()));
+        if (!_store.insert(index, text, value)) return false;
+        itemInserted(index);
+        return true;
+    }
+    /**
+     * @brief Supprime un élément (voir UIComboBox::removeItem).
+     * @param index L'index de l'élément à supprimer.
+     * @return `false` si l'index est invalide.
+     */
+    bool removeItem(int index) {
+        if (index < 0 || index >= (int)_store.size()) return false;
+        _store.remove(index);
+        itemRemoved(index, index);
+        return true;
+    }
+    /**
+     * @brief Remplace le texte et la valeur d'un élément. Seule la ligne de l'élément est redessinée.
+     * @param index L'index de l'élément à modifier.
+     * @param text Le nouveau texte.
+     * @param value La nouvelle valeur.
+     * @return `false` si l'index est invalide ou si le nouveau texte ne tient pas dans la zone de texte.
+     */
+    bool updateItem(int index, const char* text, int value) {
+        if (index < 0 || index >= (int)_store.size()) return false;
+        if (!_store.update(index, text, value)) return false;
+        itemUpdated(index);
+        return true;
+    }
+    /**
+     * @brief Supprime tous les éléments (voir UIComboBox::clear).
+     */
+    void clear() {
+        _store.clear();
+        itemsCleared();
+    }
+    /**
+     * @brief Retourne l'index du premier élément portant une valeur donnée, par un parcours de la liste.
+     * @param value La valeur recherchée.
+     * @return L'index de l'élément, ou -1 si aucun élément ne porte cette valeur.
+     */
+    int indexOfValue(int value) const {
+        for (size_t i = 0; i < _store.size(); ++i) {
+            if (_store.valueAt(i) == value) return (int)i;
+        }
+        return -1;
+    }
+    /**
+     * @brief Sélectionne le premier élément portant une valeur donnée.
+     * @param value La valeur de l'élément à sélectionner.
+     * @return `true` si un élément porte cette valeur, `false` sinon.
+     */
+    bool setSelectedValue(int value) {
+        int index = indexOfValue(value);
+        if (index < 0) return false;
+        setSelectedIndex(index);
+        return true;
+    }
+    /**
+     * @brief Copie le texte de l'élément sélectionné dans un tampon.
+     * @param buffer Le tampon de destination.
+     * @param bufferSize La taille du tampon, caractère nul compris.
+     * @return Le nombre de caractères copiés ; 0 et un texte vide si aucun élément n'est sélectionné.
+     */
+    size_t getSelectedText(char* buffer, size_t bufferSize) const {
+        if (bufferSize == 0) return 0;
+        buffer[0] = '\0';
+        int index = getSelectedIndex();
+        return index >= 0 ? _store.getItemText(index, buffer, bufferSize) : 0;
+    }
+
+    /**
+     * @brief Définit la fonction appelée lorsqu'un élément est sélectionné.
+     * @param function La fonction, ou `nullptr`.
+     * @param context Un pointeur transmis tel quel à la fonction.
+     */
+    void setOnSelect(SelectFunction function, void* context = nullptr) {
+        _selectHook.function = function;
+        _selectHook.context = context;
+    }
+    /**
+     * @brief Définit la fonction appelée lorsque la liste déroulante se replie.
+     * @param function La fonction, ou `nullptr`.
+     * @param context Un pointeur transmis tel quel à la fonction.
+     */
+    void setOnCollapse(CollapseFunction function, void* context = nullptr) {
+        _collapseHook.function = function;
+        _collapseHook.context = context;
+    }
+    /**
+     * @brief Remplace le style visuel par un style partagé, sans le copier.
+     * @param sharedStyle Le nouveau style, qui doit rester valide tant qu'il est utilisé.
+     */
+    void setStyle(const UIComboBoxStyle* sharedStyle) { UIComboBox::setStyle(sharedStyle); }
+
+private:
+    /**
+     * @struct SelectHook
+     * @brief Rappel de sélection : une fonction et son contexte.
+     */
+    struct SelectHook {
+        SelectFunction function = nullptr; /**< La fonction appelée. */
+        void* context = nullptr;           /**< Le contexte transmis à la fonction. */
+        void operator()(int selectedIndex, int selectedValue) const {
+            if (function) function(context, selectedIndex, selectedValue);
+        }
+    };
+    /**
+     * @struct CollapseHook
+     * @brief Rappel de repliement : une fonction et son contexte.
+     */
+    struct CollapseHook {
+        CollapseFunction function = nullptr; /**< La fonction appelée. */
+        void* context = nullptr;             /**< Le contexte transmis à la fonction. */
+        void operator()(const UIRect& clearedRect) const {
+            if (function) function(context, clearedRect);
+        }
+    };
+
+    // Fonctions du UIComboBox susceptibles d'allouer, masquées. Le masquage ne protège que les appels
+    // faits à travers un UIComboBoxStatic : par une référence ou un pointeur UIComboBox& (code générique,
+    // conteneur de composants), ces fonctions restent accessibles et leur appel lève la garantie.
+    using UIComboBox::reserveItems;
+    using UIComboBox::getItemsMemoryUsage;
+    using UIComboBox::setItemProvider;
+    using UIComboBox::notifyItemsChanged;
+    using UIComboBox::setFilterEnabled;
+    using UIComboBox::appendFilterChar;
+    using UIComboBox::removeFilterChar;
+    using UIComboBox::setFilterText;
+    using UIComboBox::clearFilter;
+    using UIComboBox::getFilterText;
+    using UIComboBox::setSortOrder;
+    using UIComboBox::setSortComparator;
+    using UIComboBox::setSectionHeaders;
+    using UIComboBox::setBlitScrolling;
+    using UIComboBox::setSpriteRendering;
+    using UIComboBox::setBackgroundRestore;
+    using UIComboBox::setTextCacheBudget;
+
+    UIComboBoxStaticStore<MaxItems, MaxTextBytes> _store; /**< Les éléments du composant. */
+    SelectHook _selectHook;     /**< Le rappel de sélection, référencé par le UIComboBox. */
+    CollapseHook _collapseHook; /**< Le rappel de repliement, référencé par le UIComboBox. */
+};
+
+#endif // UICOMBOBOXSTATIC_H
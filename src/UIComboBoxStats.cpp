@@ -0,0 +1,20 @@
+#include "UIComboBoxStats.h"
+
+#if UICOMBOBOX_ENABLE_STATS
+
+void UIComboBoxTiming::record(uint32_t us) {
+    minUs = (count == 0 || us < minUs) ? us : minUs;
+    maxUs = (us > maxUs) ? us : maxUs;
+    totalUs += us;
+    count++;
+
+    int bucket = 0;
+    uint32_t bound = HISTOGRAM_FIRST_US;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && us >= bound) {
+        bucket++;
+        bound <<= 1;
+    }
+    histogram[bucket]++;
+}
+
+#endif // UICOMBOBOX_ENABLE_STATS
@@ -0,0 +1,116 @@
+/**
+ * @file UIComboBoxStats.h
+ * @brief Instrumentation optionnelle du rendu et des interactions de la liste déroulante.
+ *
+ * Ce fichier déclare les compteurs de performance d'un UIComboBox : durées de dessin (complet ou
+ * par étapes), de la barre de défilement et du traitement des appuis, nombre d'appels de primitives
+ * graphiques et pixels envoyés à l'écran. Ils ne sont compilés que si UICOMBOBOX_ENABLE_STATS vaut 1 ; sinon les
+ * macros d'instrumentation ne produisent aucun code et aucun membre n'est ajouté au composant.
+ *
+ * La macro doit être définie de la même façon pour toutes les unités de compilation, par exemple
+ * avec `build_flags = -DUICOMBOBOX_ENABLE_STATS=1` dans platformio.ini.
+ */
+
+#ifndef UICOMBOBOXSTATS_H
+#define UICOMBOBOXSTATS_H
+
+#ifndef UICOMBOBOX_ENABLE_STATS
+#define UICOMBOBOX_ENABLE_STATS 0
+#endif
+
+#if UICOMBOBOX_ENABLE_STATS
+
+#include <Arduino.h>
+
+/**
+ * @struct UIComboBoxTiming
+ * @brief Durées mesurées pour une opération : extrêmes, moyenne et histogramme.
+ *
+ * L'histogramme compte les mesures par tranche de durée doublant à chaque case :
+ * moins de 250 µs, moins de 500 µs, moins de 1 ms, ... la dernière case regroupant
+ * toutes les mesures de 16 ms et plus (au-delà d'une image à 60 Hz).
+ */
+struct UIComboBoxTiming {
+    static constexpr int HISTOGRAM_BUCKETS = 8;          /**< Nombre de cases de l'histogramme. */
+    static constexpr uint32_t HISTOGRAM_FIRST_US = 250;  /**< Borne supérieure de la première case, en µs. */
+
+    uint32_t count = 0;      /**< Nombre de mesures. */
+    uint64_t totalUs = 0;    /**< Somme des durées, en µs. */
+    uint32_t minUs = 0;      /**< Durée la plus courte, en µs. */
+    uint32_t maxUs = 0;      /**< Durée la plus longue, en µs. */
+    uint32_t histogram[HISTOGRAM_BUCKETS] = {}; /**< Nombre de mesures par tranche de durée. */
+
+    /**
+     * @brief Ajoute une mesure.
+     * @param us La durée mesurée, en µs.
+     */
+    void record(uint32_t us);
+    /**
+     * @brief Retourne la durée moyenne, en µs.
+     */
+    uint32_t averageUs() const { return count ? (uint32_t)(totalUs / count) : 0; }
+    /**
+     * @brief Remet les mesures à zéro.
+     */
+    void reset() { *this = UIComboBoxTiming(); }
+};
+
+/**
+ * @struct UIComboBoxStats
+ * @brief Compteurs de rendu et d'interaction d'un UIComboBox.
+ *
+ * Les appels de primitives sont comptés quelle que soit leur cible (écran ou sprite hors écran) ;
+ * les pixels ne sont comptés que lorsqu'ils sont effectivement envoyés à l'écran.
+ */
+struct UIComboBoxStats {
+    UIComboBoxTiming draw;      /**< Durées de drawInternal. */
+    UIComboBoxTiming step;      /**< Durées de drawStep. */
+    UIComboBoxTiming scrollBar; /**< Durées de drawScrollBar. */
+    UIComboBoxTiming press;     /**< Durées de handlePress. */
+
+    uint32_t fillCalls = 0;     /**< Appels de remplissage (fillRect, fillTriangle). */
+    uint32_t rectCalls = 0;     /**< Appels de tracé de contours et de lignes (drawRect, drawFastHLine, drawFastVLine). */
+    uint32_t textCalls = 0;     /**< Libellés dessinés, par U8g2 ou depuis le cache de texte. */
+    uint32_t pushCalls = 0;     /**< Transferts de blocs de pixels (pushImage, pushRect, pushBlock). */
+    uint64_t pixelsWritten = 0; /**< Pixels envoyés à l'écran. */
+
+    uint32_t forcedDraws = 0;   /**< Dessins demandés avec force = true. */
+    uint32_t dirtyDraws = 0;    /**< Dessins déclenchés par une invalidation. */
+    uint32_t stepDraws = 0;     /**< Appels de drawStep, comptés à part des dessins complets. */
+
+    /**
+     * @brief Remet tous les compteurs à zéro.
+     */
+    void reset() { *this = UIComboBoxStats(); }
+};
+
+/**
+ * @class UIComboBoxScopedTimer
+ * @brief Mesure la durée de la portée qui le contient et l'ajoute à un UIComboBoxTiming.
+ */
+class UIComboBoxScopedTimer {
+public:
+    explicit UIComboBoxScopedTimer(UIComboBoxTiming& timing) : _timing(timing), _startUs(micros()) {}
+    ~UIComboBoxScopedTimer() { _timing.record((uint32_t)(micros() - _startUs)); }
+
+    UIComboBoxScopedTimer(const UIComboBoxScopedTimer&) = delete;
+    UIComboBoxScopedTimer& operator=(const UIComboBoxScopedTimer&) = delete;
+
+private:
+    UIComboBoxTiming& _timing; /**< Les mesures à compléter. */
+    unsigned long _startUs;    /**< Instant d'entrée dans la portée, en µs. */
+};
+
+/** @brief Mesure la durée de la portée courante dans le UIComboBoxTiming donné. */
+#define UICOMBOBOX_STATS_TIME(timing) UIComboBoxScopedTimer uiComboBoxScopedTimer_(timing)
+/** @brief Exécute une instruction de comptage. */
+#define UICOMBOBOX_STATS(statement) do { statement; } while (0)
+
+#else
+
+#define UICOMBOBOX_STATS_TIME(timing) do {} while (0)
+#define UICOMBOBOX_STATS(statement) do {} while (0)
+
+#endif // UICOMBOBOX_ENABLE_STATS
+
+#endif // UICOMBOBOXSTATS_H
@@ -26,6 +26,8 @@ struct UIComboBoxStyle {
     int maxVisibleItems = 3; // Nouvelle propriété: nombre maximum d'éléments visibles
     int scrollBarWidth = 10; // Nouvelle propriété: largeur de la barre de défilement
     uint16_t scrollBarColor = TFT_LIGHTGREY; // Nouvelle propriété: couleur de la barre de défilement
+    uint16_t sectionHeaderColor = TFT_DARKGREY; // Nouvelle propriété: fond des en-têtes de section d'une liste triée
+    uint16_t sectionTextColor = TFT_WHITE; // Nouvelle propriété: couleur du titre des en-têtes de section
 };
 
 #endif // UICOMBOBOXSTYLE_H
\ No newline at end of file
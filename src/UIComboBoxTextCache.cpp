@@ -0,0 +1,91 @@
+#include "UIComboBoxTextCache.h"
+#include <new>
+
+UIComboBoxTextCache::UIComboBoxTextCache(size_t budgetBytes)
+    : _budgetBytes(budgetBytes)
+{
+}
+
+const UIComboBoxTextCache::Entry* UIComboBoxTextCache::find(int itemIndex, const uint8_t* font, uint32_t textHash) {
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        Entry& entry = _entries[i];
+        if (entry.itemIndex != itemIndex) continue;
+        if (entry.font == font && entry.textHash == textHash) {
+            entry.lastUse = ++_clock;
+            _stats.hits++;
+            return &entry;
+        }
+        // Le texte ou la police a changé : l'entrée est périmée.
+        removeAt(i);
+        break;
+    }
+    _stats.misses++;
+    return nullptr;
+}
+
+UIComboBoxTextCache::Entry* UIComboBoxTextCache::insert(int itemIndex, const uint8_t* font, uint32_t textHash, int width, int height) {
+    if (width <= 0 || height <= 0) return nullptr;
+    size_t bytes = (size_t)((width + 7) / 8) * height;
+    if (bytes > _budgetBytes) return nullptr; // Libellé trop grand pour être mis en cache
+
+    while (!_entries.empty() && _stats.bytesUsed + bytes > _budgetBytes) {
+        evictOldest();
+    }
+
+    std::unique_ptr<uint8_t[]> bits(new (std::nothrow) uint8_t[bytes]());
+    if (!bits) return nullptr;
+
+    _entries.push_back({itemIndex, font, textHash, (int16_t)width, (int16_t)height, ++_clock, std::move(bits)});
+    _stats.bytesUsed += bytes;
+    _stats.entries = _entries.size();
+    return &_entries.back();
+}
+
+void UIComboBoxTextCache::clear() {
+    _entries.clear();
+    _stats.bytesUsed = 0;
+    _stats.entries = 0;
+}
+
+void UIComboBoxTextCache::setBudget(size_t budgetBytes) {
+    _budgetBytes = budgetBytes;
+    while (!_entries.empty() && _stats.bytesUsed > _budgetBytes) {
+        evictOldest();
+    }
+}
+
+void UIComboBoxTextCache::resetStats() {
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.evictions = 0;
+}
+
+uint32_t UIComboBoxTextCache::hashText(const char* text) {
+    uint32_t hash = 2166136261UL;
+    while (*text) {
+        hash ^= (uint8_t)*text++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+void UIComboBoxTextCache::evictOldest() {
+    size_t oldest = 0;
+    for (size_t i = 1; i < _entries.size(); ++i) {
+        if (_entries[i].lastUse < _entries[oldest].lastUse) {
+            oldest = i;
+        }
+    }
+    removeAt(oldest);
+    _stats.evictions++;
+}
+
+void UIComboBoxTextCache::removeAt(size_t position) {
+    _stats.bytesUsed -= _entries[position].byteSize();
+    // L'ordre des entrées est sans importance : on remplace par la dernière.
+    if (position != _entries.size() - 1) {
+        _entries[position] = std::move(_entries.back());
+    }
+    _entries.pop_back();
+    _stats.entries = _entries.size();
+}
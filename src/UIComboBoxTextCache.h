@@ -0,0 +1,139 @@
+/**
+ * @file UIComboBoxTextCache.h
+ * @brief Cache LRU des libellés pré-rastérisés de la liste déroulante.
+ *
+ * Ce fichier déclare la classe UIComboBoxTextCache, qui conserve pour chaque élément
+ * le texte déjà rendu sous forme de bitmap 1 bit par pixel. Une ligne de la liste peut
+ * ainsi être redessinée par une simple copie de bitmap, sans décoder à nouveau les glyphes U8g2.
+ */
+
+#ifndef UICOMBOBOXTEXTCACHE_H
+#define UICOMBOBOXTEXTCACHE_H
+
+#include <Arduino.h>
+#include <vector>
+#include <memory>
+
+/**
+ * @class UIComboBoxTextCache
+ * @brief Cache à budget fixe de bitmaps de texte, indexés par élément et par police.
+ *
+ * Les bitmaps sont stockés ligne par ligne, bit de poids fort à gauche, chaque ligne étant
+ * complétée à l'octet (le format des sprites 1 bit de TFT_eSPI). Lorsque le budget est atteint,
+ * l'entrée la moins récemment utilisée est évincée.
+ */
+class UIComboBoxTextCache {
+public:
+    /**
+     * @struct Entry
+     * @brief Un libellé rastérisé.
+     */
+    struct Entry {
+        int itemIndex;                 /**< L'index de l'élément rendu. */
+        const uint8_t* font;           /**< La police utilisée pour le rendu. */
+        uint32_t textHash;             /**< Empreinte du texte rendu, pour détecter une modification. */
+        int16_t width;                 /**< Largeur du bitmap, en pixels. */
+        int16_t height;                /**< Hauteur du bitmap, en pixels. */
+        uint32_t lastUse;              /**< Horodatage logique du dernier accès (LRU). */
+        std::unique_ptr<uint8_t[]> bits; /**< Les pixels, 1 bit par pixel. */
+
+        /**
+         * @brief Retourne le nombre d'octets par ligne du bitmap.
+         */
+        int stride() const { return (width + 7) / 8; }
+        /**
+         * @brief Retourne la taille du bitmap en octets.
+         */
+        size_t byteSize() const { return (size_t)stride() * height; }
+    };
+
+    /**
+     * @struct Stats
+     * @brief Statistiques d'utilisation du cache.
+     */
+    struct Stats {
+        uint32_t hits = 0;      /**< Nombre de libellés trouvés dans le cache. */
+        uint32_t misses = 0;    /**< Nombre de libellés absents ou périmés. */
+        uint32_t evictions = 0; /**< Nombre d'entrées évincées pour respecter le budget. */
+        size_t bytesUsed = 0;   /**< Octets de bitmaps actuellement stockés. */
+        size_t entries = 0;     /**< Nombre d'entrées actuellement stockées. */
+
+        /**
+         * @brief Retourne le taux de succès du cache, entre 0 et 1.
+         */
+        float hitRate() const {
+            uint32_t total = hits + misses;
+            return total ? (float)hits / (float)total : 0.0f;
+        }
+    };
+
+    /**
+     * @brief Constructeur de la classe UIComboBoxTextCache.
+     * @param budgetBytes Nombre maximal d'octets de bitmaps conservés.
+     */
+    explicit UIComboBoxTextCache(size_t budgetBytes);
+
+    /**
+     * @brief Recherche le libellé d'un élément.
+     * Une entrée dont la police ou l'empreinte du texte diffère est considérée comme périmée et supprimée.
+     * @param itemIndex L'index de l'élément.
+     * @param font La police courante des éléments.
+     * @param textHash L'empreinte du texte courant de l'élément.
+     * @return L'entrée trouvée, ou `nullptr` si elle doit être rendue.
+     */
+    const Entry* find(int itemIndex, const uint8_t* font, uint32_t textHash);
+    /**
+     * @brief Réserve une entrée pour un nouveau libellé, en évinçant les entrées les plus anciennes si nécessaire.
+     * Le bitmap retourné est initialisé à zéro et doit être rempli par l'appelant.
+     * @param itemIndex L'index de l'élément.
+     * @param font La police utilisée pour le rendu.
+     * @param textHash L'empreinte du texte rendu.
+     * @param width Largeur du bitmap, en pixels.
+     * @param height Hauteur du bitmap, en pixels.
+     * @return L'entrée créée, ou `nullptr` si le bitmap dépasse le budget ou que l'allocation échoue.
+     */
+    Entry* insert(int itemIndex, const uint8_t* font, uint32_t textHash, int width, int height);
+    /**
+     * @brief Supprime toutes les entrées du cache.
+     */
+    void clear();
+    /**
+     * @brief Modifie le budget du cache, en évinçant les entrées excédentaires.
+     * @param budgetBytes Nombre maximal d'octets de bitmaps conservés.
+     */
+    void setBudget(size_t budgetBytes);
+
+    /**
+     * @brief Retourne les statistiques d'utilisation du cache.
+     */
+    const Stats& getStats() const { return _stats; }
+    /**
+     * @brief Remet à zéro les compteurs de succès, d'échecs et d'évictions.
+     */
+    void resetStats();
+
+    /**
+     * @brief Calcule l'empreinte (FNV-1a) d'un texte.
+     * @param text Le texte, terminé par un caractère nul.
+     * @return L'empreinte du texte.
+     */
+    static uint32_t hashText(const char* text);
+
+private:
+    /**
+     * @brief Évince l'entrée la moins récemment utilisée.
+     */
+    void evictOldest();
+    /**
+     * @brief Supprime l'entrée à la position donnée.
+     * @param position La position de l'entrée dans _entries.
+     */
+    void removeAt(size_t position);
+
+    std::vector<Entry> _entries; /**< Les libellés stockés. */
+    size_t _budgetBytes;         /**< Nombre maximal d'octets de bitmaps. */
+    uint32_t _clock = 0;         /**< Horloge logique incrémentée à chaque accès. */
+    Stats _stats;                /**< Les statistiques d'utilisation. */
+};
+
+#endif // UICOMBOBOXTEXTCACHE_H
@@ -0,0 +1,109 @@
+#include "UIComboBoxUnderlay.h"
+#include <new>
+#include <algorithm>
+
+namespace {
+    constexpr int STRIP_LINES = 8; // Nombre de lignes de pixels relues ou recopiées par transfert
+    constexpr uint16_t MAX_RUN_LENGTH = 0xFFFF; // Longueur maximale d'une plage, limitée par son codage sur 16 bits
+}
+
+bool UIComboBoxUnderlay::capture(TFT_eSPI& tft, const UIRect& area, size_t budgetBytes) {
+    clear();
+    if (area.w <= 0 || area.h <= 0) return false;
+
+    std::unique_ptr<uint16_t[]> strip(new (std::nothrow) uint16_t[area.w * STRIP_LINES]);
+    if (!strip) return false;
+
+    // Le tampon a la taille du budget : une zone qui ne s'y compresse pas est abandonnée sans réallocation.
+    size_t maxWords = budgetBytes / sizeof(uint16_t);
+    if (maxWords < 2) return false;
+    std::unique_ptr<uint16_t[]> runs(new (std::nothrow) uint16_t[maxWords]);
+    if (!runs) return false;
+
+    size_t words = 0;
+    uint16_t runColor = 0;
+    uint32_t runLength = 0;
+    for (int line = 0; line < area.h; line += STRIP_LINES) {
+        int lines = std::min(STRIP_LINES, area.h - line);
+        tft.readRect(area.x, area.y + line, area.w, lines, strip.get());
+        const uint16_t* pixel = strip.get();
+        const uint16_t* end = pixel + area.w * lines;
+        for (; pixel < end; ++pixel) {
+            if (runLength > 0 && *pixel == runColor && runLength < MAX_RUN_LENGTH) {
+                runLength++;
+                continue;
+            }
+            if (runLength > 0) {
+                if (words + 2 > maxWords) return false; // La zone ne tient pas dans le budget
+                runs[words++] = runLength;
+                runs[words++] = runColor;
+            }
+            runColor = *pixel;
+            runLength = 1;
+        }
+    }
+    if (words + 2 > maxWords) return false;
+    runs[words++] = runLength;
+    runs[words++] = runColor;
+
+    // Seule la partie utilisée est conservée, sauf si la copie ne peut pas être allouée.
+    _runCapacity = maxWords;
+    if (words < maxWords) {
+        std::unique_ptr<uint16_t[]> exact(new (std::nothrow) uint16_t[words]);
+        if (exact) {
+            std::copy(runs.get(), runs.get() + words, exact.get());
+            runs = std::move(exact);
+            _runCapacity = words;
+        }
+    }
+    _runs = std::move(runs);
+    _runWords = words;
+
+    _area = area;
+    _captured = true;
+    return true;
+}
+
+bool UIComboBoxUnderlay::restore(TFT_eSPI& tft) {
+    if (!_captured) return false;
+
+    std::unique_ptr<uint16_t[]> strip(new (std::nothrow) uint16_t[_area.w * STRIP_LINES]);
+    if (!strip) {
+        clear();
+        return false;
+    }
+
+    // Les plages sont décompressées bande par bande, puis recopiées au format relu par readRect.
+    size_t run = 0;
+    uint32_t remaining = _runWords > 0 ? _runs[0] : 0;
+    for (int line = 0; line < _area.h; line += STRIP_LINES) {
+        int lines = std::min(STRIP_LINES, _area.h - line);
+        uint16_t* pixel = strip.get();
+        uint16_t* end = pixel + _area.w * lines;
+        while (pixel < end && run < _runWords) {
+            uint32_t count = std::min<uint32_t>(remaining, end - pixel);
+            std::fill(pixel, pixel + count, _runs[run + 1]);
+            pixel += count;
+            remaining -= count;
+            if (remaining == 0) {
+                run += 2;
+                remaining = run < _runWords ? _runs[run] : 0;
+            }
+        }
+        tft.pushRect(_area.x, _area.y + line, _area.w, lines, strip.get());
+    }
+    clear();
+    return true;
+}
+
+void UIComboBoxUnderlay::clear() {
+    _runs.reset();
+    _runWords = 0;
+    _runCapacity = 0;
+    _captured = false;
+}
+
+bool UIComboBoxUnderlay::covers(const UIRect& other) const {
+    return _captured && other.x >= _area.x && other.y >= _area.y
+        && other.x + other.w <= _area.x + _area.w && other.y + other.h <= _area.y + _area.h;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file UIComboBoxUnderlay.h
+ * @brief Sauvegarde compressée des pixels recouverts par la liste déroulante dépliée.
+ *
+ * Ce fichier déclare la classe UIComboBoxUnderlay, qui relit à l'écran la zone que la liste
+ * va recouvrir, la conserve compressée par plages de couleur (RLE) et la recopie à l'écran
+ * au repliement. L'application n'a alors plus à redessiner ce qui se trouvait sous la liste.
+ */
+
+#ifndef UICOMBOBOXUNDERLAY_H
+#define UICOMBOBOXUNDERLAY_H
+
+#include <TFT_eSPI.h>
+#include <UITypes/UIRect.h>
+#include <memory>
+
+/**
+ * @class UIComboBoxUnderlay
+ * @brief Copie compressée d'une zone de l'écran, limitée à un budget mémoire.
+ *
+ * Les pixels sont relus par bandes de quelques lignes et stockés sous forme de couples
+ * (longueur, couleur) de 16 bits, une plage pouvant s'étendre sur plusieurs lignes. Un fond
+ * uni ne coûte ainsi que quelques octets. Les plages sont écrites dans un tampon de la taille
+ * du budget, alloué une fois, puis recopiées dans un tampon à leur taille exacte : la mémoire
+ * utilisée pendant la capture ne dépasse jamais le budget plus la taille finale. Si la zone ne
+ * se compresse pas assez pour tenir dans le budget, la capture est abandonnée.
+ * L'écran doit être relisible (MISO câblé).
+ */
+class UIComboBoxUnderlay {
+public:
+    /**
+     * @brief Relit et compresse une zone de l'écran, en remplaçant toute capture précédente.
+     * @param tft Référence à l'objet TFT_eSPI à relire.
+     * @param area La zone à sauvegarder.
+     * @param budgetBytes Taille maximale des données compressées, en octets.
+     * @return `true` si la zone a été sauvegardée, `false` si elle dépasse le budget ou qu'un tampon n'a pas pu être alloué.
+     */
+    bool capture(TFT_eSPI& tft, const UIRect& area, size_t budgetBytes);
+    /**
+     * @brief Recopie la zone sauvegardée à l'écran, puis libère la capture.
+     * @param tft Référence à l'objet TFT_eSPI pour le dessin.
+     * @return `true` si la zone a été restaurée, `false` si aucune capture n'était disponible.
+     */
+    bool restore(TFT_eSPI& tft);
+    /**
+     * @brief Abandonne la capture et libère sa mémoire.
+     */
+    void clear();
+
+    /**
+     * @brief Indique si une zone est actuellement sauvegardée.
+     */
+    bool isCaptured() const { return _captured; }
+    /**
+     * @brief Retourne la zone sauvegardée.
+     */
+    const UIRect& area() const { return _area; }
+    /**
+     * @brief Indique si la zone sauvegardée contient entièrement une autre zone.
+     * @param other La zone à tester.
+     */
+    bool covers(const UIRect& other) const;
+    /**
+     * @brief Retourne la mémoire occupée par les données compressées, en octets.
+     */
+    size_t memoryUsage() const { return _runCapacity * sizeof(uint16_t); }
+
+private:
+    std::unique_ptr<uint16_t[]> _runs; /**< Couples (longueur, couleur) dans l'ordre de balayage de la zone. */
+    size_t _runWords = 0;              /**< Le nombre de mots utilisés dans _runs. */
+    size_t _runCapacity = 0;           /**< Le nombre de mots alloués pour _runs. */
+    UIRect _area = {0, 0, 0, 0};       /**< La zone sauvegardée. */
+    bool _captured = false;            /**< Indique si _runs décrit la zone _area. */
+};
+
+#endif // UICOMBOBOXUNDERLAY_H
@@ -0,0 +1,83 @@
+/**
+ * @file UIComboBoxTest.h
+ * @brief Mini-cadre de test des programmes de test sur PC.
+ *
+ * Chaque fichier de test déclare ses cas avec TEST_CASE(). Les vérifications CHECK() et
+ * CHECK_EQ() signalent l'échec sans interrompre le cas ; le programme se termine en erreur
+ * si au moins une vérification a échoué. Un argument en ligne de commande ne lance que les
+ * cas dont le nom le contient.
+ */
+
+#ifndef UICOMBOBOX_TEST_H
+#define UICOMBOBOX_TEST_H
+
+#include <UIComboBox.h>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace uicombobox_test {
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& registry();
+void fail(const char* file, int line, const std::string& message);
+
+struct Registrar {
+    Registrar(const char* name, void (*run)()) { registry().push_back({ name, run }); }
+};
+
+template<typename A, typename B>
+void checkEqual(const A& actual, const B& expected, const char* actualText, const char* expectedText, const char* file, int line) {
+    if (actual == expected) return;
+    std::ostringstream message;
+    message << actualText << " == " << expectedText << " (" << actual << " != " << expected << ")";
+    fail(file, line, message.str());
+}
+
+/**
+ * @brief Ajoute count éléments "Item 0", "Item 1"... de valeurs 0, 1...
+ */
+inline void addNumberedItems(UIComboBox& comboBox, size_t count, const char* prefix = "Item ") {
+    comboBox.reserveItems(comboBox.getItemCount() + count, count * (strlen(prefix) + 6));
+    for (size_t i = 0; i < count; i++) {
+        std::string text = prefix + std::to_string(i);
+        comboBox.addItem(String(text.c_str()), (int)i);
+    }
+}
+
+/**
+ * @brief Indique si tous les pixels écrits depuis le dernier resetCounters() sont dans l'une des zones.
+ */
+inline bool touchedOnlyWithin(const TFT_eSPI& tft, std::initializer_list<UIRect> zones) {
+    for (int y = 0; y < tft.height(); y++) {
+        for (int x = 0; x < tft.width(); x++) {
+            if (!tft.isTouched(x, y)) continue;
+            bool inside = false;
+            for (const UIRect& zone : zones) {
+                if (x >= zone.x && y >= zone.y && x < zone.x + zone.w && y < zone.y + zone.h) inside = true;
+            }
+            if (!inside) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace uicombobox_test
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static uicombobox_test::Registrar name##Registrar(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { if (!(condition)) uicombobox_test::fail(__FILE__, __LINE__, #condition); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    uicombobox_test::checkEqual((actual), (expected), #actual, #expected, __FILE__, __LINE__)
+
+#endif // UICOMBOBOX_TEST_H
@@ -0,0 +1,35 @@
+#include "UIComboBoxTest.h"
+#include <cstdio>
+#include <cstring>
+
+namespace uicombobox_test {
+
+namespace {
+    int failures = 0;
+}
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void fail(const char* file, int line, const std::string& message) {
+    failures++;
+    fprintf(stderr, "%s:%d: échec : %s\n", file, line, message.c_str());
+}
+
+} // namespace uicombobox_test
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    for (const uicombobox_test::TestCase& test : uicombobox_test::registry()) {
+        if (filter && !strstr(test.name, filter)) continue;
+        int before = uicombobox_test::failures;
+        test.run();
+        run++;
+        printf("[%s] %s\n", uicombobox_test::failures == before ? " OK " : "ÉCHEC", test.name);
+    }
+    printf("%d cas, %d vérification(s) en échec\n", run, uicombobox_test::failures);
+    return uicombobox_test::failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file UIComboBoxBench.cpp
+ * @brief Banc d'essai du rendu de UIComboBox sur l'écran simulé.
+ *
+ * Pour chaque scénario et chaque taille de liste, mesure le coût moyen d'une interaction :
+ * appels de dessin, transactions SPI, pixels écrits, octets transmis et temps de calcul.
+ * Les résultats sont écrits en CSV (par défaut) ou en JSON sur la sortie standard.
+ *
+ * Usage : uicombobox_bench [--format csv|json] [--sizes 10,100,...] [--iterations N] [--check budgets.csv]
+ *
+ * Avec --check, chaque mesure est comparée aux budgets du fichier (colonnes scenario, items,
+ * max_pixels, max_spi_bytes) et le programme se termine en erreur si l'un d'eux est dépassé.
+ */
+
+#include <UIComboBox.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const UIRect COMBO_RECT = { 20, 40, 200, 30 };
+const int VISIBLE_ITEMS = 8;
+const int FRAME_MS = 16;
+
+/**
+ * @struct Bench
+ * @brief Le composant mesuré et son écran.
+ */
+struct Bench {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style;
+    std::unique_ptr<UIComboBox> comboBox;
+    int itemCount = 0;
+    int touchX = 0;   /**< Position du doigt pendant un glissement. */
+    int touchY = 0;
+    unsigned long nowMs = 0;
+
+    int listTop() const { return COMBO_RECT.y + COMBO_RECT.h; }
+    int rowCenterY(int slot) const { return listTop() + slot * style.itemHeight + style.itemHeight / 2; }
+};
+
+/**
+ * @struct Scenario
+ * @brief Une interaction mesurée : prepare() n'est pas mesurée, act() l'est.
+ */
+struct Scenario {
+    const char* name;
+    void (*setup)(Bench& bench);
+    void (*prepare)(Bench& bench, int iteration);
+    void (*act)(Bench& bench, int iteration);
+};
+
+void noSetup(Bench&) {}
+void noPrepare(Bench&, int) {}
+
+void expandList(Bench& bench) {
+    bench.comboBox->expand();
+    bench.comboBox->draw(bench.tft, false);
+}
+
+void startDrag(Bench& bench) {
+    expandList(bench);
+    bench.comboBox->setKineticScrolling(false);
+    bench.touchX = COMBO_RECT.x + COMBO_RECT.w / 2 - 20;
+    bench.touchY = bench.rowCenterY(VISIBLE_ITEMS / 2);
+    bench.comboBox->handleTouch(bench.tft, bench.touchX, bench.touchY, true);
+    // Dépasse le seuil de glissement, puis revient : le glissement est engagé.
+    bench.comboBox->handleTouch(bench.tft, bench.touchX, bench.touchY - 20, true);
+    bench.comboBox->updateScroll(bench.nowMs += FRAME_MS);
+    bench.comboBox->handleTouch(bench.tft, bench.touchX, bench.touchY, true);
+    bench.comboBox->updateScroll(bench.nowMs += FRAME_MS);
+    bench.comboBox->draw(bench.tft, false);
+}
+
+void startBlitDrag(Bench& bench) {
+    bench.comboBox->setBlitScrolling(true);
+    startDrag(bench);
+}
+
+void dragBy(Bench& bench, int iteration, int pixels) {
+    // Alterne vers le haut et vers le bas pour rester dans la plage de défilement.
+    bench.touchY += (iteration % 2 == 0) ? -pixels : pixels;
+    bench.comboBox->handleTouch(bench.tft, bench.touchX, bench.touchY, true);
+    bench.comboBox->updateScroll(bench.nowMs += FRAME_MS);
+    bench.comboBox->draw(bench.tft, false);
+}
+
+void startFilter(Bench& bench) {
+    bench.comboBox->setFilterEnabled(true);
+    expandList(bench);
+    bench.comboBox->setFilterText("Item 1");
+    bench.comboBox->draw(bench.tft, false);
+}
+
+void drawPending(Bench& bench, int) {
+    bench.comboBox->draw(bench.tft, false);
+}
+
+void startSorted(Bench& bench) {
+    bench.comboBox->setSortOrder(UIComboBoxSortIndex::SORT_TEXT);
+    bench.comboBox->setSectionHeaders(true);
+    expandList(bench);
+}
+
+void enableSprite(Bench& bench) {
+    bench.comboBox->setSpriteRendering(true, 64 * 1024);
+    expandList(bench);
+}
+
+const Scenario SCENARIOS[] = {
+    { "draw_collapsed_forced", noSetup, noPrepare,
+      [](Bench& b, int) { b.comboBox->draw(b.tft, true); } },
+    { "draw_expanded_forced", expandList, noPrepare,
+      [](Bench& b, int) { b.comboBox->draw(b.tft, true); } },
+    { "draw_expanded_idle", expandList, noPrepare,
+      [](Bench& b, int) { b.comboBox->draw(b.tft, false); } },
+    { "draw_expanded_sprite", enableSprite, noPrepare,
+      [](Bench& b, int) { b.comboBox->draw(b.tft, true); } },
+    { "select_collapsed", noSetup, noPrepare,
+      [](Bench& b, int i) { b.comboBox->setSelectedIndex((i + 1) % b.itemCount); b.comboBox->draw(b.tft, false); } },
+    { "select_expanded", expandList, noPrepare,
+      [](Bench& b, int i) { b.comboBox->setSelectedIndex(1 + i % 2); b.comboBox->draw(b.tft, false); } },
+    { "scroll_row", startDrag, noPrepare,
+      [](Bench& b, int i) { dragBy(b, i, b.style.itemHeight); } },
+    { "scroll_3px", startDrag, noPrepare,
+      [](Bench& b, int i) { dragBy(b, i, 3); } },
+    { "scroll_3px_blit", startBlitDrag, noPrepare,
+      [](Bench& b, int i) { dragBy(b, i, 3); } },
+    { "filter_insert", startFilter, noPrepare,
+      [](Bench& b, int i) {
+          b.comboBox->insertItem(b.itemCount / 2, String(("Item 1" + std::to_string(i)).c_str()), -i);
+          b.comboBox->draw(b.tft, false);
+      } },
+    // Mise à jour de l'ordre de tri seule : l'image de l'itération précédente est dessinée hors mesure.
+    { "sorted_insert", startSorted, drawPending,
+      [](Bench& b, int i) { b.comboBox->insertItem(b.itemCount / 2, String(("Item 5" + std::to_string(i)).c_str()), -i); } },
+    { "sorted_update", startSorted, drawPending,
+      [](Bench& b, int i) {
+          // L'élément change de rang et de section.
+          int item = (i * 7919) % b.itemCount;
+          b.comboBox->updateItem(item, String(((i % 2 ? "Item 9" : "Item 1") + std::to_string(i)).c_str()), item);
+      } },
+    { "press_expand", noSetup,
+      [](Bench& b, int) { b.comboBox->collapse(); b.comboBox->draw(b.tft, false); },
+      [](Bench& b, int) {
+          b.comboBox->handlePress(b.tft, COMBO_RECT.x + 10, COMBO_RECT.y + COMBO_RECT.h / 2);
+          b.comboBox->draw(b.tft, false);
+      } },
+    { "press_select", noSetup,
+      [](Bench& b, int) { expandList(b); },
+      [](Bench& b, int i) {
+          b.comboBox->handlePress(b.tft, COMBO_RECT.x + 10, b.rowCenterY(1 + i % 2));
+          b.comboBox->draw(b.tft, false);
+      } },
+};
+
+/**
+ * @struct Result
+ * @brief Coût moyen d'une interaction.
+ */
+struct Result {
+    std::string scenario;
+    int items;
+    int iterations;
+    double calls;
+    double transactions;
+    double pixels;
+    double spiBytes;
+    double nsPerOp;
+};
+
+Result run(const Scenario& scenario, int itemCount, int iterations) {
+    Bench bench;
+    bench.itemCount = itemCount;
+    bench.style.maxVisibleItems = VISIBLE_ITEMS;
+    bench.u8f.begin(bench.tft);
+    bench.comboBox.reset(new UIComboBox(bench.u8f, COMBO_RECT, "Choix", &bench.style));
+
+    std::vector<UIComboBoxItem> items;
+    items.reserve(itemCount);
+    for (int i = 0; i < itemCount; i++) {
+        items.push_back({ String(("Item " + std::to_string(i)).c_str()), i });
+    }
+    bench.comboBox->addItems(std::move(items));
+    bench.comboBox->draw(bench.tft, true);
+    scenario.setup(bench);
+
+    uint64_t calls = 0, transactions = 0, pixels = 0, spiBytes = 0;
+    std::chrono::nanoseconds elapsed(0);
+    for (int i = 0; i < iterations; i++) {
+        scenario.prepare(bench, i);
+        bench.tft.resetCounters();
+        auto start = std::chrono::steady_clock::now();
+        scenario.act(bench, i);
+        elapsed += std::chrono::steady_clock::now() - start;
+        const MockDisplayCounters& counters = bench.tft.counters;
+        calls += counters.calls();
+        transactions += counters.transactions;
+        pixels += counters.pixelsWritten;
+        spiBytes += counters.spiBytes;
+    }
+
+    Result result;
+    result.scenario = scenario.name;
+    result.items = itemCount;
+    result.iterations = iterations;
+    result.calls = (double)calls / iterations;
+    result.transactions = (double)transactions / iterations;
+    result.pixels = (double)pixels / iterations;
+    result.spiBytes = (double)spiBytes / iterations;
+    result.nsPerOp = (double)elapsed.count() / iterations;
+    return result;
+}
+
+void printCsv(const std::vector<Result>& results) {
+    printf("scenario,items,iterations,calls,transactions,pixels,spi_bytes,ns_per_op\n");
+    for (const Result& r : results) {
+        printf("%s,%d,%d,%.1f,%.1f,%.1f,%.1f,%.0f\n", r.scenario.c_str(), r.items, r.iterations,
+               r.calls, r.transactions, r.pixels, r.spiBytes, r.nsPerOp);
+    }
+}
+
+void printJson(const std::vector<Result>& results) {
+    printf("[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        printf("  {\"scenario\": \"%s\", \"items\": %d, \"iterations\": %d, \"calls\": %.1f, \"transactions\": %.1f, "
+               "\"pixels\": %.1f, \"spi_bytes\": %.1f, \"ns_per_op\": %.0f}%s\n",
+               r.scenario.c_str(), r.items, r.iterations, r.calls, r.transactions, r.pixels, r.spiBytes, r.nsPerOp,
+               i + 1 < results.size() ? "," : "");
+    }
+    printf("]\n");
+}
+
+/**
+ * @brief Compare les mesures aux budgets ; retourne le nombre de dépassements (-1 si le fichier est illisible).
+ */
+int checkBudgets(const std::vector<Result>& results, const char* path) {
+    std::ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "budgets introuvables : %s\n", path);
+        return -1;
+    }
+    int exceeded = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#' || line.compare(0, 8, "scenario") == 0) continue;
+        std::istringstream fields(line);
+        std::string scenario, items, maxPixels, maxSpiBytes;
+        std::getline(fields, scenario, ',');
+        std::getline(fields, items, ',');
+        std::getline(fields, maxPixels, ',');
+        std::getline(fields, maxSpiBytes, ',');
+        for (const Result& r : results) {
+            if (r.scenario != scenario || r.items != atoi(items.c_str())) continue;
+            if (r.pixels > atof(maxPixels.c_str()) || r.spiBytes > atof(maxSpiBytes.c_str())) {
+                fprintf(stderr, "budget dépassé : %s, %d éléments : %.1f pixels (max %s), %.1f octets (max %s)\n",
+                        r.scenario.c_str(), r.items, r.pixels, maxPixels.c_str(), r.spiBytes, maxSpiBytes.c_str());
+                exceeded++;
+            }
+        }
+    }
+    return exceeded;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool json = false;
+    int iterations = 20;
+    const char* budgets = nullptr;
+    std::vector<int> sizes = { 10, 100, 1000, 10000, 100000 };
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--format") && hasValue) {
+            json = !strcmp(argv[++i], "json");
+        } else if (!strcmp(argv[i], "--iterations") && hasValue) {
+            iterations = std::max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--check") && hasValue) {
+            budgets = argv[++i];
+        } else if (!strcmp(argv[i], "--sizes") && hasValue) {
+            sizes.clear();
+            std::istringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ',')) sizes.push_back(atoi(size.c_str()));
+        } else {
+            fprintf(stderr, "usage : %s [--format csv|json] [--sizes 10,100,...] [--iterations N] [--check budgets.csv]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Result> results;
+    for (const Scenario& scenario : SCENARIOS) {
+        for (int size : sizes) results.push_back(run(scenario, size, iterations));
+    }
+    if (json) {
+        printJson(results);
+    } else {
+        printCsv(results);
+    }
+    if (budgets) {
+        int exceeded = checkBudgets(results, budgets);
+        if (exceeded != 0) return 1;
+    }
+    return 0;
+}
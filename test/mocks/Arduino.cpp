@@ -0,0 +1,14 @@
+#include "Arduino.h"
+#include <chrono>
+
+namespace {
+    const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - START).count();
+}
@@ -0,0 +1,67 @@
+/**
+ * @file Arduino.h
+ * @brief Substitut minimal du cœur Arduino pour la compilation sur PC.
+ *
+ * Ce fichier fournit le sous-ensemble de l'API Arduino utilisé par la bibliothèque :
+ * la classe String, les macros PROGMEM et les temporisations micros() / millis().
+ * Il ne fait pas partie de la bibliothèque et n'est utilisé que par les tests.
+ */
+
+#ifndef UICOMBOBOX_MOCK_ARDUINO_H
+#define UICOMBOBOX_MOCK_ARDUINO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#define PROGMEM
+#define F(text) (text)
+
+inline void* memcpy_P(void* destination, const void* source, size_t length) { return memcpy(destination, source, length); }
+inline char* strncpy_P(char* destination, const char* source, size_t length) { return strncpy(destination, source, length); }
+inline size_t strlen_P(const char* text) { return strlen(text); }
+
+/**
+ * @brief Retourne le nombre de microsecondes écoulées depuis le démarrage du programme.
+ */
+unsigned long micros();
+/**
+ * @brief Retourne le nombre de millisecondes écoulées depuis le démarrage du programme.
+ */
+unsigned long millis();
+
+/**
+ * @class String
+ * @brief Chaîne de caractères Arduino, reposant sur std::string.
+ */
+class String {
+public:
+    String() = default;
+    String(const char* text) : _text(text ? text : "") {}
+    String(const char* text, size_t length) : _text(text, length) {}
+    explicit String(int value) : _text(std::to_string(value)) {}
+
+    const char* c_str() const { return _text.c_str(); }
+    unsigned int length() const { return (unsigned int)_text.size(); }
+    bool isEmpty() const { return _text.empty(); }
+    char operator[](unsigned int index) const { return _text[index]; }
+    bool reserve(unsigned int size) { _text.reserve(size); return true; }
+    void remove(unsigned int index) { _text.erase(index); }
+    void remove(unsigned int index, unsigned int count) { _text.erase(index, count); }
+    bool concat(const char* text, unsigned int length) { _text.append(text, length); return true; }
+    String substring(unsigned int from, unsigned int to) const { return String(_text.substr(from, to - from).c_str()); }
+
+    String& operator+=(char c) { _text += c; return *this; }
+    String& operator+=(const char* text) { _text += text; return *this; }
+    String& operator+=(const String& other) { _text += other._text; return *this; }
+    bool operator==(const String& other) const { return _text == other._text; }
+    bool operator!=(const String& other) const { return _text != other._text; }
+    bool operator==(const char* text) const { return _text == text; }
+    bool operator!=(const char* text) const { return _text != text; }
+
+private:
+    std::string _text;
+};
+
+#endif // UICOMBOBOX_MOCK_ARDUINO_H
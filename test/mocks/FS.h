@@ -0,0 +1,64 @@
+/**
+ * @file FS.h
+ * @brief Substitut du système de fichiers Arduino, adossé aux fichiers du PC.
+ */
+
+#ifndef UICOMBOBOX_MOCK_FS_H
+#define UICOMBOBOX_MOCK_FS_H
+
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+/**
+ * @class File
+ * @brief Un fichier ouvert. Les copies partagent le même descripteur, comme sur la cible.
+ */
+class File {
+public:
+    File() = default;
+    explicit File(FILE* file) : _file(file, [](FILE* f) { fclose(f); }) {}
+
+    explicit operator bool() const { return (bool)_file; }
+
+    bool seek(uint32_t position, SeekMode mode = SeekSet) {
+        static const int ORIGINS[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+        return _file && fseek(_file.get(), (long)position, ORIGINS[mode]) == 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t size) { return _file ? fread(buffer, 1, size, _file.get()) : 0; }
+
+    size_t size() const {
+        if (!_file) return 0;
+        long position = ftell(_file.get());
+        fseek(_file.get(), 0, SEEK_END);
+        long size = ftell(_file.get());
+        fseek(_file.get(), position, SEEK_SET);
+        return (size_t)size;
+    }
+
+    void close() { _file.reset(); }
+
+private:
+    std::shared_ptr<FILE> _file;
+};
+
+/**
+ * @class FS
+ * @brief Un système de fichiers dont les chemins sont ceux du PC.
+ */
+class FS {
+public:
+    File open(const char* path, const char* mode = "rb") {
+        FILE* file = fopen(path, mode);
+        return file ? File(file) : File();
+    }
+};
+
+} // namespace fs
+
+#endif // UICOMBOBOX_MOCK_FS_H
@@ -0,0 +1,342 @@
+#include "TFT_eSPI.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+namespace {
+    size_t allocationLimit = SIZE_MAX;
+    uint32_t pendingFailures = 0;
+    uint32_t allocations = 0;
+    uint32_t failedAllocations = 0;
+
+    inline uint16_t swap16(uint16_t value) { return (uint16_t)((value << 8) | (value >> 8)); }
+}
+
+// --- TFT_eSPI ---
+
+TFT_eSPI::TFT_eSPI(int16_t width, int16_t height) : TFT_eSPI(width, height, false) {
+    _memory.assign((size_t)width * height, TFT_BLACK);
+    _touched.assign((size_t)width * height, 0);
+}
+
+TFT_eSPI::TFT_eSPI(int16_t width, int16_t height, bool sprite) : _sprite(sprite), _width(width), _height(height) {
+    resetViewport();
+}
+
+void TFT_eSPI::resize(int16_t width, int16_t height) {
+    _width = width;
+    _height = height;
+    resetViewport();
+}
+
+void TFT_eSPI::storePixel(int32_t x, int32_t y, uint16_t color) {
+    size_t offset = (size_t)y * _width + x;
+    _memory[offset] = color;
+    _touched[offset] = 1;
+}
+
+uint32_t TFT_eSPI::fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    x += _datumX;
+    y += _datumY;
+    int32_t x0 = std::max(x, _clipX0), y0 = std::max(y, _clipY0);
+    int32_t x1 = std::min(x + w, _clipX1), y1 = std::min(y + h, _clipY1);
+    if (x0 >= x1 || y0 >= y1) return 0;
+    for (int32_t py = y0; py < y1; py++) {
+        for (int32_t px = x0; px < x1; px++) storePixel(px, py, color);
+    }
+    uint32_t pixels = (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+    counters.pixelsWritten += pixels;
+    return pixels;
+}
+
+void TFT_eSPI::pushClipped(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data, bool swap) {
+    int32_t left = x + _datumX, top = y + _datumY;
+    int32_t x0 = std::max(left, _clipX0), y0 = std::max(top, _clipY0);
+    int32_t x1 = std::min(left + w, _clipX1), y1 = std::min(top + h, _clipY1);
+    if (x0 >= x1 || y0 >= y1) return;
+    for (int32_t py = y0; py < y1; py++) {
+        const uint16_t* row = data + (size_t)(py - top) * w;
+        for (int32_t px = x0; px < x1; px++) {
+            uint16_t word = row[px - left];
+            storePixel(px, py, swap ? word : swap16(word));
+        }
+    }
+    uint32_t pixels = (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+    counters.pixelsWritten += pixels;
+    countWindow(pixels);
+}
+
+void TFT_eSPI::countWindow(uint32_t pixels) {
+    if (_sprite) return;
+    if (_writeDepth == 0) counters.transactions++;
+    counters.spiBytes += WINDOW_BYTES + 2ull * pixels;
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    counters.drawPixel++;
+    if (fillClipped(x, y, 1, 1, (uint16_t)color)) countWindow(1);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    counters.fastHLine++;
+    uint32_t pixels = fillClipped(x, y, w, 1, (uint16_t)color);
+    if (pixels) countWindow(pixels);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+    counters.fastVLine++;
+    uint32_t pixels = fillClipped(x, y, 1, h, (uint16_t)color);
+    if (pixels) countWindow(pixels);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    counters.fillRect++;
+    uint32_t pixels = fillClipped(x, y, w, h, (uint16_t)color);
+    if (pixels) countWindow(pixels);
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+    fillRect(-_datumX, -_datumY, _width, _height, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    counters.drawRect++;
+    // Comme TFT_eSPI : quatre lignes, chacune dans sa propre fenêtre.
+    const int32_t lines[4][4] = { { x, y, w, 1 }, { x, y + h - 1, w, 1 }, { x, y, 1, h }, { x + w - 1, y, 1, h } };
+    for (const auto& line : lines) {
+        uint32_t pixels = fillClipped(line[0], line[1], line[2], line[3], (uint16_t)color);
+        if (pixels) countWindow(pixels);
+    }
+}
+
+void TFT_eSPI::fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color) {
+    counters.fillTriangle++;
+    // Remplissage par lignes horizontales, comme Adafruit_GFX et TFT_eSPI.
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+    if (y1 > y2) { std::swap(y2, y1); std::swap(x2, x1); }
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+
+    auto span = [&](int32_t a, int32_t b, int32_t y) {
+        if (a > b) std::swap(a, b);
+        uint32_t pixels = fillClipped(a, y, b - a + 1, 1, (uint16_t)color);
+        if (pixels) countWindow(pixels);
+    };
+
+    if (y0 == y2) {
+        span(std::min({ x0, x1, x2 }), std::max({ x0, x1, x2 }), y0);
+        return;
+    }
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    int32_t last = (y1 == y2) ? y1 : y1 - 1;
+    int32_t y = y0;
+    for (; y <= last; y++) {
+        span(x0 + sa / dy01, x0 + sb / dy02, y);
+        sa += dx01;
+        sb += dx02;
+    }
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        span(x1 + sa / dy12, x0 + sb / dy02, y);
+        sa += dx12;
+        sb += dx02;
+    }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+    counters.pushImage++;
+    pushClipped(x, y, w, h, data, _swapBytes);
+}
+
+void TFT_eSPI::pushRect(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+    // pushRect() ignore setSwapBytes() : les mots sont ceux rendus par readRect().
+    counters.pushImage++;
+    pushClipped(x, y, w, h, data, false);
+}
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer) {
+    (void)buffer;
+    counters.pushImageDMA++;
+    pushClipped(x, y, w, h, data, _swapBytes);
+}
+
+void TFT_eSPI::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+    counters.readRect++;
+    int32_t left = x + _datumX, top = y + _datumY;
+    int32_t x0 = std::max(left, _clipX0), y0 = std::max(top, _clipY0);
+    int32_t x1 = std::min(left + w, _clipX1), y1 = std::min(top + h, _clipY1);
+    if (x0 >= x1 || y0 >= y1) return;
+    for (int32_t py = y0; py < y1; py++) {
+        for (int32_t px = x0; px < x1; px++) {
+            data[(size_t)(py - top) * w + (px - left)] = swap16(_memory[(size_t)py * _width + px]);
+        }
+    }
+    uint32_t pixels = (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+    counters.pixelsRead += pixels;
+    if (_writeDepth == 0) counters.transactions++;
+    counters.spiBytes += WINDOW_BYTES + 1 + 3ull * pixels;
+}
+
+void TFT_eSPI::startWrite() {
+    if (_writeDepth++ == 0 && !_sprite) counters.transactions++;
+}
+
+void TFT_eSPI::endWrite() {
+    if (_writeDepth > 0) _writeDepth--;
+}
+
+void TFT_eSPI::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+    counters.addrWindow++;
+    _windowX = x + _datumX;
+    _windowY = y + _datumY;
+    _windowW = w;
+    _windowH = h;
+    _windowPosition = 0;
+    if (!_sprite) {
+        if (_writeDepth == 0) counters.transactions++;
+        counters.spiBytes += WINDOW_BYTES;
+    }
+}
+
+void TFT_eSPI::pushBlock(uint16_t color, uint32_t count) {
+    counters.pushBlock++;
+    if (_windowW <= 0 || _windowH <= 0) return;
+    // La fenêtre d'adresse n'est pas découpée par la zone d'affichage, seulement par l'écran.
+    uint32_t area = (uint32_t)_windowW * (uint32_t)_windowH;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t position = _windowPosition++ % area;
+        int32_t px = _windowX + (int32_t)(position % _windowW);
+        int32_t py = _windowY + (int32_t)(position / _windowW);
+        if (px >= 0 && py >= 0 && px < _width && py < _height) storePixel(px, py, color);
+    }
+    counters.pixelsWritten += count;
+    if (!_sprite) counters.spiBytes += 2ull * count;
+}
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum) {
+    _clipX0 = std::max<int32_t>(x, 0);
+    _clipY0 = std::max<int32_t>(y, 0);
+    _clipX1 = std::min<int32_t>(x + w, _width);
+    _clipY1 = std::min<int32_t>(y + h, _height);
+    _datumX = vpDatum ? x : 0;
+    _datumY = vpDatum ? y : 0;
+}
+
+void TFT_eSPI::resetViewport() {
+    _clipX0 = 0;
+    _clipY0 = 0;
+    _clipX1 = _width;
+    _clipY1 = _height;
+    _datumX = 0;
+    _datumY = 0;
+}
+
+void TFT_eSPI::resetCounters() {
+    counters = MockDisplayCounters();
+    std::fill(_touched.begin(), _touched.end(), 0);
+}
+
+void TFT_eSPI::clearMemory(uint16_t color) {
+    std::fill(_memory.begin(), _memory.end(), color);
+}
+
+size_t TFT_eSPI::touchedCount() const {
+    return (size_t)std::count(_touched.begin(), _touched.end(), 1);
+}
+
+UIRect TFT_eSPI::touchedBounds() const {
+    int x0 = INT_MAX, y0 = INT_MAX, x1 = -1, y1 = -1;
+    for (int y = 0; y < _height; y++) {
+        for (int x = 0; x < _width; x++) {
+            if (!_touched[(size_t)y * _width + x]) continue;
+            x0 = std::min(x0, x);
+            y0 = std::min(y0, y);
+            x1 = std::max(x1, x);
+            y1 = std::max(y1, y);
+        }
+    }
+    if (x1 < 0) return UIRect{ 0, 0, 0, 0 };
+    return UIRect{ x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+}
+
+size_t TFT_eSPI::countDifferences(const TFT_eSPI& a, const TFT_eSPI& b) {
+    size_t differences = 0;
+    for (size_t i = 0; i < a._memory.size() && i < b._memory.size(); i++) {
+        if (a._memory[i] != b._memory[i]) differences++;
+    }
+    return differences;
+}
+
+// --- TFT_eSprite ---
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0, true), _tft(tft) {}
+
+TFT_eSprite::~TFT_eSprite() {
+    deleteSprite();
+}
+
+void* TFT_eSprite::createSprite(int16_t width, int16_t height, uint8_t frames) {
+    if (_created) return _buffer.data(); // Comme TFT_eSPI : le sprite existant est conservé.
+    if (width <= 0 || height <= 0) return nullptr;
+    size_t bytes = (_bits == 1) ? (size_t)((width + 7) / 8) * height : (size_t)width * height * 2;
+    bytes *= std::max<uint8_t>(frames, 1);
+    if (pendingFailures > 0 || bytes > allocationLimit) {
+        if (pendingFailures > 0) pendingFailures--;
+        failedAllocations++;
+        return nullptr;
+    }
+    _buffer.assign(bytes, 0);
+    _created = true;
+    allocations++;
+    resize(width, height);
+    return _buffer.data();
+}
+
+void TFT_eSprite::deleteSprite() {
+    if (!_created) return;
+    std::vector<uint8_t>().swap(_buffer);
+    _created = false;
+    resize(0, 0);
+}
+
+void* TFT_eSprite::setColorDepth(int8_t bits) {
+    _bits = (bits == 1) ? 1 : 16;
+    if (!_created) return nullptr;
+    int16_t width = _width, height = _height;
+    deleteSprite();
+    return createSprite(width, height);
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+    if (!_created || _bits != 16) return;
+    bool swap = _tft->getSwapBytes();
+    _tft->setSwapBytes(false);
+    _tft->pushImage(x, y, _width, _height, (const uint16_t*)_buffer.data());
+    _tft->setSwapBytes(swap);
+}
+
+void TFT_eSprite::storePixel(int32_t x, int32_t y, uint16_t color) {
+    if (_bits == 1) {
+        uint8_t& byte = _buffer[(size_t)y * ((_width + 7) / 8) + (x >> 3)];
+        uint8_t mask = (uint8_t)(0x80 >> (x & 7));
+        byte = color ? (byte | mask) : (byte & ~mask);
+        return;
+    }
+    ((uint16_t*)_buffer.data())[(size_t)y * _width + x] = swap16(color);
+}
+
+void TFT_eSprite::setAllocationLimit(size_t bytes) { allocationLimit = bytes; }
+void TFT_eSprite::failNextAllocations(uint32_t count) { pendingFailures = count; }
+void TFT_eSprite::resetAllocationControl() {
+    allocationLimit = SIZE_MAX;
+    pendingFailures = 0;
+    allocations = 0;
+    failedAllocations = 0;
+}
+uint32_t TFT_eSprite::allocationCount() { return allocations; }
+uint32_t TFT_eSprite::failedAllocationCount() { return failedAllocations; }
@@ -0,0 +1,233 @@
+/**
+ * @file TFT_eSPI.h
+ * @brief Substitut instrumenté de TFT_eSPI pour la compilation sur PC.
+ *
+ * L'écran est simulé par une mémoire d'image RGB565 : chaque primitive y écrit réellement
+ * ses pixels, ce qui permet de comparer deux rendus pixel par pixel. Chaque appel est compté,
+ * ainsi que les pixels écrits et une estimation des octets transmis sur le bus SPI.
+ *
+ * Modèle de coût SPI (contrôleurs ILI9341 / ILI9488 / ST7789) :
+ * - ouverture d'une fenêtre d'adresse (CASET, PASET, RAMWR et leurs paramètres) : 11 octets ;
+ * - pixel écrit : 2 octets ;
+ * - lecture (RAMRD) : 11 octets de fenêtre, 1 octet factice puis 3 octets par pixel lu.
+ *
+ * Les sprites reproduisent le format de TFT_eSPI : 16 bits par pixel avec les octets inversés
+ * (l'ordre attendu par l'écran), ou 1 bit par pixel, bit de poids fort à gauche. Leur allocation
+ * peut être limitée ou mise en échec pour exercer les chemins de repli.
+ */
+
+#ifndef UICOMBOBOX_MOCK_TFT_ESPI_H
+#define UICOMBOBOX_MOCK_TFT_ESPI_H
+
+#include <Arduino.h>
+#include <UITypes/UIRect.h>
+#include <vector>
+
+#define TFT_BLACK     0x0000
+#define TFT_NAVY      0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_MAROON    0x7800
+#define TFT_DARKGREY  0x7BEF
+#define TFT_BLUE      0x001F
+#define TFT_GREEN     0x07E0
+#define TFT_CYAN      0x07FF
+#define TFT_RED       0xF800
+#define TFT_MAGENTA   0xF81F
+#define TFT_YELLOW    0xFFE0
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_WHITE     0xFFFF
+
+/**
+ * @struct MockDisplayCounters
+ * @brief Compteurs d'activité d'un écran ou d'un sprite simulé.
+ */
+struct MockDisplayCounters {
+    uint32_t drawPixel = 0;     /**< Appels à drawPixel(). */
+    uint32_t fastHLine = 0;     /**< Appels à drawFastHLine(). */
+    uint32_t fastVLine = 0;     /**< Appels à drawFastVLine(). */
+    uint32_t fillRect = 0;      /**< Appels à fillRect() et fillScreen(). */
+    uint32_t drawRect = 0;      /**< Appels à drawRect(). */
+    uint32_t fillTriangle = 0;  /**< Appels à fillTriangle(). */
+    uint32_t pushImage = 0;     /**< Appels à pushImage(), pushRect() et pushSprite(). */
+    uint32_t pushImageDMA = 0;  /**< Appels à pushImageDMA(). */
+    uint32_t pushBlock = 0;     /**< Appels à pushBlock(). */
+    uint32_t addrWindow = 0;    /**< Appels à setAddrWindow(). */
+    uint32_t readRect = 0;      /**< Appels à readRect(). */
+    uint32_t transactions = 0;  /**< Transactions SPI (sélection de l'écran). */
+    uint64_t pixelsWritten = 0; /**< Pixels écrits après découpage, écritures répétées comprises. */
+    uint64_t pixelsRead = 0;    /**< Pixels relus depuis l'écran. */
+    uint64_t spiBytes = 0;      /**< Octets transmis sur le bus, dans les deux sens. */
+
+    /**
+     * @brief Retourne le nombre total d'appels de dessin et de transfert.
+     */
+    uint32_t calls() const {
+        return drawPixel + fastHLine + fastVLine + fillRect + drawRect + fillTriangle
+             + pushImage + pushImageDMA + pushBlock + readRect;
+    }
+};
+
+/**
+ * @class TFT_eSPI
+ * @brief Écran simulé par une mémoire d'image RGB565.
+ */
+class TFT_eSPI {
+public:
+    static const uint32_t WINDOW_BYTES = 11; /**< Octets de commande pour ouvrir une fenêtre d'adresse. */
+
+    explicit TFT_eSPI(int16_t width = 320, int16_t height = 480);
+    virtual ~TFT_eSPI() = default;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    virtual void drawPixel(int32_t x, int32_t y, uint32_t color);
+    virtual void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+    virtual void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+    virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillScreen(uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color);
+
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+    void pushRect(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+    void readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+
+    bool initDMA() { DMA_Enabled = true; return true; }
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr);
+    void dmaWait() {}
+
+    void startWrite();
+    void endWrite();
+    void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+    void pushBlock(uint16_t color, uint32_t count);
+
+    bool getSwapBytes() const { return _swapBytes; }
+    void setSwapBytes(bool swap) { _swapBytes = swap; }
+
+    void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
+    void resetViewport();
+
+    bool DMA_Enabled = false; /**< Vrai lorsque les transferts DMA sont disponibles. */
+
+    // --- Instrumentation (propre au substitut) ---
+
+    MockDisplayCounters counters; /**< Activité depuis le dernier resetCounters(). */
+
+    /**
+     * @brief Remet les compteurs et la carte des pixels touchés à zéro.
+     */
+    void resetCounters();
+    /**
+     * @brief Remplit la mémoire d'image sans compter l'opération ni marquer les pixels.
+     */
+    void clearMemory(uint16_t color);
+    /**
+     * @brief Retourne la couleur d'un pixel de la mémoire d'image.
+     */
+    uint16_t pixelAt(int32_t x, int32_t y) const { return _memory[(size_t)y * _width + x]; }
+    /**
+     * @brief Indique si un pixel a été écrit depuis le dernier resetCounters().
+     */
+    bool isTouched(int32_t x, int32_t y) const { return _touched[(size_t)y * _width + x] != 0; }
+    /**
+     * @brief Retourne le nombre de pixels distincts écrits depuis le dernier resetCounters().
+     */
+    size_t touchedCount() const;
+    /**
+     * @brief Retourne le plus petit rectangle englobant les pixels écrits (w = 0 si aucun).
+     */
+    UIRect touchedBounds() const;
+    /**
+     * @brief Retourne le nombre de pixels qui diffèrent entre deux écrans de même taille.
+     */
+    static size_t countDifferences(const TFT_eSPI& a, const TFT_eSPI& b);
+
+protected:
+    /**
+     * @brief Construit une surface sans mémoire, pour les sprites.
+     */
+    TFT_eSPI(int16_t width, int16_t height, bool sprite);
+
+    /**
+     * @brief Écrit un pixel déjà découpé dans la mémoire de la surface.
+     */
+    virtual void storePixel(int32_t x, int32_t y, uint16_t color);
+    /**
+     * @brief Remplit un rectangle après découpage ; retourne le nombre de pixels écrits.
+     */
+    uint32_t fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    /**
+     * @brief Envoie une image après découpage ; les mots sont byte-swappés si swap est faux.
+     */
+    void pushClipped(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data, bool swap);
+    /**
+     * @brief Compte l'envoi d'une fenêtre de pixels sur le bus (rien pour un sprite).
+     */
+    void countWindow(uint32_t pixels);
+    /**
+     * @brief Redimensionne la surface et réinitialise sa zone d'affichage.
+     */
+    void resize(int16_t width, int16_t height);
+
+    bool _sprite;              /**< Vrai pour une surface hors écran. */
+    int16_t _width;            /**< Largeur de la surface. */
+    int16_t _height;           /**< Hauteur de la surface. */
+    bool _swapBytes = false;   /**< Inversion des octets des images envoyées. */
+
+private:
+    int32_t _clipX0 = 0, _clipY0 = 0, _clipX1 = 0, _clipY1 = 0; /**< Zone d'affichage, bornes exclues à droite. */
+    int32_t _datumX = 0, _datumY = 0;                          /**< Origine des coordonnées (vpDatum). */
+    int _writeDepth = 0;                                       /**< Imbrication de startWrite(). */
+    int32_t _windowX = 0, _windowY = 0, _windowW = 0, _windowH = 0; /**< Fenêtre d'adresse courante. */
+    uint32_t _windowPosition = 0;                              /**< Position d'écriture dans la fenêtre. */
+    std::vector<uint16_t> _memory;                             /**< Mémoire d'image de l'écran. */
+    std::vector<uint8_t> _touched;                             /**< Pixels écrits depuis le dernier resetCounters(). */
+};
+
+/**
+ * @class TFT_eSprite
+ * @brief Surface hors écran au format des sprites TFT_eSPI (16 bits inversés ou 1 bit).
+ */
+class TFT_eSprite : public TFT_eSPI {
+public:
+    explicit TFT_eSprite(TFT_eSPI* tft);
+    ~TFT_eSprite() override;
+
+    void* createSprite(int16_t width, int16_t height, uint8_t frames = 1);
+    void deleteSprite();
+    void* setColorDepth(int8_t bits);
+    int8_t getColorDepth() const { return _bits; }
+    bool created() const { return _created; }
+    void* getPointer() { return _created ? _buffer.data() : nullptr; }
+    void fillSprite(uint32_t color);
+    void pushSprite(int32_t x, int32_t y);
+
+    // --- Contrôle des allocations (propre au substitut) ---
+
+    /**
+     * @brief Fait échouer toute allocation de sprite de plus de bytes octets.
+     */
+    static void setAllocationLimit(size_t bytes);
+    /**
+     * @brief Fait échouer les count prochaines allocations de sprite, quelle que soit leur taille.
+     */
+    static void failNextAllocations(uint32_t count);
+    /**
+     * @brief Rétablit des allocations illimitées et remet les compteurs d'allocation à zéro.
+     */
+    static void resetAllocationControl();
+    static uint32_t allocationCount();       /**< Nombre de sprites alloués. */
+    static uint32_t failedAllocationCount(); /**< Nombre d'allocations refusées. */
+
+protected:
+    void storePixel(int32_t x, int32_t y, uint16_t color) override;
+
+private:
+    TFT_eSPI* _tft;               /**< L'écran parent, cible de pushSprite(). */
+    int8_t _bits = 16;            /**< Profondeur de couleur : 16 ou 1. */
+    bool _created = false;        /**< Vrai lorsque le tampon est alloué. */
+    std::vector<uint8_t> _buffer; /**< Les pixels, au format TFT_eSPI. */
+};
+
+#endif // UICOMBOBOX_MOCK_TFT_ESPI_H
@@ -0,0 +1,49 @@
+#include "U8g2_for_TFT_eSPI.h"
+
+uint32_t U8g2_for_TFT_eSPI::nextCodepoint(const char*& text) {
+    uint8_t lead = (uint8_t)*text++;
+    int extra = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+    uint32_t codepoint = extra ? (lead & (0x3F >> extra)) : lead;
+    for (int i = 0; i < extra; i++) {
+        // Une séquence tronquée est décodée comme un caractère de remplacement, comme U8g2.
+        if (((uint8_t)*text & 0xC0) != 0x80) return 0xFFFD;
+        codepoint = (codepoint << 6) | ((uint8_t)*text++ & 0x3F);
+    }
+    return codepoint;
+}
+
+void U8g2_for_TFT_eSPI::drawGlyph(uint32_t codepoint) {
+    const int height = FONT_ASCENT - FONT_DESCENT;
+    int top = _cursorY - FONT_ASCENT;
+    if (!_transparent) _tft->fillRect(_cursorX, top, GLYPH_ADVANCE, height, _background);
+    if (codepoint != ' ') {
+        uint64_t bits = (codepoint + 1) * 0x9E3779B97F4A7C15ull;
+        bits ^= bits >> 29;
+        for (int row = 0; row < height - 1; row++) {
+            int column = 0;
+            while (column < GLYPH_ADVANCE - 1) {
+                if (!((bits >> ((row * 5 + column) % 64)) & 1)) { column++; continue; }
+                int start = column;
+                while (column < GLYPH_ADVANCE - 1 && ((bits >> ((row * 5 + column) % 64)) & 1)) column++;
+                _tft->drawFastHLine(_cursorX + start, top + row, column - start, _foreground);
+            }
+        }
+    }
+    _cursorX += GLYPH_ADVANCE;
+}
+
+size_t U8g2_for_TFT_eSPI::print(const char* text) {
+    if (recordPrints) printed.emplace_back(text);
+    size_t length = strlen(text);
+    while (*text && _tft) drawGlyph(nextCodepoint(text));
+    return length;
+}
+
+int16_t U8g2_for_TFT_eSPI::getUTF8Width(const char* text) const {
+    int16_t width = 0;
+    while (*text) {
+        nextCodepoint(text);
+        width += GLYPH_ADVANCE;
+    }
+    return width;
+}
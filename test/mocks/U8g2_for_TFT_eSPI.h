@@ -0,0 +1,61 @@
+/**
+ * @file U8g2_for_TFT_eSPI.h
+ * @brief Substitut déterministe de U8g2_for_TFT_eSPI pour la compilation sur PC.
+ *
+ * Toutes les polices ont les mêmes métriques : 6 pixels d'avance par caractère UTF-8,
+ * 10 pixels au-dessus de la ligne de base et 3 en dessous. Chaque glyphe est un motif
+ * de 5 x 12 pixels dérivé de son point de code, tracé par segments horizontaux comme
+ * le fait la bibliothèque d'origine : deux textes différents produisent des pixels différents.
+ */
+
+#ifndef UICOMBOBOX_MOCK_U8G2_FOR_TFT_ESPI_H
+#define UICOMBOBOX_MOCK_U8G2_FOR_TFT_ESPI_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <string>
+#include <vector>
+
+class U8g2_for_TFT_eSPI {
+public:
+    static const int GLYPH_ADVANCE = 6; /**< Avance horizontale de chaque caractère, en pixels. */
+    static const int FONT_ASCENT = 10;  /**< Hauteur au-dessus de la ligne de base. */
+    static const int FONT_DESCENT = -3; /**< Profondeur sous la ligne de base (négative). */
+
+    void begin(TFT_eSPI& tft) { _tft = &tft; }
+    void setFont(const uint8_t* font) { _font = font; }
+    void setFontMode(uint8_t mode) { _transparent = mode != 0; }
+    void setForegroundColor(uint16_t color) { _foreground = color; }
+    void setBackgroundColor(uint16_t color) { _background = color; }
+    int8_t getFontAscent() const { return FONT_ASCENT; }
+    int8_t getFontDescent() const { return FONT_DESCENT; }
+    void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+    int16_t getCursorX() const { return _cursorX; }
+    int16_t getCursorY() const { return _cursorY; }
+
+    size_t print(const char* text);
+    size_t print(const String& text) { return print(text.c_str()); }
+    int16_t getUTF8Width(const char* text) const;
+
+    // --- Instrumentation (propre au substitut) ---
+
+    bool recordPrints = false;        /**< Si vrai, chaque texte imprimé est ajouté à printed. */
+    std::vector<std::string> printed; /**< Les textes imprimés, octet pour octet. */
+
+private:
+    /**
+     * @brief Décode le caractère UTF-8 en tête de text et avance le pointeur.
+     */
+    static uint32_t nextCodepoint(const char*& text);
+    void drawGlyph(uint32_t codepoint);
+
+    TFT_eSPI* _tft = nullptr;
+    const uint8_t* _font = nullptr;
+    bool _transparent = false;
+    uint16_t _foreground = TFT_WHITE;
+    uint16_t _background = TFT_BLACK;
+    int16_t _cursorX = 0;
+    int16_t _cursorY = 0;
+};
+
+#endif // UICOMBOBOX_MOCK_U8G2_FOR_TFT_ESPI_H
@@ -0,0 +1,44 @@
+/**
+ * @file UIComponent.h
+ * @brief Substitut du composant de base de la bibliothèque UITextComponent.
+ */
+
+#ifndef UICOMBOBOX_MOCK_UICOMPONENT_H
+#define UICOMBOBOX_MOCK_UICOMPONENT_H
+
+#include <TFT_eSPI.h>
+#include <UITypes/UIRect.h>
+
+class UIComponent {
+public:
+    explicit UIComponent(const UIRect& rect) : rect(rect) {}
+    virtual ~UIComponent() = default;
+
+    /**
+     * @brief Dessine le composant s'il est marqué comme modifié, ou sans condition si force est vrai.
+     */
+    void draw(TFT_eSPI& tft, bool force = false) {
+        if (dirty || force) {
+            drawInternal(tft, force);
+            dirty = false;
+        }
+    }
+
+    virtual void handlePress(TFT_eSPI& tft, int x, int y) { (void)tft; (void)x; (void)y; }
+    virtual bool isExpanded() const { return false; }
+    virtual void collapse() {}
+
+    void setDirty(bool value) { dirty = value; }
+    bool isDirty() const { return dirty; }
+    void setEnabled(bool value) { enabled = value; dirty = true; }
+    const UIRect& getRect() const { return rect; }
+
+protected:
+    virtual void drawInternal(TFT_eSPI& tft, bool force) = 0;
+
+    UIRect rect;
+    bool enabled = true;
+    bool dirty = true;
+};
+
+#endif // UICOMBOBOX_MOCK_UICOMPONENT_H
@@ -0,0 +1,17 @@
+/**
+ * @file UILabelStyle.h
+ * @brief Substitut du style de libellé de la bibliothèque UILabel.
+ */
+
+#ifndef UICOMBOBOX_MOCK_UILABELSTYLE_H
+#define UICOMBOBOX_MOCK_UILABELSTYLE_H
+
+#include <TFT_eSPI.h>
+
+struct UILabelStyle {
+    const uint8_t* font = nullptr;
+    uint16_t textColor = TFT_WHITE;
+    uint16_t bgColor = TFT_BLACK;
+};
+
+#endif // UICOMBOBOX_MOCK_UILABELSTYLE_H
@@ -0,0 +1,26 @@
+/**
+ * @file UITextComponent.h
+ * @brief Substitut du composant texte de la bibliothèque UITextComponent.
+ */
+
+#ifndef UICOMBOBOX_MOCK_UITEXTCOMPONENT_H
+#define UICOMBOBOX_MOCK_UITEXTCOMPONENT_H
+
+#include <Arduino.h>
+#include <U8g2_for_TFT_eSPI.h>
+#include "UIComponent.h"
+
+class UITextComponent : public UIComponent {
+public:
+    UITextComponent(U8g2_for_TFT_eSPI& u8f, const UIRect& rect, const String& text)
+        : UIComponent(rect), _u8f(u8f), _text(text) {}
+
+    void setText(const String& text) { _text = text; dirty = true; }
+    const String& getText() const { return _text; }
+
+protected:
+    U8g2_for_TFT_eSPI& _u8f;
+    String _text;
+};
+
+#endif // UICOMBOBOX_MOCK_UITEXTCOMPONENT_H
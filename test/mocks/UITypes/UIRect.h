@@ -0,0 +1,16 @@
+/**
+ * @file UIRect.h
+ * @brief Substitut du rectangle de la bibliothèque UITypes.
+ */
+
+#ifndef UICOMBOBOX_MOCK_UIRECT_H
+#define UICOMBOBOX_MOCK_UIRECT_H
+
+struct UIRect {
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+#endif // UICOMBOBOX_MOCK_UIRECT_H
@@ -0,0 +1,150 @@
+/**
+ * @file test_async_stress.cpp
+ * @brief Essais de charge de la file SPSC et de l'état publié par UIComboBoxAsync.
+ *
+ * À exécuter aussi sous ThreadSanitizer (cible test_async_stress_tsan, ou -DUICOMBOBOX_SANITIZER=thread).
+ * La variable d'environnement UICOMBOBOX_STRESS_ITEMS fixe le nombre d'éléments transmis.
+ */
+
+#include "UIComboBoxTest.h"
+#include <UIComboBoxAsync.h>
+#include <UIComboBoxSpscQueue.h>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+uint64_t stressItems() {
+    const char* value = getenv("UICOMBOBOX_STRESS_ITEMS");
+    return value ? strtoull(value, nullptr, 10) : 4000000ull;
+}
+
+/**
+ * @struct Payload
+ * @brief Un élément de la file, plus grand qu'un mot pour qu'une copie partielle soit détectable.
+ */
+struct Payload {
+    uint64_t sequence;
+    uint64_t check;
+    uint32_t words[6];
+};
+
+uint64_t checkOf(uint64_t sequence) { return sequence * 0x9E3779B97F4A7C15ull ^ 0xA5A5A5A5A5A5A5A5ull; }
+
+/**
+ * @brief Transmet count éléments d'un fil producteur au fil courant et vérifie leur ordre et leur contenu.
+ */
+template <size_t Capacity>
+void transferInOrder(uint64_t count) {
+    static UIComboBoxSpscQueue<Payload, Capacity> queue;
+    std::thread producer([count] {
+        for (uint64_t sequence = 0; sequence < count; sequence++) {
+            Payload payload;
+            payload.sequence = sequence;
+            payload.check = checkOf(sequence);
+            for (uint32_t& word : payload.words) word = (uint32_t)sequence;
+            while (!queue.push(payload)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t errors = 0;
+    while (expected < count) {
+        Payload payload;
+        if (!queue.pop(payload)) {
+            std::this_thread::yield();
+            continue;
+        }
+        bool intact = payload.sequence == expected && payload.check == checkOf(expected);
+        for (uint32_t word : payload.words) intact = intact && word == (uint32_t)expected;
+        if (!intact) errors++;
+        expected++;
+    }
+    producer.join();
+    CHECK_EQ(errors, 0ull);
+    CHECK(queue.empty());
+    Payload extra;
+    CHECK(!queue.pop(extra));
+}
+
+} // namespace
+
+TEST_CASE(smallQueueWrapsAroundMillionsOfTimesInOrder) {
+    // 8 emplacements : les index font le tour de la file toutes les 8 transmissions.
+    transferInOrder<8>(stressItems());
+}
+
+TEST_CASE(largeQueueKeepsOrderUnderBursts) {
+    transferInOrder<1024>(stressItems());
+}
+
+TEST_CASE(publishedStateIsNeverTorn) {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    u8f.begin(tft);
+    UIComboBoxStyle style;
+    UIComboBox comboBox(u8f, UIRect{ 20, 40, 200, 30 }, "Choix", &style);
+    // La valeur de chaque élément se déduit de son index : un état mêlant deux publications se voit.
+    auto valueOf = [](int index) { return 3 * index + 1; };
+    for (int i = 0; i < 16; i++) comboBox.addItem(String(("Item " + std::to_string(i)).c_str()), valueOf(i));
+
+    UIComboBoxAsync async(comboBox);
+    std::atomic<bool> running{true};
+    // Le fil de rendu publie l'état sans pause, aussi souvent que possible.
+    std::thread renderer([&] {
+        while (running.load(std::memory_order_acquire)) async.renderFrame(tft);
+    });
+
+    // Chaque commande provoque un dessin : leur nombre est réduit par rapport aux éléments de la file.
+    uint64_t commands = std::max<uint64_t>(stressItems() / 400, 1000);
+    int itemCount = 16;
+    int lastCount = 0;
+    uint64_t torn = 0;
+    uint64_t reads = 0;
+    uint64_t changes = 0;
+    UIComboBoxAsync::State previous = async.getState();
+    uint32_t random = 12345;
+    for (uint64_t i = 0; i < commands; i++) {
+        random = random * 1103515245u + 12345u;
+        bool posted;
+        // File pleine : on laisse le fil de rendu la vider, puis on reposte la même commande.
+        do {
+            switch ((random >> 16) % 8) {
+                case 0:  posted = async.addItem("Ajout", valueOf(itemCount)); break;
+                case 1:  posted = (random & 1) ? async.expand() : async.collapse(); break;
+                default: posted = async.setSelectedIndex((int)((random >> 8) % itemCount)); break;
+            }
+            if (!posted) std::this_thread::yield();
+        } while (!posted);
+        if ((random >> 16) % 8 == 0) itemCount++;
+
+        for (int j = 0; j < 8; j++) {
+            UIComboBoxAsync::State state = async.getState();
+            reads++;
+            bool consistent = state.selectedIndex >= 0 ? state.selectedValue == valueOf(state.selectedIndex)
+                                                         && state.selectedIndex < state.itemCount
+                                                       : state.selectedValue == -1;
+            // Les éléments ne sont qu'ajoutés : le nombre publié ne peut pas diminuer.
+            consistent = consistent && state.itemCount >= lastCount && state.itemCount <= itemCount;
+            lastCount = state.itemCount;
+            if (!consistent) torn++;
+            if (state.selectedIndex != previous.selectedIndex || state.itemCount != previous.itemCount) changes++;
+            previous = state;
+        }
+    }
+
+    // Toutes les commandes postées sont appliquées avant l'arrêt du fil de rendu.
+    while (async.getState().itemCount != itemCount) std::this_thread::yield();
+    running.store(false, std::memory_order_release);
+    renderer.join();
+
+    CHECK_EQ(torn, 0ull);
+    CHECK(reads > 0);
+    CHECK(changes > 0); // Les lectures ont bien croisé des publications du fil de rendu.
+    UIComboBoxAsync::State state = async.getState();
+    CHECK_EQ(state.itemCount, comboBox.getItemCount());
+    CHECK_EQ(state.selectedIndex, comboBox.getSelectedIndex());
+    CHECK_EQ(state.selectedValue, comboBox.getSelectedValue());
+    CHECK_EQ(state.expanded, comboBox.isExpanded());
+}
@@ -0,0 +1,142 @@
+/**
+ * @file test_blit_scroll.cpp
+ * @brief Défilement par copie de pixels : le même écran qu'un redessin complet, quel que soit le déplacement.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 30;
+const int FRAME_MS = 16;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 8;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    unsigned long nowMs = 0;
+    int touchX = RECT.x + 40;
+    int touchY = 0;
+
+    Fixture() : comboBox(u8f, RECT, "Choix", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(comboBox, ITEM_COUNT);
+        comboBox.setKineticScrolling(false);
+        comboBox.setBlitScrolling(true);
+        comboBox.setSelectedIndex(2);
+        comboBox.expand();
+        comboBox.draw(tft, true);
+    }
+
+    UIRect listRect() const {
+        return UIRect{ RECT.x, RECT.y + RECT.h, RECT.w, style.maxVisibleItems * style.itemHeight };
+    }
+
+    /**
+     * @brief Pose le doigt au milieu de la liste et engage le glissement.
+     */
+    void beginDrag() {
+        touchY = RECT.y + RECT.h + 4 * style.itemHeight;
+        comboBox.handleTouch(tft, touchX, touchY, true);
+        touchY -= 20; // Dépasse le seuil de glissement
+        comboBox.handleTouch(tft, touchX, touchY, true);
+        comboBox.updateScroll(nowMs += FRAME_MS);
+        comboBox.draw(tft, false);
+    }
+
+    /**
+     * @brief Déplace le doigt de pixels vers le haut (négatif : vers le bas), puis dessine l'image suivante.
+     */
+    void moveBy(int pixels) {
+        touchY -= pixels;
+        comboBox.handleTouch(tft, touchX, touchY, true);
+        comboBox.updateScroll(nowMs += FRAME_MS);
+        tft.resetCounters();
+        comboBox.draw(tft, false);
+    }
+
+    /**
+     * @brief Retourne le nombre de pixels qui diffèrent d'un dessin forcé du même état sur un écran neuf.
+     */
+    size_t differencesFromFullDraw() {
+        TFT_eSPI reference;
+        u8f.begin(reference);
+        comboBox.draw(reference, true);
+        u8f.begin(tft);
+        return TFT_eSPI::countDifferences(tft, reference);
+    }
+};
+
+} // namespace
+
+TEST_CASE(blitDragMatchesFullRedrawInBothDirections) {
+    Fixture f;
+    f.beginDrag();
+    f.moveBy(3 * f.style.itemHeight); // Loin des deux bords de la plage de défilement
+
+    const int h = f.style.itemHeight;
+    for (int delta : { 1, 2, 3, 7, h - 1, h, h + 1, 2 * h, 2 * h + 5 }) {
+        for (int direction : { 1, -1 }) {
+            f.moveBy(direction * delta);
+            CHECK(f.tft.counters.readRect > 0); // Les lignes ont bien été copiées
+            CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { f.listRect() }));
+            CHECK_EQ(f.differencesFromFullDraw(), (size_t)0);
+        }
+    }
+}
+
+TEST_CASE(rowsInvalidatedDuringABlitMatchFullRedraw) {
+    Fixture f;
+    f.beginDrag();
+    f.moveBy(3 * f.style.itemHeight);
+
+    // Une ligne change pendant un défilement d'une ligne entière, puis d'une fraction de ligne.
+    for (int delta : { f.style.itemHeight, -f.style.itemHeight, 5, -9 }) {
+        f.comboBox.updateItem(6, delta > 0 ? "modifié" : "Item 6", 6);
+        f.moveBy(delta);
+        CHECK_EQ(f.differencesFromFullDraw(), (size_t)0);
+    }
+}
+
+TEST_CASE(largeJumpRepaintsInsteadOfCopying) {
+    Fixture f;
+    f.beginDrag();
+
+    // Au-delà de la hauteur de la liste, aucune ligne à l'écran n'est réutilisable.
+    f.moveBy(f.style.maxVisibleItems * f.style.itemHeight + 4);
+    CHECK_EQ(f.tft.counters.readRect, (uint32_t)0);
+    CHECK_EQ(f.differencesFromFullDraw(), (size_t)0);
+}
+
+TEST_CASE(scrollBarAndSelectionScrollsMatchFullRedraw) {
+    Fixture f;
+    const UIRect list = f.listRect();
+
+    // Appui sur la barre de défilement, en bas puis en haut de la piste.
+    for (int y : { list.y + list.h - 4, list.y + 4 }) {
+        f.comboBox.handlePress(f.tft, list.x + list.w - 2, y);
+        f.tft.resetCounters();
+        f.comboBox.draw(f.tft, false);
+        CHECK(f.tft.touchedCount() > 0);
+        CHECK_EQ(f.differencesFromFullDraw(), (size_t)0);
+    }
+
+    // La sélection d'un élément caché fait défiler la liste d'une ou de plusieurs lignes.
+    uint32_t copies = 0;
+    for (int index : { 8, 10, 3, 1 }) {
+        f.comboBox.setSelectedIndex(index);
+        f.tft.resetCounters();
+        f.comboBox.draw(f.tft, false);
+        copies += f.tft.counters.readRect;
+        CHECK_EQ(f.differencesFromFullDraw(), (size_t)0);
+    }
+    CHECK(copies > 0);
+}
@@ -0,0 +1,311 @@
+/**
+ * @file test_catalog.cpp
+ * @brief Catalogue binaire : fichiers produits par tools/build_catalog.py, lecture à travers les blocs,
+ *        éviction du cache et rejet des fichiers corrompus ou tronqués.
+ */
+
+#include "UIComboBoxTest.h"
+#include <UIComboBoxCatalogProvider.h>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+namespace {
+
+const size_t HEADER_SIZE = 20;
+
+struct Item {
+    std::string text;
+    int value;
+};
+
+/**
+ * @brief Éléments de test : textes de longueurs variées, UTF-8 compris, valeurs négatives et grandes.
+ */
+std::vector<Item> makeItems(size_t count) {
+    std::vector<Item> items;
+    for (size_t i = 0; i < count; i++) {
+        std::string text = "Élément " + std::to_string(i);
+        // Quelques textes longs, jusqu'à la limite de 255 octets du format.
+        if (i % 37 == 0) text += std::string(200 + i % 55 - text.size() % 10, 'x');
+        int value = (int)(i * 2654435761u);
+        items.push_back({ text, value });
+    }
+    return items;
+}
+
+std::string outputPath(const std::string& name) {
+    return std::string(UICOMBOBOX_TEST_OUTPUT_DIR) + "/" + name;
+}
+
+/**
+ * @brief Écrit les éléments dans un CSV et le convertit avec tools/build_catalog.py.
+ * @return Le chemin du catalogue produit.
+ */
+std::string buildCatalog(const std::string& name, const std::vector<Item>& items, int itemsPerBlock) {
+    std::string csvPath = outputPath(name + ".csv");
+    std::string catalogPath = outputPath(name + ".uicb");
+    {
+        std::ofstream csv(csvPath, std::ios::binary);
+        for (const Item& item : items) csv << item.text << ',' << item.value << '\n';
+    }
+    std::string command = std::string("\"") + UICOMBOBOX_PYTHON + "\" \"" + UICOMBOBOX_BUILD_CATALOG + "\" \""
+                        + csvPath + "\" \"" + catalogPath + "\" --items-per-block " + std::to_string(itemsPerBlock)
+                        + " > /dev/null";
+    CHECK_EQ(std::system(command.c_str()), 0);
+    return catalogPath;
+}
+
+std::vector<uint8_t> readBytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::string writeBytes(const std::string& name, const std::vector<uint8_t>& bytes) {
+    std::string path = outputPath(name);
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    return path;
+}
+
+uint32_t readU32(const std::vector<uint8_t>& bytes, size_t position) {
+    return (uint32_t)bytes[position] | ((uint32_t)bytes[position + 1] << 8)
+         | ((uint32_t)bytes[position + 2] << 16) | ((uint32_t)bytes[position + 3] << 24);
+}
+
+void writeU32(std::vector<uint8_t>& bytes, size_t position, uint32_t value) {
+    for (int i = 0; i < 4; i++) bytes[position + i] = (uint8_t)(value >> (8 * i));
+}
+
+/**
+ * @brief Vérifie le texte, la longueur et la valeur d'un élément ; retourne false au premier écart.
+ */
+bool matches(const UIComboBoxCatalogProvider& provider, size_t index, const Item& item) {
+    char text[256];
+    size_t length = provider.getItemText(index, text, sizeof(text));
+    return length == item.text.size() && item.text == text
+        && provider.getItemTextLength(index) == item.text.size()
+        && provider.getItemValue(index) == item.value;
+}
+
+/**
+ * @brief Indique si un catalogue modifié est rejeté à l'ouverture.
+ */
+bool rejected(const std::string& name, const std::vector<uint8_t>& bytes) {
+    fs::FS fileSystem;
+    UIComboBoxCatalogProvider provider(2);
+    bool opened = provider.open(fileSystem.open(writeBytes(name, bytes).c_str()));
+    return !opened && !provider.isOpen() && provider.getItemCount() == 0;
+}
+
+} // namespace
+
+TEST_CASE(readsEveryItemAcrossBlockBoundaries) {
+    const int ITEMS_PER_BLOCK = 7; // 1000 n'en est pas un multiple : le dernier bloc est incomplet.
+    std::vector<Item> items = makeItems(1000);
+    std::string path = buildCatalog("boundaries", items, ITEMS_PER_BLOCK);
+    const uint32_t blocks = (uint32_t)((items.size() + ITEMS_PER_BLOCK - 1) / ITEMS_PER_BLOCK);
+
+    fs::FS fileSystem;
+    UIComboBoxCatalogProvider provider(2);
+    CHECK(provider.open(fileSystem.open(path.c_str())));
+    CHECK_EQ(provider.getItemCount(), items.size());
+
+    // Ordre croissant : chaque bloc n'est lu qu'une fois, les trois accès suivants sont servis par le cache.
+    size_t mismatches = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (!matches(provider, i, items[i])) mismatches++;
+    }
+    CHECK_EQ(mismatches, (size_t)0);
+    CHECK_EQ(provider.getStats().misses, blocks);
+    CHECK_EQ(provider.getStats().hits, (uint32_t)(3 * items.size()) - blocks);
+
+    // Ordre décroissant, puis aléatoire : même contenu, sans erreur de lecture.
+    // Les deux derniers blocs, encore en cache, ne sont pas relus.
+    provider.resetStats();
+    for (size_t i = items.size(); i-- > 0;) {
+        if (!matches(provider, i, items[i])) mismatches++;
+    }
+    CHECK_EQ(provider.getStats().misses, blocks - 2);
+    std::mt19937 random(7);
+    for (int n = 0; n < 5000; n++) {
+        size_t i = random() % items.size();
+        if (!matches(provider, i, items[i])) mismatches++;
+    }
+    CHECK_EQ(mismatches, (size_t)0);
+    CHECK_EQ(provider.getStats().readErrors, (uint32_t)0);
+
+    // Hors limites : texte vide et valeur nulle.
+    char text[8] = "?";
+    CHECK_EQ(provider.getItemText(items.size(), text, sizeof(text)), (size_t)0);
+    CHECK_EQ(text[0], '\0');
+    CHECK_EQ(provider.getItemValue(items.size()), 0);
+}
+
+TEST_CASE(leastRecentlyUsedBlockIsEvicted) {
+    const int ITEMS_PER_BLOCK = 10;
+    std::vector<Item> items = makeItems(100);
+    std::string path = buildCatalog("eviction", items, ITEMS_PER_BLOCK);
+
+    fs::FS fileSystem;
+    UIComboBoxCatalogProvider provider(2);
+    CHECK(provider.open(fileSystem.open(path.c_str())));
+
+    // Deux blocs en alternance tiennent dans le cache : une lecture chacun.
+    for (int n = 0; n < 20; n++) {
+        size_t index = (n % 2) * ITEMS_PER_BLOCK + n % ITEMS_PER_BLOCK;
+        CHECK(matches(provider, index, items[index]));
+    }
+    CHECK_EQ(provider.getStats().misses, (uint32_t)2);
+
+    // Trois blocs en rotation dans deux emplacements : le bloc demandé vient toujours d'être évincé.
+    provider.resetStats();
+    for (int n = 0; n < 30; n++) {
+        size_t index = (2 + n % 3) * ITEMS_PER_BLOCK + n % ITEMS_PER_BLOCK;
+        provider.getItemValue(index);
+    }
+    CHECK_EQ(provider.getStats().misses, (uint32_t)30);
+    CHECK_EQ(provider.getStats().hits, (uint32_t)0);
+
+    // Le bloc utilisé le plus récemment reste en cache, l'autre est évincé.
+    provider.resetStats();
+    provider.getItemValue(0);  // bloc 0 remplace le moins récent (bloc 3)
+    provider.getItemValue(40); // bloc 4, encore en cache
+    provider.getItemValue(30); // bloc 3, évincé
+    CHECK_EQ(provider.getStats().misses, (uint32_t)2);
+    CHECK_EQ(provider.getStats().hits, (uint32_t)1);
+
+    // Un cache d'un seul bloc reste correct, au prix d'une lecture par changement de bloc.
+    UIComboBoxCatalogProvider single(1);
+    CHECK(single.open(fileSystem.open(path.c_str())));
+    for (size_t i = 0; i < items.size(); i += 9) {
+        CHECK(matches(single, i, items[i]));
+        CHECK(matches(single, items.size() - 1 - i, items[items.size() - 1 - i]));
+    }
+    CHECK_EQ(single.getStats().readErrors, (uint32_t)0);
+}
+
+TEST_CASE(catalogFeedsComboBox) {
+    std::vector<Item> items = makeItems(300);
+    std::string path = buildCatalog("combo", items, 16);
+
+    fs::FS fileSystem;
+    UIComboBoxCatalogProvider provider(3);
+    CHECK(provider.open(fileSystem.open(path.c_str())));
+
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    u8f.begin(tft);
+    UIComboBoxStyle style;
+    UIComboBox comboBox(u8f, UIRect{ 20, 40, 200, 30 }, "Catalogue", &style);
+    comboBox.setItemProvider(&provider);
+    CHECK_EQ((size_t)comboBox.getItemCount(), items.size());
+
+    // Un texte long est rendu entier, sur plusieurs blocs de distance du précédent.
+    for (size_t index : { (size_t)0, (size_t)37, (size_t)296, (size_t)150 }) {
+        comboBox.setSelectedIndex((int)index);
+        CHECK(std::string(comboBox.getSelectedText().c_str()) == items[index].text);
+        CHECK_EQ(comboBox.getSelectedValue(), items[index].value);
+    }
+    comboBox.expand();
+    comboBox.draw(tft, true);
+    CHECK_EQ(provider.getStats().readErrors, (uint32_t)0);
+}
+
+TEST_CASE(corruptedHeadersAndIndexesAreRejected) {
+    std::vector<Item> items = makeItems(50);
+    std::vector<uint8_t> valid = readBytes(buildCatalog("corrupt", items, 8));
+    const uint32_t blocks = readU32(valid, 12);
+    const uint32_t indexOffset = readU32(valid, 16);
+    CHECK(!rejected("corrupt_valid.uicb", valid));
+
+    std::vector<uint8_t> bytes = valid;
+    bytes[0] = 'X';
+    CHECK(rejected("corrupt_magic.uicb", bytes));
+
+    bytes = valid;
+    bytes[4] = 2;
+    CHECK(rejected("corrupt_version.uicb", bytes));
+
+    bytes = valid;
+    bytes[6] = 0;
+    bytes[7] = 0;
+    CHECK(rejected("corrupt_zero_per_block.uicb", bytes));
+
+    bytes = valid;
+    bytes[6] = 9; // Ne correspond plus au nombre de blocs
+    CHECK(rejected("corrupt_per_block.uicb", bytes));
+
+    bytes = valid;
+    writeU32(bytes, 12, blocks + 1);
+    CHECK(rejected("corrupt_block_count.uicb", bytes));
+
+    // Nombres cohérents entre eux mais sans rapport avec le fichier, y compris aux limites des entiers 32 bits.
+    bytes = valid;
+    writeU32(bytes, 8, 0xFFFFFFFF);
+    bytes[6] = 2;
+    bytes[7] = 0;
+    writeU32(bytes, 12, 0x80000000);
+    CHECK(rejected("corrupt_huge_count.uicb", bytes));
+
+    bytes = valid;
+    writeU32(bytes, 8, 0xFFFFFFFF);
+    bytes[6] = 1;
+    bytes[7] = 0;
+    writeU32(bytes, 12, 0xFFFFFFFF);
+    CHECK(rejected("corrupt_max_blocks.uicb", bytes));
+
+    bytes = valid;
+    writeU32(bytes, 16, (uint32_t)valid.size() + 100);
+    CHECK(rejected("corrupt_index_past_end.uicb", bytes));
+
+    bytes = valid;
+    writeU32(bytes, 16, (uint32_t)valid.size() - 4); // L'index déborde de la fin du fichier
+    CHECK(rejected("corrupt_index_overlaps_end.uicb", bytes));
+
+    bytes = valid;
+    uint32_t second = readU32(valid, indexOffset + 8);
+    writeU32(bytes, indexOffset + 4, second + 1); // Positions décroissantes
+    CHECK(rejected("corrupt_not_monotonic.uicb", bytes));
+
+    bytes = valid;
+    writeU32(bytes, indexOffset + 4 * blocks, (uint32_t)valid.size() + 1); // Fin du dernier bloc hors du fichier
+    CHECK(rejected("corrupt_offset_past_end.uicb", bytes));
+
+    // Fichiers tronqués : en-tête incomplet, index incomplet, dernier bloc incomplet.
+    for (size_t size : { (size_t)0, HEADER_SIZE - 1, (size_t)indexOffset + 6, valid.size() - 1 }) {
+        bytes.assign(valid.begin(), valid.begin() + size);
+        CHECK(rejected("corrupt_truncated.uicb", bytes));
+    }
+}
+
+TEST_CASE(corruptedRecordsReportReadErrors) {
+    const int ITEMS_PER_BLOCK = 8;
+    std::vector<Item> items = makeItems(40);
+    std::vector<uint8_t> bytes = readBytes(buildCatalog("records", items, ITEMS_PER_BLOCK));
+    const uint32_t indexOffset = readU32(bytes, 16);
+
+    // Longueur du premier texte du bloc 1 portée au maximum : les éléments débordent du bloc.
+    uint32_t block1 = readU32(bytes, indexOffset + 4);
+    bytes[block1 + 4] = 255;
+    std::string path = writeBytes("records_corrupt.uicb", bytes);
+
+    fs::FS fileSystem;
+    UIComboBoxCatalogProvider provider(2);
+    CHECK(provider.open(fileSystem.open(path.c_str())));
+
+    // Les blocs intacts restent lisibles ; le bloc incohérent donne des éléments vides et une erreur.
+    CHECK(matches(provider, 0, items[0]));
+    CHECK(matches(provider, 2 * ITEMS_PER_BLOCK, items[2 * ITEMS_PER_BLOCK]));
+    char text[256] = "?";
+    CHECK_EQ(provider.getItemText(ITEMS_PER_BLOCK, text, sizeof(text)), (size_t)0);
+    CHECK_EQ(text[0], '\0');
+    CHECK_EQ(provider.getItemValue(ITEMS_PER_BLOCK + 1), 0);
+    CHECK_EQ(provider.getItemTextLength(ITEMS_PER_BLOCK + 2), (size_t)0);
+    CHECK(provider.getStats().readErrors >= 3);
+
+    // Fermé, le fournisseur est vide.
+    provider.close();
+    CHECK(!provider.isOpen());
+    CHECK_EQ(provider.getItemCount(), (size_t)0);
+}
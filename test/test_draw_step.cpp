@@ -0,0 +1,152 @@
+/**
+ * @file test_draw_step.cpp
+ * @brief Dessin incrémental : budget épuisé en cours d'image, modifications fusionnées entre deux étapes.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 20;
+const int FRAME_MS = 16;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 6;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    unsigned long nowMs = 0;
+
+    Fixture() : comboBox(u8f, RECT, "Choix", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(comboBox, ITEM_COUNT);
+        comboBox.setKineticScrolling(false);
+    }
+
+    /**
+     * @brief Dessine par étapes d'une unité (budget nul) jusqu'à ce que l'affichage soit à jour.
+     * @return Le nombre d'appels à drawStep().
+     */
+    int drawAllSteps() {
+        int steps = 0;
+        while (comboBox.drawStep(tft, 0)) {
+            CHECK(comboBox.hasPendingDraw());
+            if (++steps > 1000) break;
+        }
+        CHECK(!comboBox.hasPendingDraw());
+        return steps + 1;
+    }
+
+    /**
+     * @brief Fait glisser la liste de pixels vers le haut, appliqué à la prochaine image.
+     */
+    void drag(int pixels) {
+        int x = RECT.x + 40;
+        int y = RECT.y + RECT.h + 3 * style.itemHeight;
+        comboBox.handleTouch(tft, x, y, true);
+        comboBox.handleTouch(tft, x, y - 20, true); // Dépasse le seuil de glissement
+        comboBox.updateScroll(nowMs += FRAME_MS);
+        comboBox.handleTouch(tft, x, y - 20 - pixels, true);
+        comboBox.updateScroll(nowMs += FRAME_MS);
+        comboBox.handleTouch(tft, x, y - 20 - pixels, false);
+    }
+
+    UIRect collapsedPaintRect() const {
+        UIRect paint = comboBox.getPaintRect();
+        return UIRect{ paint.x, paint.y, paint.w, RECT.y + RECT.h - paint.y };
+    }
+};
+
+/**
+ * @brief Retourne le nombre de pixels qui diffèrent d'un dessin forcé du même état sur un écran neuf.
+ */
+size_t differencesFromFullDraw(Fixture& f) {
+    TFT_eSPI reference;
+    f.u8f.begin(reference);
+    f.comboBox.draw(reference, true);
+    f.u8f.begin(f.tft);
+    return TFT_eSPI::countDifferences(f.tft, reference);
+}
+
+} // namespace
+
+TEST_CASE(budgetExhaustedMidFrameResumesOnNextStep) {
+    Fixture f;
+    f.comboBox.expand();
+
+    // Budget nul : une unité par appel, la boîte fermée d'abord.
+    CHECK(f.comboBox.drawStep(f.tft, 0));
+    CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { f.collapsedPaintRect() }));
+    CHECK(f.comboBox.needsRedraw());
+
+    // Boîte fermée, fond de la liste, barre de défilement, puis une unité par ligne visible.
+    int steps = 1 + f.drawAllSteps();
+    CHECK_EQ(steps, 3 + f.style.maxVisibleItems);
+    CHECK_EQ(differencesFromFullDraw(f), (size_t)0);
+
+    // Un budget large termine tout en un appel ; draw() termine le travail laissé par drawStep().
+    f.comboBox.setSelectedIndex(3);
+    CHECK(!f.comboBox.drawStep(f.tft, 1000000));
+    f.comboBox.setEnabled(false);
+    CHECK(f.comboBox.drawStep(f.tft, 0));
+    f.comboBox.draw(f.tft, false);
+    CHECK(!f.comboBox.hasPendingDraw());
+    CHECK_EQ(differencesFromFullDraw(f), (size_t)0);
+}
+
+TEST_CASE(scrollBetweenStepsRestartsRowsFromTheTop) {
+    Fixture f;
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, true);
+
+    // Une ligne en attente décrit l'ancienne position : le défilement la remplace par toutes les lignes.
+    f.comboBox.setSelectedIndex(2);
+    CHECK(f.comboBox.drawStep(f.tft, 0));
+    f.drag(f.style.itemHeight + 5);
+    f.drawAllSteps();
+    CHECK_EQ(differencesFromFullDraw(f), (size_t)0);
+
+    // Deux défilements successifs pendant un redessin par étapes.
+    f.drag(7);
+    CHECK(f.comboBox.drawStep(f.tft, 0));
+    f.drag(11);
+    f.drawAllSteps();
+    CHECK_EQ(differencesFromFullDraw(f), (size_t)0);
+}
+
+TEST_CASE(collapseBetweenStepsDropsListUnits) {
+    Fixture f;
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, true);
+
+    f.comboBox.setSelectedIndex(4);
+    CHECK(f.comboBox.drawStep(f.tft, 0)); // Texte de la boîte fermée ; les deux lignes restent en attente
+    f.comboBox.collapse();
+
+    // Les lignes de la liste repliée ne sont pas dessinées.
+    f.tft.resetCounters();
+    f.drawAllSteps();
+    CHECK(f.tft.touchedCount() > 0);
+    CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { f.collapsedPaintRect() }));
+    CHECK(!f.comboBox.needsRedraw());
+}
+
+TEST_CASE(baseClassInvalidationIsDrawnByDrawStep) {
+    Fixture f;
+    f.comboBox.draw(f.tft, true);
+
+    // setEnabled() ne lève que le drapeau de la classe de base : dessin complet, comme avec draw().
+    f.comboBox.setEnabled(false);
+    f.tft.resetCounters();
+    f.drawAllSteps();
+    CHECK(f.tft.touchedCount() > 0);
+    CHECK_EQ(differencesFromFullDraw(f), (size_t)0);
+    CHECK(!f.comboBox.needsRedraw());
+}
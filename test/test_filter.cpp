@@ -0,0 +1,155 @@
+/**
+ * @file test_filter.cpp
+ * @brief Filtrage par préfixe : casse ignorée, saisie puis effacement, modifications de la liste pendant le filtrage.
+ */
+
+#include "UIComboBoxTest.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 8;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+
+    Fixture() : comboBox(u8f, RECT, "", &style) {
+        u8f.begin(tft);
+        comboBox.setFilterEnabled(true);
+    }
+
+    /**
+     * @brief Retourne les textes des lignes affichées par un dessin complet de la liste dépliée, dans l'ordre.
+     */
+    std::vector<std::string> visibleTexts() {
+        comboBox.expand();
+        comboBox.draw(tft, false);
+        u8f.printed.clear();
+        u8f.recordPrints = true;
+        comboBox.draw(tft, true);
+        u8f.recordPrints = false;
+        // La boîte fermée affiche la saisie suivie du curseur, ou le texte sélectionné.
+        size_t header = comboBox.getFilterText().length() > 0 ? 2 : 1;
+        return std::vector<std::string>(u8f.printed.begin() + header, u8f.printed.end());
+    }
+};
+
+std::string folded(const std::string& text) {
+    std::string result = text;
+    for (char& c : result) c = (char)tolower((unsigned char)c);
+    return result;
+}
+
+/**
+ * @brief Les textes commençant par le préfixe, sans tenir compte de la casse, dans l'ordre du filtre.
+ */
+std::vector<std::string> expectedView(const std::vector<std::string>& items, const std::string& prefix) {
+    std::vector<size_t> matches;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (folded(items[i]).compare(0, prefix.size(), folded(prefix)) == 0) matches.push_back(i);
+    }
+    std::stable_sort(matches.begin(), matches.end(),
+                     [&](size_t a, size_t b) { return folded(items[a]) < folded(items[b]); });
+    std::vector<std::string> view;
+    for (size_t i : matches) view.push_back(items[i]);
+    return view;
+}
+
+} // namespace
+
+TEST_CASE(prefixMatchingIgnoresAsciiCase) {
+    Fixture f;
+    const char* texts[] = { "alpha", "Bravo", "ALPINE", "alps", "Beta", "Alpaca", "al" };
+    for (int i = 0; i < 7; i++) f.comboBox.addItem(texts[i], i);
+
+    f.comboBox.setFilterText("AL");
+    CHECK_EQ(f.comboBox.getFilteredCount(), 5);
+    CHECK(f.visibleTexts() == (std::vector<std::string>{ "al", "Alpaca", "alpha", "ALPINE", "alps" }));
+
+    f.comboBox.setFilterText("aLpI");
+    CHECK(f.visibleTexts() == (std::vector<std::string>{ "ALPINE" }));
+    f.comboBox.setFilterText("b");
+    CHECK(f.visibleTexts() == (std::vector<std::string>{ "Beta", "Bravo" }));
+    f.comboBox.setFilterText("x");
+    CHECK_EQ(f.comboBox.getFilteredCount(), 0);
+}
+
+TEST_CASE(typingThenDeletingWidensTheViewAgain) {
+    Fixture f;
+    std::vector<std::string> items = { "Salon", "salle de bain", "Sal", "Cuisine", "SALLE à manger", "sas", "Garage" };
+    for (size_t i = 0; i < items.size(); i++) f.comboBox.addItem(items[i].c_str(), (int)i);
+    f.comboBox.expand();
+
+    // Chaque frappe restreint la plage courante ; chaque effacement repart de la liste complète.
+    const std::string typed = "sAlLe";
+    for (size_t length = 1; length <= typed.size(); length++) {
+        f.comboBox.appendFilterChar(typed[length - 1]);
+        CHECK(f.visibleTexts() == expectedView(items, typed.substr(0, length)));
+    }
+    for (size_t length = typed.size() - 1; length > 0; length--) {
+        f.comboBox.removeFilterChar();
+        CHECK(f.visibleTexts() == expectedView(items, typed.substr(0, length)));
+    }
+    f.comboBox.removeFilterChar();
+    CHECK(f.comboBox.getFilterText() == "");
+    CHECK_EQ(f.comboBox.getFilteredCount(), (int)items.size());
+}
+
+TEST_CASE(listChangesWhileFilteringKeepTheIndexConsistent) {
+    Fixture f;
+    const int count = 10000;
+    std::vector<std::string> items;
+    for (int i = 0; i < count; i++) {
+        // Textes dans le désordre et de casses mêlées.
+        int key = (i * 7919) % count;
+        items.push_back(std::string(key % 3 == 0 ? "Item " : "item ") + std::to_string(key));
+    }
+    f.comboBox.reserveItems(count, count * 12);
+    for (int i = 0; i < count; i++) f.comboBox.addItem(items[i].c_str(), i);
+    f.comboBox.expand();
+    f.comboBox.setFilterText("ITEM 12");
+
+    // Insertions, suppressions et mises à jour, dans la vue filtrée et en dehors.
+    for (int step = 0; step < 50; step++) {
+        int index = (step * 613) % (int)items.size();
+        switch (step % 3) {
+        case 0: {
+            std::string text = "item 12" + std::to_string(step);
+            f.comboBox.insertItem(index, text.c_str(), -step);
+            items.insert(items.begin() + index, text);
+            break;
+        }
+        case 1:
+            f.comboBox.removeItem(index);
+            items.erase(items.begin() + index);
+            break;
+        default: {
+            std::string text = (step % 2 ? "ITEM 1" : "autre ") + std::to_string(step);
+            f.comboBox.updateItem(index, text.c_str(), step);
+            items[index] = text;
+            break;
+        }
+        }
+        std::vector<std::string> expected = expectedView(items, "item 12");
+        CHECK_EQ(f.comboBox.getFilteredCount(), (int)expected.size());
+    }
+
+    // Les premières lignes sont celles d'un index reconstruit à partir de zéro.
+    std::vector<std::string> expected = expectedView(items, "item 12");
+    expected.resize(f.style.maxVisibleItems);
+    CHECK(f.visibleTexts() == expected);
+    f.comboBox.setFilterText("item 1");
+    expected = expectedView(items, "item 1");
+    expected.resize(f.style.maxVisibleItems);
+    CHECK(f.visibleTexts() == expected);
+}
@@ -0,0 +1,243 @@
+/**
+ * @file test_group_flush.cpp
+ * @brief Dessin groupé : dommage limité aux zones repeintes, pas de double dessin, grille tenue à jour.
+ */
+
+#include "UIComboBoxTest.h"
+#include <UIComboBoxGroup.h>
+
+namespace {
+
+const UIRect BOTTOM_RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 10;
+
+/**
+ * @brief Écran qui compte les écritures d'un pixel donné, écritures répétées comprises.
+ */
+struct ProbeTFT : TFT_eSPI {
+    int probeX = -1;
+    int probeY = -1;
+    int probeWrites = 0;
+
+protected:
+    void storePixel(int32_t x, int32_t y, uint16_t color) override {
+        if (x == probeX && y == probeY) probeWrites++;
+        TFT_eSPI::storePixel(x, y, color);
+    }
+};
+
+/**
+ * @brief Composant déplaçable, pour simuler un changement de disposition du formulaire.
+ */
+struct MovableComboBox : UIComboBox {
+    using UIComboBox::UIComboBox;
+
+    void moveTo(int x, int y) {
+        rect.x = x;
+        rect.y = y;
+        setDirty(true);
+    }
+};
+
+/**
+ * @brief Deux composants empilés : bottom en dessous, top au-dessus, au rectangle donné et sans étiquette.
+ */
+struct Fixture {
+    ProbeTFT tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style;
+    UIComboBox bottom;
+    UIComboBox top;
+    UIComboBoxGroup group;
+
+    explicit Fixture(const UIRect& topRect)
+        : bottom(u8f, BOTTOM_RECT, "Bas", &style), top(u8f, topRect, "", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(bottom, ITEM_COUNT);
+        uicombobox_test::addNumberedItems(top, ITEM_COUNT);
+        group.add(bottom);
+        group.add(top);
+        group.flush(tft);
+    }
+
+    UIRect textInterior(const UIComboBox& comboBox) const {
+        const UIRect& rect = comboBox.getRect();
+        return UIRect{ rect.x + 1, rect.y + 1, rect.w - rect.h - 1, rect.h - 2 };
+    }
+};
+
+/**
+ * @brief Retourne vrai si l'écran est identique à un rendu complet des deux composants dans le même état.
+ */
+bool matchesFullRender(const Fixture& f, int bottomSelection, int topSelection) {
+    Fixture reference(f.top.getRect());
+    reference.bottom.setSelectedIndex(bottomSelection);
+    reference.top.setSelectedIndex(topSelection);
+    reference.bottom.draw(reference.tft, true);
+    reference.top.draw(reference.tft, true);
+    return TFT_eSPI::countDifferences(f.tft, reference.tft) == 0;
+}
+
+} // namespace
+
+TEST_CASE(redrawnMemberIsNotRepairedOverItsOwnRepaint) {
+    // Les zones de texte des deux composants se recouvrent.
+    Fixture f(UIRect{ 100, 50, 150, 30 });
+    f.bottom.setSelectedIndex(1);
+    f.top.setSelectedIndex(2);
+
+    // Pixel commun aux deux zones de texte, hors des caractères.
+    f.tft.probeX = 170;
+    f.tft.probeY = 60;
+    f.tft.probeWrites = 0;
+    f.group.flush(f.tft);
+
+    // Le fond du texte du composant du bas puis celui du composant du haut, sans réparation du second.
+    CHECK_EQ(f.tft.probeWrites, 2);
+    CHECK(matchesFullRender(f, 1, 2));
+}
+
+TEST_CASE(damageIsLimitedToTheRepaintedArea) {
+    // Le composant du haut recouvre le bouton du composant du bas, pas sa zone de texte.
+    Fixture f(UIRect{ 195, 50, 100, 30 });
+    f.tft.resetCounters();
+    f.bottom.setSelectedIndex(3);
+    f.group.flush(f.tft);
+
+    // Seul le texte du composant du bas change : le composant du haut n'est pas repeint.
+    CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { f.textInterior(f.bottom) }));
+    CHECK(matchesFullRender(f, 3, 0));
+}
+
+TEST_CASE(damageFromBelowIsStillRepairedOutsideTheRepaint) {
+    // Redessiné entièrement, le composant du bas recouvre la bordure du composant du haut,
+    // qui ne repeint lui-même que sa zone de texte : la bordure doit être réparée.
+    Fixture f(UIRect{ 100, 50, 150, 30 });
+    f.bottom.setEnabled(false);
+    f.top.setSelectedIndex(4);
+    f.group.flush(f.tft);
+
+    Fixture reference(f.top.getRect());
+    reference.bottom.setEnabled(false);
+    reference.top.setSelectedIndex(4);
+    reference.bottom.draw(reference.tft, true);
+    reference.top.draw(reference.tft, true);
+    CHECK_EQ(TFT_eSPI::countDifferences(f.tft, reference.tft), (size_t)0);
+}
+
+TEST_CASE(movedMemberIsFoundWithoutInvalidatingTheIndex) {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    u8f.begin(tft);
+    UIComboBoxStyle style;
+    MovableComboBox first(u8f, UIRect{ 20, 40, 100, 30 }, "", &style);
+    MovableComboBox second(u8f, UIRect{ 20, 150, 100, 30 }, "", &style);
+    UIComboBoxGroup group;
+    group.add(first);
+    group.add(second);
+
+    CHECK(group.hitTest(30, 50) == &first);
+    CHECK(group.hitTest(30, 160) == &second);
+
+    // Hors de la zone couverte par la grille construite ci-dessus.
+    second.moveTo(200, 300);
+    CHECK(group.hitTest(210, 310) == &second);
+    CHECK(group.hitTest(30, 160) == nullptr);
+
+    // Un déplacement à l'intérieur de l'ancien rectangle reste correct sans reconstruction.
+    first.moveTo(30, 40);
+    CHECK(group.hitTest(25, 50) == nullptr);
+    CHECK(group.hitTest(125, 50) == &first);
+}
+
+TEST_CASE(overflowingPendingAreaDamagesTheWholeMember) {
+    // Liste de 18 lignes visibles : une ligne sur deux modifiée donne plus de bandes que la région n'en garde.
+    UIComboBoxStyle style;
+    style.itemHeight = 20;
+    style.maxVisibleItems = 18;
+    const UIRect topRect = { 100, 330, 150, 30 }; // Recouvre les lignes 14 et 15 de la liste du bas
+    auto build = [&](TFT_eSPI& tft, U8g2_for_TFT_eSPI& u8f, UIComboBox& bottom, UIComboBox& top, UIComboBoxGroup& group) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(bottom, 20);
+        uicombobox_test::addNumberedItems(top, ITEM_COUNT);
+        group.add(bottom);
+        group.add(top);
+        bottom.expand();
+        group.flush(tft);
+        // Le composant du haut repasse au premier plan, au-dessus de la liste dépliée.
+        group.raise(top);
+        top.draw(tft, true);
+    };
+
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBox bottom(u8f, UIRect{ 20, 0, 200, 30 }, "", &style);
+    UIComboBox top(u8f, topRect, "", &style);
+    UIComboBoxGroup group;
+    build(tft, u8f, bottom, top, group);
+    for (int item = 0; item < 18; item += 2) {
+        bottom.updateItem(item, "modifié", item);
+    }
+    UIComboBoxDirtyRegion pending;
+    CHECK(!bottom.getPendingArea(pending));
+    CHECK_EQ(pending.size(), UIComboBoxDirtyRegion::MAX_RECTS);
+    group.flush(tft);
+
+    TFT_eSPI referenceTft;
+    U8g2_for_TFT_eSPI referenceU8f;
+    UIComboBox referenceBottom(referenceU8f, UIRect{ 20, 0, 200, 30 }, "", &style);
+    UIComboBox referenceTop(referenceU8f, topRect, "", &style);
+    UIComboBoxGroup referenceGroup;
+    build(referenceTft, referenceU8f, referenceBottom, referenceTop, referenceGroup);
+    for (int item = 0; item < 18; item += 2) {
+        referenceBottom.updateItem(item, "modifié", item);
+    }
+    referenceBottom.draw(referenceTft, true);
+    referenceTop.draw(referenceTft, true);
+    CHECK_EQ(TFT_eSPI::countDifferences(tft, referenceTft), (size_t)0);
+}
+
+TEST_CASE(clippedDrawKeepsPendingWork) {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    u8f.begin(tft);
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 5;
+    UIComboBox comboBox(u8f, BOTTOM_RECT, "", &style);
+    uicombobox_test::addNumberedItems(comboBox, ITEM_COUNT);
+    comboBox.setKineticScrolling(false);
+    comboBox.setBlitScrolling(true);
+    comboBox.expand();
+    comboBox.draw(tft, true);
+
+    auto matchesFullDraw = [&] {
+        TFT_eSPI reference;
+        u8f.begin(reference);
+        comboBox.draw(reference, true);
+        u8f.begin(tft);
+        return TFT_eSPI::countDifferences(tft, reference) == 0;
+    };
+
+    // Réparation d'un coin de la liste pendant qu'une nouvelle sélection attend d'être dessinée.
+    const UIRect corner = { BOTTOM_RECT.x, BOTTOM_RECT.y + 60, 40, 40 };
+    comboBox.setSelectedIndex(2);
+    comboBox.drawClipped(tft, corner);
+    CHECK(comboBox.needsRedraw());
+    comboBox.draw(tft, false);
+    CHECK(matchesFullDraw());
+
+    // Défilement en attente : la zone réparée montre la nouvelle position, la copie ne doit pas la déplacer.
+    int x = BOTTOM_RECT.x + 60;
+    int y = BOTTOM_RECT.y + BOTTOM_RECT.h + 3 * style.itemHeight;
+    unsigned long nowMs = 0;
+    comboBox.handleTouch(tft, x, y, true);
+    comboBox.handleTouch(tft, x, y - 20, true);
+    comboBox.updateScroll(nowMs += 16);
+    comboBox.handleTouch(tft, x, y - 35, true);
+    comboBox.updateScroll(nowMs += 16);
+    comboBox.handleTouch(tft, x, y - 35, false);
+    CHECK(comboBox.needsRedraw());
+    comboBox.drawClipped(tft, corner);
+    comboBox.draw(tft, false);
+    CHECK(matchesFullDraw());
+}
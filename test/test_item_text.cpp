@@ -0,0 +1,220 @@
+/**
+ * @file test_item_text.cpp
+ * @brief Textes longs : getSelectedText() les retourne en entier, l'affichage ne coupe pas un caractère UTF-8,
+ *        la liste interne tronque au-delà de 65 535 octets sur une limite de caractère ; ajout depuis une plage
+ *        à passage unique.
+ */
+
+#include "UIComboBoxTest.h"
+#include <UIComboBoxStatic.h>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace {
+
+const UIRect RECT = { 10, 30, 300, 30 };
+
+std::string longText(size_t length) {
+    std::string text;
+    for (size_t i = 0; i < length; i++) text += (char)('a' + i % 26);
+    return text;
+}
+
+bool isValidUtf8(const std::string& text) {
+    for (size_t i = 0; i < text.size();) {
+        uint8_t lead = (uint8_t)text[i];
+        size_t length = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+        if (length == 0 || i + length > text.size()) return false;
+        for (size_t j = 1; j < length; j++) {
+            if (((uint8_t)text[i + j] & 0xC0) != 0x80) return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+/**
+ * @brief Itérateur à passage unique sur des éléments numérotés : toutes ses copies partagent la même
+ *        position, comme un std::istream_iterator, si bien qu'une plage ne peut être lue qu'une fois.
+ */
+class SinglePassIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = UIComboBoxItem;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const UIComboBoxItem*;
+    using reference = const UIComboBoxItem&;
+
+    SinglePassIterator() = default;
+    explicit SinglePassIterator(int count) : _state(std::make_shared<State>()) {
+        _state->remaining = count;
+        load();
+    }
+
+    reference operator*() const { return _state->item; }
+    pointer operator->() const { return &_state->item; }
+    SinglePassIterator& operator++() {
+        _state->remaining--;
+        _state->next++;
+        load();
+        return *this;
+    }
+    bool operator==(const SinglePassIterator& other) const { return atEnd() == other.atEnd(); }
+    bool operator!=(const SinglePassIterator& other) const { return !(*this == other); }
+
+private:
+    struct State {
+        int remaining = 0;
+        int next = 0;
+        UIComboBoxItem item;
+    };
+
+    bool atEnd() const { return !_state || _state->remaining <= 0; }
+    void load() {
+        if (atEnd()) return;
+        _state->item = { String(("Flux " + std::to_string(_state->next)).c_str()), _state->next };
+    }
+
+    std::shared_ptr<State> _state;
+};
+
+} // namespace
+
+TEST_CASE(selectedTextIsNotTruncated) {
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBox comboBox(u8f, RECT, "Choix", UIComboBoxStyle());
+    std::string text = longText(100);
+    comboBox.addItem(text.c_str(), 1);
+    comboBox.addItem(longText(1000).c_str(), 2);
+    comboBox.setSelectedIndex(0);
+    CHECK_EQ(comboBox.getSelectedText().length(), 100u);
+    CHECK(comboBox.getSelectedText() == text.c_str());
+    comboBox.setSelectedIndex(1);
+    CHECK_EQ(comboBox.getSelectedText().length(), 1000u);
+}
+
+TEST_CASE(selectedTextIsNotTruncatedForEveryProvider) {
+    std::string text = longText(100);
+
+    std::vector<UIComboBoxItem> items = { { String(text.c_str()), 7 } };
+    UIComboBoxVectorProvider vectorProvider(items);
+    const UIComboBoxProgmemItem table[] = { { text.c_str(), 7 } };
+    UIComboBoxProgmemProvider progmemProvider(table, 1);
+    UIComboBoxGeneratorProvider generatorProvider(1, [&](size_t, char* buffer, size_t size) {
+        size_t length = std::min(text.size(), size - 1);
+        memcpy(buffer, text.c_str(), length);
+        buffer[length] = '\0';
+        return length;
+    });
+
+    for (UIComboBoxItemProvider* provider : { (UIComboBoxItemProvider*)&vectorProvider,
+                                              (UIComboBoxItemProvider*)&progmemProvider,
+                                              (UIComboBoxItemProvider*)&generatorProvider }) {
+        U8g2_for_TFT_eSPI u8f;
+        UIComboBox comboBox(u8f, RECT, "Choix", UIComboBoxStyle());
+        comboBox.setItemProvider(provider);
+        CHECK_EQ(provider->getItemTextLength(0), text.size());
+        CHECK(comboBox.getSelectedText() == text.c_str());
+    }
+}
+
+TEST_CASE(defaultTextLengthProbesBeyondEachBufferSize) {
+    size_t length = 0;
+    UIComboBoxGeneratorProvider provider(1, [&](size_t, char* buffer, size_t size) {
+        std::string text = longText(length);
+        size_t copied = std::min(text.size(), size - 1);
+        memcpy(buffer, text.c_str(), copied);
+        buffer[copied] = '\0';
+        return copied;
+    });
+    for (size_t tested : { 0, 1, 62, 63, 64, 126, 127, 128, 255, 256, 300, 5000 }) {
+        length = tested;
+        CHECK_EQ(provider.getItemTextLength(0), tested);
+    }
+}
+
+TEST_CASE(staticVariantCopiesLongTexts) {
+    U8g2_for_TFT_eSPI u8f;
+    static const UIComboBoxStyle style;
+    UIComboBoxStatic<4, 256> comboBox(u8f, RECT, "Choix", &style);
+    std::string text = longText(100);
+    CHECK(comboBox.addItem(text.c_str(), 1));
+    char buffer[128];
+    CHECK_EQ(comboBox.getSelectedText(buffer, sizeof(buffer)), text.size());
+    CHECK(text == buffer);
+}
+
+TEST_CASE(displayedTextNeverEndsInsideAUtf8Character) {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    u8f.begin(tft);
+    UIComboBox comboBox(u8f, RECT, "Choix", UIComboBoxStyle());
+    // Chaque texte place un caractère de 2, 3 ou 4 octets à cheval sur la limite d'affichage (127 octets).
+    const char* wide[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+    for (const char* character : wide) {
+        for (size_t before = 123; before <= 127; before++) {
+            std::string text = longText(before) + character + "fin";
+            comboBox.addItem(text.c_str(), (int)before);
+        }
+    }
+    u8f.recordPrints = true;
+    comboBox.expand();
+    comboBox.draw(tft, true);
+    for (int i = 0; i < comboBox.getItemCount(); i++) {
+        comboBox.setSelectedIndex(i);
+        comboBox.draw(tft, false);
+    }
+    CHECK(!u8f.printed.empty());
+    for (const std::string& printed : u8f.printed) {
+        CHECK(isValidUtf8(printed));
+        CHECK(printed.size() <= 127);
+    }
+    // Un caractère qui tient entièrement dans la limite est conservé.
+    std::string complete = longText(125) + "\xC3\xA9";
+    CHECK(std::find(u8f.printed.begin(), u8f.printed.end(), complete) != u8f.printed.end());
+}
+
+TEST_CASE(singlePassRangeIsReadOnce) {
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBox comboBox(u8f, RECT, "Choix", UIComboBoxStyle());
+    comboBox.addItem("avant", -1);
+    comboBox.addItems(SinglePassIterator(5), SinglePassIterator());
+    CHECK_EQ(comboBox.getItemCount(), 6);
+    comboBox.setSelectedIndex(5);
+    CHECK(comboBox.getSelectedText() == "Flux 4");
+    CHECK_EQ(comboBox.getSelectedValue(), 4);
+
+    // Une plage parcourable plusieurs fois est toujours réservée puis ajoutée.
+    std::vector<UIComboBoxItem> items = { { "un", 10 }, { "deux", 20 } };
+    comboBox.addItems(items.begin(), items.end());
+    CHECK_EQ(comboBox.getItemCount(), 8);
+    CHECK_EQ(comboBox.indexOfValue(20), 7);
+}
+
+TEST_CASE(overlongTextIsCutOnACharacterBoundary) {
+    const size_t limit = 0xFFFF;
+    UIComboBoxItemStore store;
+
+    // "é" occupe les deux octets situés de part et d'autre de la limite : il est retiré en entier.
+    std::string straddling = longText(limit - 1) + "\xC3\xA9" + "fin";
+    store.add(straddling.data(), straddling.size(), 1);
+    CHECK_EQ(store.getItemTextLength(0), limit - 1);
+
+    // Caractère de quatre octets commençant trois octets avant la limite.
+    std::string emoji = longText(limit - 3) + "\xF0\x9F\x98\x80";
+    store.insert(0, emoji.data(), emoji.size(), 2);
+    CHECK_EQ(store.getItemTextLength(0), limit - 3);
+
+    // Un texte qui se termine exactement à la limite est gardé entier.
+    std::string exact = longText(limit - 2) + "\xC3\xA9" + "x";
+    store.update(1, exact.data(), exact.size(), 3);
+    CHECK_EQ(store.getItemTextLength(1), limit);
+
+    for (size_t i = 0; i < store.size(); i++) {
+        std::string text(limit + 1, '\0');
+        size_t length = store.getItemText(i, &text[0], text.size());
+        text.resize(length);
+        CHECK(isValidUtf8(text));
+    }
+}
@@ -0,0 +1,256 @@
+/**
+ * @file test_kinetic_scroll.cpp
+ * @brief Défilement tactile : glissement au pixel près, échantillons regroupés par image, inertie
+ *        amortie, arrêt par un appui et butées en haut et en bas de la liste.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 100;
+const int FRAME_MS = 16;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 6;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    unsigned long nowMs = 0;
+    int touchX = RECT.x + 40;
+    int touchY = 0;
+
+    explicit Fixture(bool kinetic) : comboBox(u8f, RECT, "", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(comboBox, ITEM_COUNT);
+        comboBox.setKineticScrolling(kinetic);
+        comboBox.expand();
+        comboBox.draw(tft, true);
+    }
+
+    int listTop() const { return RECT.y + RECT.h; }
+    int maxPosition() const { return (ITEM_COUNT - style.maxVisibleItems) * style.itemHeight; }
+
+    /**
+     * @brief Pose le doigt sur la liste, au milieu de sa hauteur.
+     */
+    void press() {
+        touchY = listTop() + style.maxVisibleItems * style.itemHeight / 2;
+        comboBox.handleTouch(tft, touchX, touchY, true);
+    }
+
+    /**
+     * @brief Déplace le doigt de pixels vers le haut (négatif : vers le bas), sans changer d'image.
+     */
+    void move(int pixels) {
+        touchY -= pixels;
+        comboBox.handleTouch(tft, touchX, touchY, true);
+    }
+
+    void release() { comboBox.handleTouch(tft, touchX, touchY, false); }
+
+    /**
+     * @brief Passe à l'image suivante : applique les échantillons ou l'inertie, puis dessine.
+     * @return `true` si la position de défilement a changé.
+     */
+    bool frame() {
+        bool moved = comboBox.updateScroll(nowMs += FRAME_MS);
+        comboBox.draw(tft, false);
+        return moved;
+    }
+
+    /**
+     * @brief Glisse d'une traite de pixels vers le haut, une image par tranche de 40 pixels au plus.
+     * Les 20 premiers pixels, dans le sens du glissement, dépassent le seuil de glissement.
+     */
+    void drag(int pixels) {
+        press();
+        int engage = pixels > 0 ? 20 : -20;
+        move(engage);
+        frame();
+        for (int done = engage; done != pixels;) {
+            int step = std::max(-40, std::min(40, pixels - done));
+            move(step);
+            frame();
+            done += step;
+        }
+        release();
+        frame();
+    }
+
+    /**
+     * @brief Retourne l'index du premier élément dont le texte est rendu par un dessin complet.
+     */
+    int firstDrawnItem() {
+        u8f.printed.clear();
+        u8f.recordPrints = true;
+        TFT_eSPI scratch;
+        u8f.begin(scratch);
+        comboBox.draw(scratch, true);
+        u8f.begin(tft);
+        u8f.recordPrints = false;
+        // Le texte sélectionné de la boîte fermée précède les lignes.
+        return atoi(u8f.printed.at(1).c_str() + strlen("Item "));
+    }
+
+    /**
+     * @brief Retourne la position de défilement en pixels, ou -1 si aucune n'explique l'écran.
+     * Le composant est comparé, pixel par pixel, à un composant neuf amené à chaque position
+     * candidate par un glissement sans inertie.
+     */
+    int scrollPosition() {
+        TFT_eSPI screen;
+        u8f.begin(screen);
+        comboBox.draw(screen, true);
+        u8f.begin(tft);
+        int first = firstDrawnItem();
+        int from = std::max(0, (first - 1) * style.itemHeight);
+        int to = std::min(maxPosition(), (first + 1) * style.itemHeight);
+        for (int position = from; position <= to; position++) {
+            Fixture reference(false);
+            reference.comboBox.setSelectedIndex(comboBox.getSelectedIndex());
+            if (position > 0) reference.drag(position);
+            TFT_eSPI referenceScreen;
+            reference.u8f.begin(referenceScreen);
+            reference.comboBox.draw(referenceScreen, true);
+            if (TFT_eSPI::countDifferences(screen, referenceScreen) == 0) return position;
+        }
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST_CASE(dragFollowsTheFingerToThePixel) {
+    Fixture f(false);
+    f.press();
+    f.move(20); // Dépasse le seuil de glissement : le déplacement complet est appliqué
+    CHECK(f.frame());
+    CHECK_EQ(f.scrollPosition(), 20);
+
+    // Plusieurs échantillons entre deux images sont appliqués en une seule fois.
+    f.move(3);
+    f.move(9);
+    f.move(5);
+    CHECK(f.frame());
+    CHECK_EQ(f.scrollPosition(), 37);
+    CHECK(!f.frame()); // Rien de nouveau : la position ne change pas
+
+    // Retour en arrière du doigt, puis relâchement sans inertie.
+    f.move(-30);
+    f.release();
+    CHECK(!f.comboBox.isScrolling());
+    CHECK(!f.frame());
+    CHECK_EQ(f.scrollPosition(), 7);
+    CHECK(f.comboBox.isExpanded()); // Un glissement ne sélectionne rien
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 0);
+}
+
+TEST_CASE(flingDecaysAndStops) {
+    Fixture f(true);
+    f.press();
+    for (int i = 0; i < 3; i++) {
+        f.move(40);
+        f.frame();
+    }
+    f.release();
+    CHECK(f.comboBox.isScrolling());
+    int released = f.scrollPosition();
+    CHECK_EQ(released, 120);
+
+    // La liste poursuit sa course en ralentissant.
+    for (int i = 0; i < 10; i++) CHECK(f.frame());
+    int afterTen = f.scrollPosition();
+    for (int i = 0; i < 10; i++) f.frame();
+    int afterTwenty = f.scrollPosition();
+    CHECK(afterTen - released > afterTwenty - afterTen);
+    CHECK(afterTwenty > afterTen);
+
+    // Puis s'arrête d'elle-même.
+    int frames = 0;
+    while (f.comboBox.isScrolling() && frames < 500) {
+        f.frame();
+        frames++;
+    }
+    CHECK(!f.comboBox.isScrolling());
+    CHECK(frames < 500);
+    int stopped = f.scrollPosition();
+    CHECK(!f.frame());
+    CHECK_EQ(f.scrollPosition(), stopped);
+    CHECK(stopped < f.maxPosition());
+}
+
+TEST_CASE(touchDuringFlingStopsItWithoutSelecting) {
+    Fixture f(true);
+    f.drag(120);
+    CHECK(f.comboBox.isScrolling());
+    f.frame();
+
+    f.press();
+    f.release();
+    CHECK(!f.comboBox.isScrolling());
+    int stopped = f.scrollPosition();
+    CHECK(!f.frame());
+    CHECK_EQ(f.scrollPosition(), stopped);
+    CHECK(f.comboBox.isExpanded());
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 0);
+}
+
+TEST_CASE(scrollingStopsAtBothEnds) {
+    // En haut : tirer la liste vers le bas ne la déplace pas et ne lance pas d'inertie.
+    Fixture f(true);
+    f.press();
+    f.move(-60);
+    CHECK(!f.frame());
+    f.release();
+    CHECK(!f.comboBox.isScrolling());
+    CHECK_EQ(f.scrollPosition(), 0);
+
+    // Une chiquenaude vers le haut, à quatre lignes de la butée, s'y arrête net au lieu de ralentir.
+    f.comboBox.setKineticScrolling(false);
+    f.drag(4 * f.style.itemHeight);
+    f.comboBox.setKineticScrolling(true);
+    f.drag(-40);
+    CHECK(f.comboBox.isScrolling());
+    int frames = 0;
+    while (f.comboBox.isScrolling() && frames < 500) {
+        f.frame();
+        frames++;
+    }
+    CHECK_EQ(f.scrollPosition(), 0);
+    CHECK(frames < 20);
+
+    // En bas : le glissement s'arrête à la dernière position, et repart dès que le doigt revient.
+    Fixture bottom(false);
+    int end = bottom.maxPosition();
+    bottom.press();
+    for (int done = 0; done < end + 200; done += 40) {
+        bottom.move(40);
+        bottom.frame();
+    }
+    CHECK_EQ(bottom.scrollPosition(), end);
+    bottom.move(-5);
+    CHECK(bottom.frame());
+    bottom.release();
+    CHECK_EQ(bottom.scrollPosition(), end - 5);
+
+    // Une chiquenaude vers le bas s'arrête aussi sur la butée.
+    bottom.drag(-4 * bottom.style.itemHeight + 5);
+    bottom.comboBox.setKineticScrolling(true);
+    bottom.drag(40);
+    CHECK(bottom.comboBox.isScrolling());
+    frames = 0;
+    while (bottom.comboBox.isScrolling() && frames < 500) {
+        bottom.frame();
+        frames++;
+    }
+    CHECK_EQ(bottom.scrollPosition(), end);
+    CHECK(frames < 20);
+}
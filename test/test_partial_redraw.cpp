@@ -0,0 +1,100 @@
+/**
+ * @file test_partial_redraw.cpp
+ * @brief Redessin partiel : un changement de sélection ne repeint que les lignes concernées.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 20;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 6;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+
+    Fixture() : comboBox(u8f, RECT, "Choix", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(comboBox, ITEM_COUNT);
+    }
+
+    UIRect rowRect(int slot) const {
+        return UIRect{ RECT.x, RECT.y + RECT.h + slot * style.itemHeight, RECT.w, style.itemHeight };
+    }
+};
+
+} // namespace
+
+TEST_CASE(selectionChangeWithListOpenTouchesOnlyOldAndNewRows) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(2);
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, false);
+
+    // Avant : un changement de sélection redessinait tout le composant, comme ce dessin forcé.
+    f.tft.resetCounters();
+    f.comboBox.draw(f.tft, true);
+    uint64_t fullRedrawPixels = f.tft.counters.pixelsWritten;
+
+    // Après : seuls le texte de la boîte fermée, l'ancienne et la nouvelle ligne sont repeints.
+    f.tft.resetCounters();
+    f.comboBox.setSelectedIndex(4);
+    f.comboBox.draw(f.tft, false);
+    uint64_t partialPixels = f.tft.counters.pixelsWritten;
+    printf("pixels : %llu pour un dessin complet, %llu pour le changement de sélection\n",
+           (unsigned long long)fullRedrawPixels, (unsigned long long)partialPixels);
+
+    const UIRect header = { RECT.x, RECT.y, RECT.w, RECT.h };
+    CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { header, f.rowRect(2), f.rowRect(4) }));
+    CHECK(partialPixels <= (uint64_t)(RECT.w * RECT.h + 2 * RECT.w * f.style.itemHeight));
+    CHECK(partialPixels * 4 < fullRedrawPixels);
+    for (int slot : { 0, 1, 3, 5 }) {
+        UIRect row = f.rowRect(slot);
+        CHECK(!f.tft.isTouched(row.x + row.w / 2, row.y + row.h / 2));
+    }
+
+    // Le résultat est identique à un dessin complet de l'état final.
+    Fixture reference;
+    reference.comboBox.setSelectedIndex(4);
+    reference.comboBox.expand();
+    reference.comboBox.draw(reference.tft, true);
+    CHECK_EQ(TFT_eSPI::countDifferences(f.tft, reference.tft), (size_t)0);
+}
+
+TEST_CASE(selectionChangeWithListClosedTouchesOnlyTheHeader) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(2);
+    f.comboBox.draw(f.tft, true);
+
+    f.tft.resetCounters();
+    f.comboBox.setSelectedIndex(7);
+    f.comboBox.draw(f.tft, false);
+    CHECK(f.tft.counters.pixelsWritten > 0);
+    CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { UIRect{ RECT.x, RECT.y, RECT.w, RECT.h } }));
+
+    Fixture reference;
+    reference.comboBox.setSelectedIndex(7);
+    reference.comboBox.draw(reference.tft, true);
+    CHECK_EQ(TFT_eSPI::countDifferences(f.tft, reference.tft), (size_t)0);
+}
+
+TEST_CASE(unchangedSelectionDrawsNothing) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(3);
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, false);
+
+    f.tft.resetCounters();
+    f.comboBox.setSelectedIndex(3);
+    f.comboBox.draw(f.tft, false);
+    CHECK_EQ(f.tft.counters.calls(), 0u);
+}
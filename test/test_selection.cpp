@@ -0,0 +1,177 @@
+/**
+ * @file test_selection.cpp
+ * @brief Sélection stable : l'élément sélectionné le reste à travers les insertions, suppressions et
+ *        modifications, et le rappel de sélection n'est appelé que lorsque la sélection change vraiment.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 20;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 6;
+    return style;
+}
+
+struct Selection {
+    int index;
+    int value;
+};
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    std::vector<Selection> callbacks; /**< Les appels du rappel de sélection, dans l'ordre. */
+
+    Fixture() : comboBox(u8f, RECT, "", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(comboBox, ITEM_COUNT);
+        comboBox.setOnSelect([this](int index, int value) { callbacks.push_back({ index, value }); });
+    }
+
+    /**
+     * @brief Retourne les textes des lignes affichées par un dessin complet de la liste dépliée.
+     */
+    std::vector<std::string> visibleTexts() {
+        u8f.printed.clear();
+        u8f.recordPrints = true;
+        comboBox.draw(tft, true);
+        u8f.recordPrints = false;
+        // La boîte fermée affiche d'abord le texte sélectionné.
+        return std::vector<std::string>(u8f.printed.begin() + 1, u8f.printed.end());
+    }
+
+    /**
+     * @brief Indique si le dernier dessin n'a touché que la barre de défilement et la bordure de la liste, qu'elle retrace.
+     */
+    bool touchedOnlyScrollBar() const {
+        int top = RECT.y + RECT.h;
+        int height = style.maxVisibleItems * style.itemHeight;
+        return uicombobox_test::touchedOnlyWithin(tft, {
+            { RECT.x + RECT.w - style.scrollBarWidth, top, style.scrollBarWidth, height },
+            { RECT.x, top, RECT.w, 1 },
+            { RECT.x, top + height - 1, RECT.w, 1 },
+            { RECT.x, top, 1, height },
+        });
+    }
+};
+
+} // namespace
+
+TEST_CASE(selectionFollowsItsItemThroughMutations) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(10);
+    f.callbacks.clear();
+
+    // Insertions avant et après l'élément : son index suit, le rappel n'est pas appelé.
+    f.comboBox.insertItem(0, "Nouveau", 100);
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 11);
+    f.comboBox.insertItem(15, "Autre", 101);
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 11);
+    CHECK_EQ(f.comboBox.getSelectedValue(), 10);
+
+    // Suppressions avant et après l'élément.
+    CHECK(f.comboBox.removeItem(0));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 10);
+    CHECK(f.comboBox.removeItem(14));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 10);
+    CHECK(f.comboBox.getSelectedText() == "Item 10");
+
+    // Modification de l'élément sélectionné et d'un autre élément.
+    CHECK(f.comboBox.updateItem(10, "Renommé", 10));
+    CHECK(f.comboBox.updateItem(3, "Trois", 3));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 10);
+    CHECK(f.comboBox.getSelectedText() == "Renommé");
+
+    // Resélectionner l'élément déjà sélectionné n'est pas un changement.
+    f.comboBox.setSelectedIndex(10);
+    CHECK(f.comboBox.setSelectedValue(10));
+    CHECK_EQ(f.callbacks.size(), (size_t)0);
+
+    // Un vrai changement appelle le rappel une fois, avec le nouvel élément.
+    CHECK(f.comboBox.setSelectedValue(1));
+    CHECK_EQ(f.callbacks.size(), (size_t)1);
+    CHECK_EQ(f.callbacks.back().index, 1);
+    CHECK_EQ(f.callbacks.back().value, 1);
+}
+
+TEST_CASE(removingTheSelectedItemSelectsItsSuccessorAndNotifies) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(5);
+    f.callbacks.clear();
+
+    CHECK(f.comboBox.removeItem(5));
+    CHECK_EQ(f.callbacks.size(), (size_t)1);
+    CHECK_EQ(f.callbacks.back().index, 5);
+    CHECK_EQ(f.callbacks.back().value, 6);
+    CHECK(f.comboBox.getSelectedText() == "Item 6");
+
+    // Le dernier élément n'a pas de suivant : la sélection passe au précédent.
+    int last = f.comboBox.getItemCount() - 1;
+    f.comboBox.setSelectedIndex(last);
+    f.callbacks.clear();
+    CHECK(f.comboBox.removeItem(last));
+    CHECK_EQ(f.callbacks.size(), (size_t)1);
+    CHECK_EQ(f.callbacks.back().index, last - 1);
+    CHECK_EQ(f.comboBox.getSelectedValue(), ITEM_COUNT - 2);
+
+    // Vider la liste retire la sélection une seule fois.
+    f.callbacks.clear();
+    f.comboBox.clear();
+    f.comboBox.clear();
+    CHECK_EQ(f.callbacks.size(), (size_t)1);
+    CHECK_EQ(f.callbacks.back().index, -1);
+    CHECK_EQ(f.callbacks.back().value, -1);
+    CHECK_EQ(f.comboBox.getSelectedIndex(), -1);
+    CHECK(!f.comboBox.removeItem(0));
+}
+
+TEST_CASE(valueLookupFollowsMutations) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(0);
+
+    f.comboBox.insertItem(0, "Premier", 500);
+    CHECK(f.comboBox.setSelectedValue(500));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 0);
+
+    // Après une modification, l'ancienne valeur n'est plus trouvée et la nouvelle l'est.
+    f.comboBox.updateItem(0, "Premier", 501);
+    CHECK(!f.comboBox.setSelectedValue(500));
+    CHECK(f.comboBox.setSelectedValue(7));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 8);
+    CHECK(f.comboBox.setSelectedValue(501));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 0);
+
+    // Après une suppression, les index suivants sont décalés.
+    f.comboBox.removeItem(0);
+    CHECK(!f.comboBox.setSelectedValue(501));
+    CHECK(f.comboBox.setSelectedValue(7));
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 7);
+}
+
+TEST_CASE(mutationsAboveTheViewKeepTheVisibleRows) {
+    Fixture f;
+    f.comboBox.expand();
+    f.comboBox.setSelectedIndex(15); // La vue défile jusqu'à l'élément
+    std::vector<std::string> before = f.visibleTexts();
+
+    // Les mêmes lignes restent à l'écran : seule la barre de défilement est repeinte.
+    f.comboBox.insertItem(0, "Nouveau", 100);
+    f.tft.resetCounters();
+    f.comboBox.draw(f.tft, false);
+    CHECK(f.touchedOnlyScrollBar());
+    CHECK(f.visibleTexts() == before);
+
+    f.comboBox.removeItem(1);
+    f.tft.resetCounters();
+    f.comboBox.draw(f.tft, false);
+    CHECK(f.touchedOnlyScrollBar());
+    CHECK(f.visibleTexts() == before);
+    CHECK(f.comboBox.getSelectedText() == "Item 15");
+}
@@ -0,0 +1,282 @@
+/**
+ * @file test_sort.cpp
+ * @brief Tri de la liste : sélection et défilement conservés, sections cohérentes, clés lues une fois par dichotomie.
+ */
+
+#include "UIComboBoxTest.h"
+#include <algorithm>
+#include <cctype>
+#include <random>
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 40;
+const int FRAME_MS = 16;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 8;
+    return style;
+}
+
+/**
+ * @brief Texte d'un élément dont l'ordre alphabétique diffère de l'ordre des index : "h12", "e13"…
+ */
+std::string itemText(int index) {
+    char text[8];
+    snprintf(text, sizeof(text), "%c%02d", 'a' + (index * 7) % 10, index);
+    return text;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    unsigned long nowMs = 0;
+
+    Fixture() : comboBox(u8f, RECT, "", &style) {
+        u8f.begin(tft);
+        for (int i = 0; i < ITEM_COUNT; i++) comboBox.addItem(itemText(i).c_str(), i);
+        comboBox.setKineticScrolling(false);
+    }
+
+    /**
+     * @brief Retourne les textes des lignes affichées (en-têtes compris) par un dessin complet de la liste dépliée.
+     */
+    std::vector<std::string> visibleTexts() {
+        comboBox.draw(tft, false);
+        u8f.printed.clear();
+        u8f.recordPrints = true;
+        comboBox.draw(tft, true);
+        u8f.recordPrints = false;
+        // La boîte fermée affiche d'abord le texte sélectionné.
+        return std::vector<std::string>(u8f.printed.begin() + 1, u8f.printed.end());
+    }
+
+    /**
+     * @brief Retourne la ligne à l'écran du texte donné, -1 s'il n'est pas affiché.
+     */
+    int slotOf(const std::string& text) {
+        std::vector<std::string> texts = visibleTexts();
+        auto it = std::find(texts.begin(), texts.end(), text);
+        return it == texts.end() ? -1 : (int)(it - texts.begin());
+    }
+
+    /**
+     * @brief Fait glisser la liste de pixels vers le haut.
+     */
+    void drag(int pixels) {
+        int x = RECT.x + 40;
+        int y = RECT.y + RECT.h + 6 * style.itemHeight;
+        comboBox.handleTouch(tft, x, y, true);
+        comboBox.handleTouch(tft, x, y - 20, true); // Dépasse le seuil de glissement
+        comboBox.updateScroll(nowMs += FRAME_MS);
+        comboBox.handleTouch(tft, x, y - 20 - pixels, true);
+        comboBox.updateScroll(nowMs += FRAME_MS);
+        comboBox.handleTouch(tft, x, y - 20 - pixels, false);
+        comboBox.draw(tft, false);
+    }
+
+    /**
+     * @brief Fait défiler la liste jusqu'en bas, par glissements successifs.
+     */
+    void dragToEnd() {
+        for (int i = 0; i < ITEM_COUNT / 4; i++) drag(4 * style.itemHeight);
+    }
+};
+
+/**
+ * @brief Vérifie que chaque en-tête affiché porte l'initiale de l'élément qui le suit et commence bien une section.
+ */
+bool headersAreConsistent(const std::vector<std::string>& texts) {
+    std::string previousInitial;
+    for (size_t i = 0; i < texts.size(); i++) {
+        bool header = texts[i].size() == 1;
+        std::string initial(1, (char)toupper((unsigned char)texts[i][0]));
+        if (header) {
+            if (texts[i] != initial || initial == previousInitial) return false;
+            if (i + 1 < texts.size() && std::string(1, (char)toupper((unsigned char)texts[i + 1][0])) != initial) return false;
+        } else if (i > 0 && initial != previousInitial) {
+            return false; // Changement de section sans en-tête
+        }
+        previousInitial = initial;
+    }
+    return true;
+}
+
+/**
+ * @brief Fournisseur qui compte les lectures de texte.
+ */
+struct CountingProvider : UIComboBoxVectorProvider {
+    mutable size_t textReads = 0;
+
+    explicit CountingProvider(const std::vector<UIComboBoxItem>& items) : UIComboBoxVectorProvider(items) {}
+
+    size_t getItemText(size_t index, char* buffer, size_t bufferSize) const override {
+        textReads++;
+        return UIComboBoxVectorProvider::getItemText(index, buffer, bufferSize);
+    }
+};
+
+/**
+ * @brief Vérifie qu'un index tenu à jour élément par élément est identique à un index reconstruit.
+ */
+bool matchesRebuild(const UIComboBoxSortIndex& index, const UIComboBoxItemProvider& provider, bool descending) {
+    UIComboBoxSortIndex rebuilt;
+    rebuilt.setSortKey(UIComboBoxSortIndex::SORT_TEXT, descending);
+    rebuilt.setSections(true);
+    rebuilt.build(provider);
+    if (index.rowCount() != rebuilt.rowCount()) return false;
+    char text[32];
+    char expected[32];
+    for (size_t row = 0; row < rebuilt.rowCount(); row++) {
+        if (index.itemAt(row) != rebuilt.itemAt(row)) return false;
+        if (rebuilt.itemAt(row) < 0) {
+            index.headerText(provider, row, text, sizeof(text));
+            rebuilt.headerText(provider, row, expected, sizeof(expected));
+            if (strcmp(text, expected) != 0) return false;
+        }
+    }
+    for (size_t item = 0; item < provider.getItemCount(); item++) {
+        if (index.rowOf(provider, item) != rebuilt.rowOf(provider, item)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE(selectionKeepsItsSlotAcrossResorts) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(5);
+    f.comboBox.expand();
+    f.drag(3 * f.style.itemHeight);
+    const std::string selected = itemText(5);
+    int slot = f.slotOf(selected);
+    CHECK(slot > 0 && slot < f.style.maxVisibleItems - 1);
+
+    f.comboBox.setSortOrder(UIComboBoxSortIndex::SORT_TEXT);
+    std::vector<std::string> texts = f.visibleTexts();
+    CHECK(std::is_sorted(texts.begin(), texts.end()));
+    CHECK_EQ(f.slotOf(selected), slot);
+
+    f.comboBox.setSectionHeaders(true);
+    CHECK_EQ(f.slotOf(selected), slot);
+    CHECK(headersAreConsistent(f.visibleTexts()));
+
+    f.comboBox.setSortOrder(UIComboBoxSortIndex::SORT_TEXT, true);
+    CHECK_EQ(f.slotOf(selected), slot);
+    CHECK(headersAreConsistent(f.visibleTexts()));
+
+    f.comboBox.setSortOrder(UIComboBoxSortIndex::SORT_NONE);
+    CHECK_EQ(f.slotOf(selected), slot);
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 5);
+}
+
+TEST_CASE(firstVisibleItemAnchorsTheViewWhenTheSelectionIsHidden) {
+    Fixture f;
+    f.comboBox.setSelectedIndex(0);
+    f.comboBox.expand();
+    f.drag(12 * f.style.itemHeight);
+    CHECK_EQ(f.slotOf(itemText(0)), -1);
+    const std::string first = f.visibleTexts().front();
+
+    f.comboBox.setSortOrder(UIComboBoxSortIndex::SORT_TEXT);
+    CHECK(f.visibleTexts().front() == first);
+    f.comboBox.setSectionHeaders(true);
+    CHECK(f.visibleTexts().front() == first);
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 0);
+}
+
+TEST_CASE(selectionFollowsItsItemWhenRanksChange) {
+    Fixture f;
+    f.comboBox.setSortOrder(UIComboBoxSortIndex::SORT_TEXT);
+    f.comboBox.setSectionHeaders(true);
+    f.comboBox.setSelectedIndex(10);
+    f.comboBox.expand();
+    CHECK(f.slotOf(itemText(10)) >= 0);
+
+    // L'élément sélectionné change de rang et ouvre une nouvelle section, en fin de liste.
+    f.comboBox.updateItem(10, "zz", 10);
+    CHECK_EQ(f.comboBox.getSelectedIndex(), 10);
+    CHECK(headersAreConsistent(f.visibleTexts()));
+    f.dragToEnd();
+    std::vector<std::string> texts = f.visibleTexts();
+    CHECK(texts.size() >= 2 && texts[texts.size() - 2] == "Z" && texts.back() == "zz");
+    CHECK(headersAreConsistent(texts));
+
+    // D'autres éléments passent avant lui, ou disparaissent.
+    f.comboBox.insertItem(0, "zy", 100);
+    f.comboBox.removeItem(3);
+    f.dragToEnd();
+    CHECK_EQ(f.comboBox.getSelectedValue(), 10);
+    CHECK(f.comboBox.getSelectedText() == "zz");
+    texts = f.visibleTexts();
+    CHECK(texts.size() >= 3 && texts[texts.size() - 3] == "Z" && texts[texts.size() - 2] == "zy");
+    CHECK(headersAreConsistent(texts));
+
+    // La dernière lettre de sa section disparaît : l'en-tête aussi.
+    f.comboBox.updateItem(0, "a0", 100);
+    f.comboBox.updateItem(f.comboBox.getSelectedIndex(), "b99", 10);
+    texts = f.visibleTexts();
+    CHECK(std::find(texts.begin(), texts.end(), "Z") == texts.end());
+    CHECK(headersAreConsistent(texts));
+}
+
+TEST_CASE(incrementalSectionsMatchARebuild) {
+    for (bool descending : { false, true }) {
+        std::mt19937 random(descending ? 7 : 3);
+        std::vector<UIComboBoxItem> items;
+        UIComboBoxVectorProvider provider(items);
+        UIComboBoxSortIndex index;
+        index.setSortKey(UIComboBoxSortIndex::SORT_TEXT, descending);
+        index.setSections(true);
+        auto randomText = [&] {
+            std::string text(1, (char)('a' + random() % 6));
+            text += std::to_string(random() % 50);
+            return String(text.c_str());
+        };
+        for (int i = 0; i < 50; i++) items.push_back({ randomText(), i });
+        index.build(provider);
+
+        bool consistent = true;
+        for (int step = 0; step < 400 && consistent; step++) {
+            size_t item = items.empty() ? 0 : random() % items.size();
+            switch (random() % 3) {
+            case 0:
+                items.insert(items.begin() + item, UIComboBoxItem{ randomText(), step });
+                index.itemInserted(provider, item);
+                break;
+            case 1:
+                if (items.size() < 2) break;
+                items.erase(items.begin() + item);
+                index.itemRemoved(provider, item);
+                break;
+            default:
+                if (items.empty()) break;
+                items[item].text = randomText();
+                index.itemUpdated(provider, item);
+                break;
+            }
+            consistent = matchesRebuild(index, provider, descending);
+        }
+        CHECK(consistent);
+    }
+}
+
+TEST_CASE(insertionReadsTheNewKeyOnce) {
+    std::vector<UIComboBoxItem> items;
+    for (int i = 0; i < 1024; i++) items.push_back({ String(itemText(i).c_str()), i });
+    CountingProvider provider(items);
+    UIComboBoxSortIndex index;
+    index.setSortKey(UIComboBoxSortIndex::SORT_TEXT, false);
+    index.build(provider);
+
+    // Dichotomie sur 1024 positions : 11 clés d'éléments en place, plus celle de l'élément inséré.
+    items.push_back({ "m00", -1 });
+    provider.textReads = 0;
+    index.itemsAppended(provider);
+    CHECK(provider.textReads <= 12);
+    CHECK(index.rowOf(provider, 1024) >= 0);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_sprite_rendering.cpp
+ * @brief Rendu de la liste par sprite : tampon complet, bandes, échec d'allocation et DMA.
+ *
+ * Chaque rendu par sprite est comparé, pixel par pixel, au rendu direct du même état.
+ * Compilé une seconde fois avec ESP32_DMA pour exercer l'envoi par pushImageDMA().
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const size_t FULL_BUDGET = 256 * 1024;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 6;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+
+    explicit Fixture(size_t spriteBudget) : comboBox(u8f, RECT, "Choix", &style) {
+        u8f.begin(tft);
+#if defined(ESP32_DMA)
+        tft.initDMA();
+#endif
+        uicombobox_test::addNumberedItems(comboBox, 40);
+        comboBox.setSelectedIndex(3);
+        if (spriteBudget > 0) comboBox.setSpriteRendering(true, spriteBudget);
+    }
+
+    int listHeight() const { return style.maxVisibleItems * style.itemHeight; }
+    uint32_t listPushes() const { return tft.counters.pushImage + tft.counters.pushImageDMA; }
+};
+
+/**
+ * @brief Déplie les deux listes et vérifie que le rendu par sprite est identique au rendu direct.
+ */
+void expandAndCompare(Fixture& sprite) {
+    Fixture direct(0);
+    direct.comboBox.expand();
+    direct.comboBox.draw(direct.tft, false);
+
+    sprite.tft.resetCounters();
+    sprite.comboBox.expand();
+    sprite.comboBox.draw(sprite.tft, false);
+    CHECK_EQ(TFT_eSPI::countDifferences(sprite.tft, direct.tft), (size_t)0);
+}
+
+/**
+ * @brief Vérifie que les envois de la liste sont passés par le chemin attendu (DMA ou non).
+ */
+void checkPushPath(const Fixture& f) {
+#if defined(ESP32_DMA)
+    CHECK_EQ(f.tft.counters.pushImage, 0u);
+    CHECK(f.tft.counters.pushImageDMA > 0);
+#else
+    CHECK_EQ(f.tft.counters.pushImageDMA, 0u);
+#endif
+}
+
+} // namespace
+
+TEST_CASE(fullBufferMatchesDirectRendering) {
+    TFT_eSprite::resetAllocationControl();
+    Fixture f(FULL_BUDGET);
+    expandAndCompare(f);
+    CHECK_EQ(f.listPushes(), 1u); // Toute la liste en une seule fenêtre
+    CHECK_EQ(TFT_eSprite::failedAllocationCount(), 0u);
+    checkPushPath(f);
+}
+
+TEST_CASE(spriteRenderingSendsFewerWindows) {
+    Fixture direct(0);
+    direct.comboBox.expand();
+    direct.tft.resetCounters();
+    direct.comboBox.draw(direct.tft, false);
+
+    Fixture f(FULL_BUDGET);
+    f.comboBox.expand();
+    f.tft.resetCounters();
+    f.comboBox.draw(f.tft, false);
+    CHECK(f.tft.counters.transactions * 2 < direct.tft.counters.transactions);
+}
+
+TEST_CASE(stripsMatchDirectRendering) {
+    const int stripLines = 40;
+    Fixture f(RECT.w * sizeof(uint16_t) * stripLines);
+    expandAndCompare(f);
+    CHECK_EQ(f.listPushes(), (uint32_t)((f.listHeight() + stripLines - 1) / stripLines));
+    checkPushPath(f);
+}
+
+TEST_CASE(allocationFailureRetriesWithSmallerStrips) {
+    TFT_eSprite::resetAllocationControl();
+    Fixture f(FULL_BUDGET);
+    // Le tampon complet (180 lignes) est refusé ; 45 lignes tiennent dans la limite.
+    TFT_eSprite::setAllocationLimit(RECT.w * sizeof(uint16_t) * 50);
+    expandAndCompare(f);
+    CHECK(TFT_eSprite::failedAllocationCount() >= 2);
+    CHECK_EQ(f.listPushes(), 4u);
+    checkPushPath(f);
+    TFT_eSprite::resetAllocationControl();
+}
+
+TEST_CASE(allocationFailureFallsBackToDirectRendering) {
+    TFT_eSprite::resetAllocationControl();
+    Fixture f(FULL_BUDGET);
+    TFT_eSprite::failNextAllocations(1000);
+    expandAndCompare(f);
+    CHECK(TFT_eSprite::failedAllocationCount() > 0);
+    CHECK_EQ(f.listPushes(), 0u);
+
+    // Les allocations redevenues possibles, le sprite est de nouveau utilisé.
+    TFT_eSprite::resetAllocationControl();
+    f.tft.resetCounters();
+    f.comboBox.draw(f.tft, true);
+    CHECK(f.listPushes() > 0);
+}
+
+TEST_CASE(spriteRenderingFollowsSelectionAndScrolling) {
+    Fixture f(RECT.w * sizeof(uint16_t) * 64);
+    Fixture direct(0);
+    for (Fixture* fixture : { &f, &direct }) {
+        fixture->comboBox.expand();
+        fixture->comboBox.draw(fixture->tft, false);
+        fixture->comboBox.setSelectedIndex(5);
+        fixture->comboBox.draw(fixture->tft, false);
+        fixture->comboBox.setSelectedIndex(25); // Hors de la vue : la liste défile
+        fixture->comboBox.draw(fixture->tft, false);
+    }
+    CHECK_EQ(TFT_eSPI::countDifferences(f.tft, direct.tft), (size_t)0);
+}
+
+TEST_CASE(swapBytesSettingIsRestored) {
+    Fixture f(FULL_BUDGET);
+    f.tft.setSwapBytes(true);
+    expandAndCompare(f);
+    CHECK(f.tft.getSwapBytes());
+}
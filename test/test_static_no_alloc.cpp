@@ -0,0 +1,189 @@
+/**
+ * @file test_static_no_alloc.cpp
+ * @brief UIComboBoxStatic : aucune allocation après la construction, et le même rendu qu'un UIComboBox.
+ *
+ * Ce programme remplace les opérateurs new globaux pour compter les allocations faites pendant les
+ * appels au composant statique ; il est compilé seul pour ne pas fausser les autres tests.
+ */
+
+#include "UIComboBoxTest.h"
+#include <UIComboBoxStatic.h>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+bool countAllocations = false; /**< Vrai pendant les appels mesurés. */
+size_t allocations = 0;        /**< Allocations faites pendant les appels mesurés. */
+
+void* allocate(size_t size) {
+    if (countAllocations) allocations++;
+    return malloc(size ? size : 1);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* pointer = allocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = allocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+
+namespace {
+
+const UIRect RECT = { 10, 40, 200, 30 };
+const UIComboBoxStaticItem TABLE[] = { { "alpha", 1 }, { "bravo", 2 }, { "charlie", 3 }, { "delta", 4 } };
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 5;
+    style.itemHeight = 20;
+    return style;
+}
+
+struct Callbacks {
+    int selects = 0;
+    int lastValue = -2;
+    int collapses = 0;
+};
+
+/**
+ * @brief Le composant statique et un UIComboBox de référence, chacun sur son écran.
+ */
+struct Fixture {
+    UIComboBoxStyle style = makeStyle();
+    TFT_eSPI staticTft;
+    TFT_eSPI referenceTft;
+    U8g2_for_TFT_eSPI staticU8f;
+    U8g2_for_TFT_eSPI referenceU8f;
+    UIComboBoxStatic<16, 128> comboBox;
+    UIComboBox reference;
+    Callbacks callbacks;
+
+    Fixture() : comboBox(staticU8f, RECT, "Appareils", &style), reference(referenceU8f, RECT, "Appareils", &style) {
+        staticU8f.begin(staticTft);
+        referenceU8f.begin(referenceTft);
+        comboBox.setOnSelect([](void* context, int, int value) {
+            Callbacks* callbacks = (Callbacks*)context;
+            callbacks->selects++;
+            callbacks->lastValue = value;
+        }, &callbacks);
+        comboBox.setOnCollapse([](void* context, const UIRect&) { ((Callbacks*)context)->collapses++; }, &callbacks);
+        comboBox.draw(staticTft, true);
+        reference.draw(referenceTft, true);
+    }
+
+    /**
+     * @brief Applique une opération aux deux composants, mesure les allocations du composant statique
+     *        (dessin compris) et retourne le nombre de pixels qui diffèrent entre les deux écrans.
+     */
+    template <typename StaticAction, typename ReferenceAction>
+    size_t both(StaticAction staticAction, ReferenceAction referenceAction) {
+        countAllocations = true;
+        staticAction();
+        comboBox.draw(staticTft, false);
+        countAllocations = false;
+        referenceAction();
+        reference.draw(referenceTft, false);
+        return TFT_eSPI::countDifferences(staticTft, referenceTft);
+    }
+
+    int rowCenterY(int slot) const { return RECT.y + RECT.h + slot * style.itemHeight + style.itemHeight / 2; }
+};
+
+} // namespace
+
+TEST_CASE(staticComboBoxNeverAllocatesAfterConstruction) {
+    Fixture f;
+    allocations = 0;
+
+    CHECK_EQ(f.both([&] { CHECK(f.comboBox.addItems(TABLE)); },
+                    [&] { for (const UIComboBoxStaticItem& item : TABLE) f.reference.addItem(item.text, item.value); }),
+             (size_t)0);
+    CHECK_EQ(f.both([&] {
+                        char text[16];
+                        for (int i = 0; i < 8; i++) {
+                            snprintf(text, sizeof(text), "item%d", i);
+                            CHECK(f.comboBox.addItem(text, 10 + i));
+                        }
+                    },
+                    [&] {
+                        char text[16];
+                        for (int i = 0; i < 8; i++) {
+                            snprintf(text, sizeof(text), "item%d", i);
+                            f.reference.addItem(text, 10 + i);
+                        }
+                    }),
+             (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.expand(); }, [&] { f.reference.expand(); }), (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.insertItem(2, "inséré", 99); }, [&] { f.reference.insertItem(2, "inséré", 99); }),
+             (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.removeItem(0); }, [&] { f.reference.removeItem(0); }), (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.updateItem(3, "un texte bien plus long", 42); },
+                    [&] { f.reference.updateItem(3, "un texte bien plus long", 42); }),
+             (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.setSelectedIndex(5); }, [&] { f.reference.setSelectedIndex(5); }), (size_t)0);
+
+    // Appui bref puis glissement sur la liste, et appui sur une ligne.
+    int y = f.rowCenterY(1);
+    CHECK_EQ(f.both([&] {
+                        f.comboBox.handleTouch(f.staticTft, 50, y, true);
+                        f.comboBox.handleTouch(f.staticTft, 50, y, false);
+                    },
+                    [&] {
+                        f.reference.handleTouch(f.referenceTft, 50, y, true);
+                        f.reference.handleTouch(f.referenceTft, 50, y, false);
+                    }),
+             (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.expand(); }, [&] { f.reference.expand(); }), (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.handlePress(f.staticTft, 50, f.rowCenterY(2)); },
+                    [&] { f.reference.handlePress(f.referenceTft, 50, f.rowCenterY(2)); }),
+             (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.setSelectedValue(42); }, [&] { f.reference.setSelectedValue(42); }), (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.expand(); }, [&] { f.reference.expand(); }), (size_t)0);
+    CHECK_EQ(f.both([&] { f.comboBox.collapse(); }, [&] { f.reference.collapse(); }), (size_t)0);
+
+    // Lecture du texte, refus d'ajout lorsque la capacité est atteinte, forçage du dessin.
+    countAllocations = true;
+    char text[32];
+    f.comboBox.getSelectedText(text, sizeof(text));
+    bool rejected = false;
+    for (int i = 0; i < 10; i++) {
+        if (!f.comboBox.addItem("x", 0)) rejected = true;
+    }
+    f.comboBox.draw(f.staticTft, true);
+    countAllocations = false;
+    CHECK(rejected);
+    CHECK(std::string(text) == "un texte bien plus long");
+
+    CHECK_EQ(f.both([&] { f.comboBox.clear(); }, [&] { f.reference.clear(); }), (size_t)0);
+    CHECK_EQ(allocations, (size_t)0);
+
+    // Les rappels sans allocation ont bien été appelés.
+    CHECK(f.callbacks.selects > 0);
+    CHECK_EQ(f.callbacks.lastValue, -1); // clear() vide la sélection
+    CHECK(f.callbacks.collapses > 0);
+}
+
+TEST_CASE(countingOperatorNewDetectsAllocations) {
+    // Contrôle du dispositif : une allocation faite pendant la mesure est bien comptée.
+    allocations = 0;
+    countAllocations = true;
+    std::string* text = new std::string(64, 'x');
+    countAllocations = false;
+    delete text;
+    CHECK(allocations > 0);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_stats.cpp
+ * @brief Instrumentation (UICOMBOBOX_ENABLE_STATS=1) : types de dessin, appels de primitives et pixels
+ *        comparés aux compteurs de l'écran simulé.
+ *
+ * Les éléments ont un texte vide : les pixels des glyphes, tracés par U8g2, ne passent pas par les
+ * primitives comptées par l'instrumentation.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int FRAME_MS = 16;
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 5;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    unsigned long nowMs = 0;
+
+    Fixture() : comboBox(u8f, RECT, "", &style) {
+        u8f.begin(tft);
+        for (int i = 0; i < 10; i++) comboBox.addItem("", i);
+        comboBox.setKineticScrolling(false);
+        reset();
+    }
+
+    void reset() {
+        comboBox.resetStats();
+        tft.resetCounters();
+    }
+
+    /**
+     * @brief Vérifie que les appels comptés par le composant sont ceux reçus par l'écran, puis remet tout à zéro.
+     * @param arrowDrawn Vrai si la flèche a été dessinée : son triangle est compté comme un carré de arrowSize pixels.
+     */
+    void checkAgainstDisplay(bool arrowDrawn) {
+        const UIComboBoxStats& stats = comboBox.getStats();
+        const MockDisplayCounters& display = tft.counters;
+        CHECK_EQ(stats.fillCalls, display.fillRect + display.fillTriangle);
+        CHECK_EQ(stats.rectCalls, display.drawRect + display.fastHLine + display.fastVLine);
+        CHECK_EQ(stats.pushCalls, display.pushImage + display.pushBlock);
+        if (arrowDrawn) {
+            uint64_t square = (uint64_t)style.arrowSize * style.arrowSize;
+            CHECK(stats.pixelsWritten <= display.pixelsWritten);
+            CHECK(stats.pixelsWritten + square >= display.pixelsWritten);
+        } else {
+            CHECK_EQ(stats.pixelsWritten, display.pixelsWritten);
+        }
+        reset();
+    }
+};
+
+} // namespace
+
+TEST_CASE(forcedDirtyAndStepDrawsAreCountedApart) {
+    Fixture f;
+    const UIComboBoxStats& stats = f.comboBox.getStats();
+
+    f.comboBox.draw(f.tft, true);
+    f.comboBox.setSelectedIndex(2);
+    f.comboBox.draw(f.tft, false);
+    f.comboBox.draw(f.tft, false); // Rien à dessiner : aucun dessin compté
+    CHECK_EQ(stats.forcedDraws, 1u);
+    CHECK_EQ(stats.dirtyDraws, 1u);
+    CHECK_EQ(stats.draw.count, 2u);
+
+    // Les étapes sont comptées à part ; draw() termine ensuite le travail restant.
+    f.comboBox.expand();
+    CHECK(f.comboBox.drawStep(f.tft, 0));
+    CHECK(f.comboBox.drawStep(f.tft, 0));
+    CHECK_EQ(stats.stepDraws, 2u);
+    CHECK_EQ(stats.step.count, 2u);
+    CHECK_EQ(stats.dirtyDraws, 1u);
+    f.comboBox.draw(f.tft, false);
+    CHECK_EQ(stats.dirtyDraws, 2u);
+    CHECK_EQ(stats.draw.count, 3u);
+    CHECK_EQ(stats.forcedDraws, 1u);
+
+    f.comboBox.resetStats();
+    CHECK_EQ(stats.stepDraws, 0u);
+    CHECK_EQ(stats.draw.count, 0u);
+}
+
+TEST_CASE(primitivesAndPixelsMatchTheDisplay) {
+    Fixture f;
+
+    f.comboBox.draw(f.tft, true);
+    f.checkAgainstDisplay(true);
+
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, false);
+    f.checkAgainstDisplay(true);
+
+    // Deux lignes repeintes.
+    f.comboBox.setSelectedIndex(2);
+    f.comboBox.draw(f.tft, false);
+    f.checkAgainstDisplay(false);
+
+    // Une ligne par étape.
+    f.comboBox.setSelectedIndex(3);
+    while (f.comboBox.drawStep(f.tft, 0)) {}
+    f.checkAgainstDisplay(false);
+
+    // Défilement par copie : les lignes déplacées sont relues puis recopiées.
+    f.comboBox.setBlitScrolling(true);
+    int x = RECT.x + 40;
+    int y = RECT.y + RECT.h + 3 * f.style.itemHeight;
+    f.comboBox.handleTouch(f.tft, x, y, true);
+    f.comboBox.handleTouch(f.tft, x, y - 20, true);
+    f.comboBox.updateScroll(f.nowMs += FRAME_MS);
+    f.comboBox.draw(f.tft, false);
+    f.reset();
+    f.comboBox.handleTouch(f.tft, x, y - 27, true);
+    f.comboBox.updateScroll(f.nowMs += FRAME_MS);
+    f.comboBox.draw(f.tft, false);
+    CHECK(f.comboBox.getStats().pushCalls > 0);
+    CHECK_EQ(f.tft.counters.readRect, f.comboBox.getStats().pushCalls);
+    f.checkAgainstDisplay(false);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file test_text_cache.cpp
+ * @brief Cache des libellés rastérisés : succès sans rendu U8g2, éviction LRU, invalidation sur modification.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const int ITEM_COUNT = 20;
+const size_t CACHE_BUDGET = 4096;
+const uint8_t OTHER_FONT[1] = { 0 }; /**< Une seconde police : le substitut ne compare que les pointeurs. */
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 6;
+    return style;
+}
+
+/**
+ * @brief Un composant avec cache et sa référence sans cache, chacun sur son écran.
+ */
+struct Fixture {
+    TFT_eSPI tft;
+    TFT_eSPI referenceTft;
+    U8g2_for_TFT_eSPI u8f;
+    U8g2_for_TFT_eSPI referenceU8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    UIComboBox reference;
+
+    Fixture() : comboBox(u8f, RECT, "Choix", &style), reference(referenceU8f, RECT, "Choix", &style) {
+        u8f.begin(tft);
+        referenceU8f.begin(referenceTft);
+        comboBox.setTextCacheBudget(CACHE_BUDGET);
+        each([](UIComboBox& c) {
+            uicombobox_test::addNumberedItems(c, ITEM_COUNT);
+            c.setSelectedIndex(1);
+            c.expand();
+        });
+    }
+
+    /**
+     * @brief Applique une opération aux deux composants.
+     */
+    template <typename Action>
+    void each(Action action) {
+        action(comboBox);
+        action(reference);
+    }
+
+    /**
+     * @brief Dessine entièrement le composant et retourne les textes rendus par U8g2, boîte fermée comprise.
+     */
+    std::vector<std::string> drawAndRecord() {
+        u8f.printed.clear();
+        u8f.recordPrints = true;
+        comboBox.draw(tft, true);
+        u8f.recordPrints = false;
+        return u8f.printed;
+    }
+
+    /**
+     * @brief Retourne le nombre de pixels qui diffèrent d'un dessin forcé de la référence sans cache.
+     */
+    size_t differencesFromUncachedDraw() {
+        reference.draw(referenceTft, true);
+        return TFT_eSPI::countDifferences(tft, referenceTft);
+    }
+};
+
+/**
+ * @brief Réserve une entrée de 8 x 10 pixels (10 octets) pour un élément.
+ */
+bool insertEntry(UIComboBoxTextCache& cache, int itemIndex) {
+    return cache.insert(itemIndex, nullptr, UIComboBoxTextCache::hashText("texte"), 8, 10) != nullptr;
+}
+
+bool contains(UIComboBoxTextCache& cache, int itemIndex) {
+    return cache.find(itemIndex, nullptr, UIComboBoxTextCache::hashText("texte")) != nullptr;
+}
+
+} // namespace
+
+TEST_CASE(cachedRowsAreDrawnWithoutGlyphRendering) {
+    Fixture f;
+    const uint32_t rows = (uint32_t)f.style.maxVisibleItems;
+
+    // Premier dessin : chaque ligne est rendue une fois, dans le bitmap du cache.
+    std::vector<std::string> printed = f.drawAndRecord();
+    UIComboBoxTextCache::Stats stats = f.comboBox.getTextCacheStats();
+    CHECK_EQ(stats.misses, rows);
+    CHECK_EQ(stats.hits, (uint32_t)0);
+    CHECK_EQ(stats.entries, (size_t)rows);
+    CHECK_EQ(printed.size(), (size_t)(2 + rows)); // Étiquette et texte sélectionné, puis les lignes
+
+    // Second dessin : seule la boîte fermée passe par U8g2, les lignes sont copiées depuis le cache.
+    printed = f.drawAndRecord();
+    stats = f.comboBox.getTextCacheStats();
+    CHECK_EQ(stats.hits, rows);
+    CHECK_EQ(stats.misses, rows);
+    CHECK(printed == (std::vector<std::string>{ "Choix", "Item 1" }));
+    CHECK(stats.hitRate() > 0.49f && stats.hitRate() < 0.51f);
+    CHECK_EQ(f.differencesFromUncachedDraw(), (size_t)0);
+
+    f.comboBox.resetTextCacheStats();
+    stats = f.comboBox.getTextCacheStats();
+    CHECK_EQ(stats.hits + stats.misses + stats.evictions, (uint32_t)0);
+    CHECK_EQ(stats.entries, (size_t)rows); // Les entrées survivent à la remise à zéro des compteurs
+}
+
+TEST_CASE(leastRecentlyUsedEntryIsEvicted) {
+    UIComboBoxTextCache cache(30); // Trois entrées de 10 octets
+    CHECK(insertEntry(cache, 0));
+    CHECK(insertEntry(cache, 1));
+    CHECK(insertEntry(cache, 2));
+    CHECK(contains(cache, 0)); // 1 devient la moins récemment utilisée
+
+    CHECK(insertEntry(cache, 3));
+    CHECK_EQ(cache.getStats().evictions, (uint32_t)1);
+    CHECK_EQ(cache.getStats().bytesUsed, (size_t)30);
+    CHECK(!contains(cache, 1));
+    CHECK(contains(cache, 0));
+    CHECK(contains(cache, 2));
+    CHECK(contains(cache, 3));
+
+    // Un budget réduit évince dans le même ordre ; un libellé plus grand que le budget n'est pas conservé.
+    CHECK(contains(cache, 0));
+    cache.setBudget(20);
+    CHECK(!contains(cache, 2));
+    CHECK(contains(cache, 0));
+    CHECK(contains(cache, 3));
+    CHECK(cache.getStats().bytesUsed <= 20);
+    CHECK(cache.insert(4, nullptr, 0, 64, 10) == nullptr);
+}
+
+TEST_CASE(visibleRowsStayCachedUnderATightBudget) {
+    Fixture f;
+    f.drawAndRecord();
+    size_t rowBytes = f.comboBox.getTextCacheStats().bytesUsed / f.style.maxVisibleItems;
+
+    // Le budget ne garde que quatre lignes : chaque dessin évince et rend à nouveau, sans dépasser le budget.
+    f.comboBox.setTextCacheBudget(4 * rowBytes);
+    CHECK_EQ(f.comboBox.getTextCacheStats().entries, (size_t)4);
+    f.comboBox.resetTextCacheStats();
+    f.drawAndRecord();
+    UIComboBoxTextCache::Stats stats = f.comboBox.getTextCacheStats();
+    CHECK(stats.evictions > 0);
+    CHECK(stats.bytesUsed <= 4 * rowBytes);
+    CHECK_EQ(stats.hits + stats.misses, (uint32_t)f.style.maxVisibleItems);
+}
+
+TEST_CASE(updatedItemIsRenderedAgain) {
+    Fixture f;
+    f.drawAndRecord();
+    f.comboBox.resetTextCacheStats();
+
+    f.each([](UIComboBox& c) { c.updateItem(3, "Modifié", 3); });
+    f.comboBox.draw(f.tft, false);
+    UIComboBoxTextCache::Stats stats = f.comboBox.getTextCacheStats();
+    CHECK_EQ(stats.misses, (uint32_t)1);
+    CHECK_EQ(f.differencesFromUncachedDraw(), (size_t)0);
+
+    // Les autres lignes restent en cache, la ligne modifiée aussi désormais.
+    f.comboBox.resetTextCacheStats();
+    std::vector<std::string> printed = f.drawAndRecord();
+    CHECK_EQ(f.comboBox.getTextCacheStats().misses, (uint32_t)0);
+    CHECK_EQ(printed.size(), (size_t)2);
+}
+
+TEST_CASE(styleChangeEmptiesTheCache) {
+    Fixture f;
+    f.drawAndRecord();
+    CHECK(f.comboBox.getTextCacheStats().entries > 0);
+
+    UIComboBoxStyle other = makeStyle();
+    other.itemTextStyle.font = OTHER_FONT;
+    f.each([&](UIComboBox& c) { c.setStyle(&other); });
+    CHECK_EQ(f.comboBox.getTextCacheStats().entries, (size_t)0);
+    CHECK_EQ(f.comboBox.getTextCacheStats().bytesUsed, (size_t)0);
+
+    // Tout est rendu à nouveau avec la nouvelle police.
+    f.comboBox.resetTextCacheStats();
+    f.drawAndRecord();
+    CHECK_EQ(f.comboBox.getTextCacheStats().misses, (uint32_t)f.style.maxVisibleItems);
+    CHECK_EQ(f.differencesFromUncachedDraw(), (size_t)0);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_underlay.cpp
+ * @brief Sauvegarde du fond sous la liste : capture, restauration et abandon au-delà du budget.
+ */
+
+#include "UIComboBoxTest.h"
+
+namespace {
+
+const UIRect RECT = { 20, 40, 200, 30 };
+const uint16_t BACKGROUND = 0x1234;
+
+/**
+ * @brief Remplit l'écran d'un motif dont presque chaque pixel diffère de son voisin.
+ */
+void paintNoise(TFT_eSPI& tft) {
+    for (int y = 0; y < tft.height(); y++) {
+        for (int x = 0; x < tft.width(); x++) {
+            tft.drawPixel(x, y, (uint16_t)(x * 7 + y * 13));
+        }
+    }
+}
+
+UIComboBoxStyle makeStyle() {
+    UIComboBoxStyle style;
+    style.maxVisibleItems = 4;
+    return style;
+}
+
+struct Fixture {
+    TFT_eSPI tft;
+    U8g2_for_TFT_eSPI u8f;
+    UIComboBoxStyle style = makeStyle();
+    UIComboBox comboBox;
+    int collapses = 0;
+
+    explicit Fixture(size_t budgetBytes) : comboBox(u8f, RECT, "", &style) {
+        u8f.begin(tft);
+        uicombobox_test::addNumberedItems(comboBox, 10);
+        comboBox.setBackgroundRestore(true, budgetBytes);
+        comboBox.setOnCollapse([this](const UIRect&) { collapses++; });
+    }
+};
+
+} // namespace
+
+TEST_CASE(uniformAreaIsCapturedCompactlyAndRestored) {
+    TFT_eSPI tft;
+    tft.clearMemory(BACKGROUND);
+    // Plus de 65535 pixels : la zone tient en deux plages.
+    const UIRect area = { 0, 0, 320, 240 };
+    UIComboBoxUnderlay underlay;
+    CHECK(underlay.capture(tft, area, 1024));
+    CHECK(underlay.covers(UIRect{ 10, 10, 50, 50 }));
+    CHECK_EQ(underlay.memoryUsage(), 4 * sizeof(uint16_t));
+
+    tft.fillRect(5, 5, 200, 200, 0xFFFF);
+    CHECK(underlay.restore(tft));
+    CHECK(!underlay.isCaptured());
+    CHECK_EQ(underlay.memoryUsage(), (size_t)0);
+    TFT_eSPI reference;
+    reference.clearMemory(BACKGROUND);
+    CHECK_EQ(TFT_eSPI::countDifferences(tft, reference), (size_t)0);
+}
+
+TEST_CASE(captureKeepsOnlyTheUsedPartOfTheBudget) {
+    TFT_eSPI tft;
+    paintNoise(tft);
+    // 800 pixels tous différents de leur voisin : 800 plages de 4 octets.
+    const UIRect area = { 30, 30, 40, 20 };
+    UIComboBoxUnderlay underlay;
+    CHECK(underlay.capture(tft, area, 8192));
+    CHECK_EQ(underlay.memoryUsage(), (size_t)3200);
+
+    TFT_eSPI reference;
+    paintNoise(reference);
+    tft.fillRect(area.x, area.y, area.w, area.h, 0);
+    CHECK(underlay.restore(tft));
+    CHECK_EQ(TFT_eSPI::countDifferences(tft, reference), (size_t)0);
+}
+
+TEST_CASE(areaOverBudgetIsDropped) {
+    TFT_eSPI tft;
+    paintNoise(tft);
+    UIComboBoxUnderlay underlay;
+    CHECK(underlay.capture(tft, UIRect{ 0, 0, 10, 10 }, 1024));
+
+    // Un échec remplace la capture précédente et ne garde aucune mémoire.
+    CHECK(!underlay.capture(tft, UIRect{ 30, 30, 40, 20 }, 3196));
+    CHECK(!underlay.isCaptured());
+    CHECK_EQ(underlay.memoryUsage(), (size_t)0);
+    tft.resetCounters();
+    CHECK(!underlay.restore(tft));
+    CHECK_EQ(tft.touchedCount(), (size_t)0);
+
+    // Budget trop petit pour une seule plage.
+    CHECK(!underlay.capture(tft, UIRect{ 0, 0, 10, 10 }, 3));
+
+    // Un budget juste suffisant est entièrement utilisé.
+    CHECK(underlay.capture(tft, UIRect{ 30, 30, 40, 20 }, 3200));
+    CHECK_EQ(underlay.memoryUsage(), (size_t)3200);
+}
+
+TEST_CASE(collapsedListIsRestoredWithoutCallback) {
+    Fixture f(8192);
+    f.tft.clearMemory(BACKGROUND);
+    f.comboBox.draw(f.tft, true);
+    TFT_eSPI reference = f.tft;
+
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, false);
+    CHECK(TFT_eSPI::countDifferences(f.tft, reference) > 0);
+    f.comboBox.collapse();
+    f.comboBox.draw(f.tft, false);
+
+    CHECK_EQ(f.collapses, 0);
+    CHECK_EQ(TFT_eSPI::countDifferences(f.tft, reference), (size_t)0);
+}
+
+TEST_CASE(listOverBudgetFallsBackToTheCallback) {
+    Fixture f(256);
+    paintNoise(f.tft);
+    f.comboBox.draw(f.tft, true);
+    TFT_eSPI reference = f.tft;
+
+    f.comboBox.expand();
+    f.comboBox.draw(f.tft, false);
+    f.comboBox.collapse();
+
+    // Rien n'est recopié : l'application est prévenue et repeint la zone elle-même.
+    CHECK_EQ(f.collapses, 1);
+    f.tft.resetCounters();
+    f.comboBox.draw(f.tft, false);
+    CHECK(uicombobox_test::touchedOnlyWithin(f.tft, { RECT }));
+    CHECK(TFT_eSPI::countDifferences(f.tft, reference) > 0);
+}
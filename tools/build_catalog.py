@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Construit un catalogue binaire lisible par UIComboBoxCatalogProvider.
+
+Entrée : un fichier CSV (UTF-8) de deux colonnes, texte puis valeur entière.
+Si la colonne des valeurs est absente, la valeur d'un élément est son rang.
+
+Exemple :
+    python3 tools/build_catalog.py unites.csv data/unites.uicb --items-per-block 32
+
+Le fichier produit est à placer dans le système de fichiers de la carte
+(dossier data/ de PlatformIO pour LittleFS ou SPIFFS).
+
+Format (petit-boutiste) :
+    en-tête    "UICB", version u16, éléments par bloc u16, nombre d'éléments u32,
+               nombre de blocs u32, position de l'index u32
+    index      nombre de blocs + 1 positions u32 (la dernière marque la fin du dernier bloc)
+    blocs      pour chaque élément : valeur i32, longueur du texte u8, texte UTF-8
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b"UICB"
+FORMAT_VERSION = 1
+HEADER_FORMAT = "<4sHHIII"
+MAX_TEXT_BYTES = 255      # Longueur du texte codée sur un octet
+MAX_BLOCK_BYTES = 0xFFFF  # Positions des éléments d'un bloc codées sur 16 bits
+
+
+def read_items(path, delimiter):
+    """Lit les couples (texte, valeur) du fichier CSV."""
+    items = []
+    with open(path, newline="", encoding="utf-8") as source:
+        for line, row in enumerate(csv.reader(source, delimiter=delimiter), start=1):
+            if not row or (len(row) == 1 and not row[0].strip()):
+                continue
+            text = row[0]
+            value = int(row[1]) if len(row) > 1 and row[1].strip() else len(items)
+            if not -2**31 <= value < 2**31:
+                raise ValueError(f"ligne {line} : valeur hors de l'intervalle d'un entier 32 bits")
+            encoded = text.encode("utf-8")
+            if len(encoded) > MAX_TEXT_BYTES:
+                raise ValueError(f"ligne {line} : texte de {len(encoded)} octets (maximum {MAX_TEXT_BYTES})")
+            items.append((encoded, value))
+    return items
+
+
+def build_catalog(items, items_per_block):
+    """Retourne le contenu binaire du catalogue."""
+    blocks = []
+    for start in range(0, len(items), items_per_block):
+        block = bytearray()
+        for encoded, value in items[start:start + items_per_block]:
+            block += struct.pack("<iB", value, len(encoded)) + encoded
+        if len(block) > MAX_BLOCK_BYTES:
+            raise ValueError(f"bloc de {len(block)} octets (maximum {MAX_BLOCK_BYTES}) : réduisez --items-per-block")
+        blocks.append(bytes(block))
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    index_size = 4 * (len(blocks) + 1)
+    offsets = [header_size + index_size]
+    for block in blocks:
+        offsets.append(offsets[-1] + len(block))
+
+    header = struct.pack(HEADER_FORMAT, MAGIC, FORMAT_VERSION, items_per_block,
+                         len(items), len(blocks), header_size)
+    index = struct.pack(f"<{len(offsets)}I", *offsets)
+    return header + index + b"".join(blocks)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="fichier CSV : texte, valeur")
+    parser.add_argument("output", help="catalogue binaire à produire")
+    parser.add_argument("--items-per-block", type=int, default=32,
+                        help="éléments par bloc, lus ensemble sur la carte (défaut : 32)")
+    parser.add_argument("--delimiter", default=",", help="séparateur de colonnes (défaut : ,)")
+    args = parser.parse_args()
+
+    if not 1 <= args.items_per_block <= 0xFFFF:
+        parser.error("--items-per-block doit être compris entre 1 et 65535")
+    try:
+        items = read_items(args.input, args.delimiter)
+        data = build_catalog(items, args.items_per_block)
+    except ValueError as error:
+        sys.exit(f"{args.input} : {error}")
+    with open(args.output, "wb") as output:
+        output.write(data)
+    print(f"{args.output} : {len(items)} éléments, {len(data)} octets")
+
+
+if __name__ == "__main__":
+    main()